@@ -0,0 +1,255 @@
+/*
+ * ABL regression check for the host-native build ([env:native_abl], see tools/bench/README.md)
+ * Runs random frames through the real BusDigital/BusManager current estimate and brightness limiter
+ * (sumColors(), applyABL(), setPixels()/setPixelColor()) and compares them with a frozen copy of the
+ * previous implementation that summed the encoded colors in setPixelColor() and repainted the bus
+ * with the limited brightness in show().
+ * Compared per frame: total used current, brightness limit of each bus and every encoded pixel.
+ */
+#include "wled.h"
+#include "host_polybus.h"
+
+#include <vector>
+
+// pin_manager.cpp and udp.cpp are not part of the host build: every pin is free, nothing is sent
+bool PinManager::allocatePin(byte gpio, bool output, PinOwner tag)                                      { return true; }
+bool PinManager::allocateMultiplePins(const managed_pin_type *mptArray, byte arrayElementCount, PinOwner tag) { return true; }
+bool PinManager::deallocatePin(byte gpio, PinOwner tag)                                                 { return true; }
+bool PinManager::isPinOk(byte gpio, bool output)                                                        { return true; }
+bool realtimeSendPacket(IPAddress client, uint16_t port, const uint8_t *packet, size_t len)              { return true; }
+
+// previous implementation (encode-time sum, limit applied by repainting the bus), kept as reference
+struct RefBus {
+  uint8_t  type;
+  uint16_t len;
+  uint8_t  autoWhite;
+  uint8_t  milliAmpsPerLed;
+  uint16_t milliAmpsMax;
+  uint16_t milliAmpsLimit = 0;
+  uint32_t colorSum       = 0;
+  uint32_t milliAmpsTotal = 0;
+  uint8_t  briLimit       = 255;
+  std::vector<uint32_t> encoded;
+
+  inline bool hasWhite() const { return Bus::hasWhite(type); }
+
+  uint32_t autoWhiteCalc(uint32_t c) const {
+    if (autoWhite == RGBW_MODE_MANUAL_ONLY) return c;
+    unsigned w = W(c);
+    if (w > 0 && autoWhite == RGBW_MODE_DUAL) return c;
+    unsigned r = R(c), g = G(c), b = B(c);
+    if (autoWhite == RGBW_MODE_MAX) return RGBW32(r, g, b, r > g ? (r > b ? r : b) : (g > b ? g : b));
+    w = r < g ? (r < b ? r : b) : (g < b ? g : b);
+    if (autoWhite == RGBW_MODE_AUTO_ACCURATE) { r -= w; g -= w; b -= w; }
+    return RGBW32(r, g, b, w);
+  }
+
+  // BusDigital::setPixelColor(): encode and sum the encoded channels
+  void setPixelColor(unsigned pix, uint32_t c, uint8_t bri) {
+    if (hasWhite()) c = autoWhiteCalc(c);
+    c = color_fade(c, bri, true);
+    uint8_t r = R(c), g = G(c), b = B(c);
+    if (milliAmpsPerLed < 255) colorSum += r + g + b + W(c);
+    else colorSum += ((r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b));
+    encoded[pix] = c;
+  }
+
+  void estimateCurrent() {
+    uint32_t actualMilliampsPerLed = milliAmpsPerLed;
+    if (milliAmpsPerLed == 255) {
+      colorSum *= 3;
+      actualMilliampsPerLed = 12;
+    }
+    uint32_t clrUnitsPerChannel = hasWhite() ? 4*255 : 3*255;
+    milliAmpsTotal = ((uint64_t)colorSum * actualMilliampsPerLed) / clrUnitsPerChannel + len;
+  }
+
+  // BusDigital::applyBriLimit(): repaint all pixels with the limited brightness
+  void applyBriLimit(uint8_t newBri) {
+    if (newBri == 0) {
+      if (milliAmpsLimit == 0 || milliAmpsTotal == 0) { colorSum = 0; return; }
+      newBri = 255;
+      if (milliAmpsLimit > len) {
+        if (milliAmpsTotal > milliAmpsLimit) {
+          newBri = ((uint32_t)milliAmpsLimit * 255) / milliAmpsTotal + 1;
+          milliAmpsTotal = milliAmpsLimit;
+        }
+      } else {
+        newBri = 1;
+        milliAmpsTotal = len;
+      }
+    }
+    if (newBri < 255) for (auto &c : encoded) c = color_fade(c, newBri, true);
+    briLimit = newBri;
+    colorSum = 0;
+  }
+};
+
+// BusManager::initializeABL(), returns true if ABL is used
+static bool refInitializeABL(std::vector<RefBus> &buses, uint16_t globalMax) {
+  if (globalMax > 0) {
+    for (const auto &b : buses) if (b.milliAmpsPerLed > 0) return true;
+    return false;
+  }
+  unsigned numABLbuses = 0;
+  for (const auto &b : buses) if (b.milliAmpsPerLed > 0 && b.milliAmpsMax > 0) numABLbuses++;
+  if (numABLbuses == 0) return false;
+  uint32_t ESPshare = MA_FOR_ESP / numABLbuses;
+  for (auto &b : buses) {
+    uint32_t busDemand = b.len * b.milliAmpsPerLed;
+    uint32_t busMax    = b.milliAmpsMax;
+    if (busMax > ESPshare) busMax -= ESPshare;
+    if (busMax < b.len)    busMax  = b.len;
+    if (busDemand == 0)    busMax  = 0;
+    b.milliAmpsLimit = busMax;
+  }
+  return true;
+}
+
+// BusManager::show() (applyABL() part), returns used current
+static unsigned refApplyABL(std::vector<RefBus> &buses, uint16_t globalMax) {
+  unsigned milliAmpsSum = 0, totalLEDs = 0;
+  for (auto &b : buses) {
+    b.estimateCurrent();
+    if (globalMax == 0) b.applyBriLimit(0);
+    milliAmpsSum += b.milliAmpsTotal;
+    totalLEDs += b.len;
+  }
+  if (globalMax > 0) {
+    uint8_t  newBri = 255;
+    uint32_t limit = globalMax > MA_FOR_ESP ? globalMax - MA_FOR_ESP : 1;
+    if (limit > totalLEDs) {
+      if (milliAmpsSum > limit) {
+        newBri = limit * 255 / milliAmpsSum + 1;
+        milliAmpsSum = limit;
+      }
+    } else {
+      newBri = 1;
+      milliAmpsSum = totalLEDs;
+    }
+    for (auto &b : buses) {
+      if (b.milliAmpsPerLed > 0) b.applyBriLimit(newBri);
+      else { b.briLimit = 255; b.colorSum = 0; }
+    }
+  }
+  return milliAmpsSum;
+}
+
+// random frame with black, grey, saturated, RGB and RGBW pixels
+static void randomFrame(std::vector<uint32_t> &frame) {
+  for (auto &c : frame) {
+    uint32_t rnd = hostRandom32();
+    switch (rnd & 7) {
+      case 0: case 1: c = 0; break;
+      case 2: { uint8_t v = rnd >> 8; c = RGBW32(v, v, v, 0); } break;
+      case 3: c = RGBW32(rnd >> 8, 0, 0, 0) | (0xFF << (8 * ((rnd >> 16) % 3))); break;
+      case 4: c = hostRandom32(); break;
+      default: c = hostRandom32() & 0x00FFFFFF; break;
+    }
+  }
+}
+
+struct Scenario {
+  const char *name;
+  uint16_t    globalMax;  // 0 = per bus limit
+  uint16_t    busMax[3];  // milliAmpsMax of each bus
+  uint8_t     busMApL[3]; // milliAmpsPerLed of each bus (255 = WS2815 power model)
+};
+
+static const Scenario scenarios[] = {
+  { "per bus, no limit reached",  0,     { 20000, 20000, 20000 }, { 55, 55, 255 } },
+  { "per bus",                    0,     { 1200, 900, 700 },      { 55, 35, 255 } },
+  { "per bus, standby only",      0,     { 250, 250, 250 },       { 55, 55, 255 } },
+  { "per bus, ABL off on bus 1",  0,     { 1500, 0, 800 },        { 55, 55, 0 } },
+  { "global",                     2500,  { 0, 0, 0 },             { 55, 35, 255 } },
+  { "global, bus 2 not limited",  1500,  { 0, 0, 0 },             { 55, 55, 0 } },
+  { "global, standby only",       400,   { 0, 0, 0 },             { 55, 55, 55 } },
+  { "global, WS2815 only",        3000,  { 0, 0, 0 },             { 255, 255, 255 } },
+};
+
+static const uint8_t  busTypes[3] = { TYPE_WS2812_RGB, TYPE_SK6812_RGBW, TYPE_WS2812_RGB };
+static const uint16_t busLens[3]  = { 300, 200, 150 };
+
+// runs frames of one scenario, returns number of mismatches
+static unsigned runScenario(const Scenario &s, uint8_t autoWhite, bool gamma, unsigned frames) {
+  BusManager::removeAll();
+  std::vector<RefBus> ref;
+  unsigned start = 0;
+  for (unsigned n = 0; n < 3; n++) {
+    uint8_t pins[OUTPUT_MAX_PINS] = { uint8_t(n + 2) };
+    const uint8_t aw = Bus::hasWhite(busTypes[n]) ? autoWhite : RGBW_MODE_MANUAL_ONLY;
+    BusManager::add(BusConfig(busTypes[n], pins, start, busLens[n], COL_ORDER_RGB, false, 0, aw, 0, s.busMApL[n], s.busMax[n]));
+    ref.push_back({ busTypes[n], busLens[n], aw, s.busMApL[n], s.busMax[n] });
+    ref.back().encoded.resize(busLens[n]);
+    start += busLens[n];
+  }
+  BusManager::setMilliampsMax(s.globalMax);
+  BusManager::initializeABL();
+  const bool useABL = refInitializeABL(ref, s.globalMax);
+
+  std::vector<uint32_t> frame(start);
+  unsigned mismatches = 0;
+  for (unsigned f = 0; f < frames; f++) {
+    const uint8_t bri = 1 + hostRandom32() % 255;
+    randomFrame(frame);
+    BusManager::setBrightness(bri);
+
+    // current code: sum the frame, limit, then paint (fused span on even frames, per pixel on odd frames)
+    BusManager::sumColors(0, frame.data(), frame.size(), gamma);
+    BusManager::applyABL();
+    if (f & 1) for (size_t i = 0; i < frame.size(); i++) BusManager::setPixelColor(i, gamma ? gamma32(frame[i]) : frame[i]);
+    else BusManager::setPixels(0, frame.data(), frame.size(), gamma);
+
+    // previous code: paint and sum, then limit by repainting
+    unsigned pix = 0;
+    for (auto &b : ref) for (unsigned i = 0; i < b.len; i++, pix++) b.setPixelColor(i, gamma ? gamma32(frame[pix]) : frame[pix], bri);
+    const unsigned refUsed = useABL ? refApplyABL(ref, s.globalMax) : 0;
+
+    bool ok = BusManager::_gMilliAmpsUsed == refUsed;
+    for (unsigned n = 0; n < ref.size(); n++) {
+      const BusDigital &bus = static_cast<BusDigital&>(*BusManager::getBus(n));
+      const HostPixelBus &out = *hostPixelBuses[n];
+      const uint32_t mask = ref[n].hasWhite() ? 0xFFFFFFFF : 0x00FFFFFF;
+      if (bus.getBriLimit() != ref[n].briLimit) ok = false;
+      for (unsigned i = 0; i < ref[n].len; i++) if ((out.pixels[i] & mask) != (ref[n].encoded[i] & mask)) { ok = false; break; }
+    }
+    if (!ok) {
+      if (mismatches++ < 5) {
+        printf("  frame %u (bri %u): used %u mA, expected %u mA\n", f, bri, BusManager::_gMilliAmpsUsed, refUsed);
+        for (unsigned n = 0; n < ref.size(); n++) {
+          const BusDigital &bus = static_cast<BusDigital&>(*BusManager::getBus(n));
+          printf("    bus %u: limit %u, expected %u\n", n, bus.getBriLimit(), ref[n].briLimit);
+        }
+      }
+    }
+  }
+  return mismatches;
+}
+
+int main(int argc, char **argv) {
+  unsigned frames = argc > 1 ? strtoul(argv[1], nullptr, 10) : 200;
+  if (frames == 0) {
+    fprintf(stderr, "usage: %s [frames per case]\n", argv[0]);
+    return 2;
+  }
+  gammaCorrectCol = true;
+  NeoGammaWLEDMethod::calcGammaTable(2.8f);
+  hostRandomSeed(1);
+
+  unsigned failed = 0, cases = 0;
+  for (const auto &s : scenarios) {
+    for (uint8_t aw = RGBW_MODE_MANUAL_ONLY; aw <= RGBW_MODE_MAX; aw++) {
+      for (int gamma = 0; gamma < 2; gamma++) {
+        const unsigned mismatches = runScenario(s, aw, gamma, frames);
+        cases++;
+        if (mismatches) {
+          failed++;
+          printf("FAIL %s, auto white %u, gamma %s: %u of %u frames differ\n", s.name, aw, gamma ? "on" : "off", mismatches, frames);
+        }
+      }
+    }
+  }
+  BusManager::removeAll();
+  printf("%u of %u cases match the previous ABL estimate (%u frames each)\n", cases - failed, cases, frames);
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,193 @@
+/*
+ * Frame-render benchmark for the host-native build ([env:native], see README.md)
+ * Runs every registered effect on a set of strip/matrix sizes through the real WS2812FX::service()/show()
+ * path and reports time per frame, pixel throughput, heap high-water mark and a hash of the output frame.
+ */
+#include "wled.h"
+#include "host_bus.h"
+
+#include <chrono>
+#include <vector>
+
+struct BenchSize {
+  unsigned width;
+  unsigned height; // 1 for a plain strip
+  inline unsigned length() const { return width * height; }
+  inline bool     is2D()   const { return height > 1; }
+};
+
+struct BenchOptions {
+  unsigned               frames = 200;
+  unsigned               warmup = 10;
+  int                    effect = -1;  // -1 = all effects
+  bool                   csv    = false;
+  std::vector<BenchSize> sizes;
+};
+
+static void usage(const char *name) {
+  fprintf(stderr,
+    "usage: %s [--frames N] [--warmup N] [--sizes 300,1500,64x64,128x128] [--effect ID] [--csv]\n", name);
+}
+
+// parses "300,1500,64x64" into sizes, returns false on malformed input
+static bool parseSizes(const char *arg, std::vector<BenchSize> &sizes) {
+  sizes.clear();
+  while (*arg) {
+    char *end;
+    unsigned w = strtoul(arg, &end, 10), h = 1;
+    if (*end == 'x' || *end == 'X') h = strtoul(end + 1, &end, 10);
+    if (w == 0 || h == 0 || (*end && *end != ',')) return false;
+    if (h > 1 && (w > 255 || h > 255)) return false; // Panel dimensions are 8 bit
+    if (w * h > MAX_LEDS) return false;
+    sizes.push_back({w, h});
+    arg = *end ? end + 1 : end;
+  }
+  return !sizes.empty();
+}
+
+static bool parseOptions(int argc, char **argv, BenchOptions &opt) {
+  for (int i = 1; i < argc; i++) {
+    const char *a = argv[i];
+    bool hasValue = i + 1 < argc;
+    if      (!strcmp(a, "--frames") && hasValue) opt.frames = std::max(1UL, strtoul(argv[++i], nullptr, 10));
+    else if (!strcmp(a, "--warmup") && hasValue) opt.warmup = strtoul(argv[++i], nullptr, 10);
+    else if (!strcmp(a, "--effect") && hasValue) opt.effect = atoi(argv[++i]);
+    else if (!strcmp(a, "--sizes")  && hasValue) { if (!parseSizes(argv[++i], opt.sizes)) return false; }
+    else if (!strcmp(a, "--csv"))                opt.csv = true;
+    else return false;
+  }
+  if (opt.sizes.empty()) parseSizes("300,1500,64x64,128x128", opt.sizes);
+  return true;
+}
+
+// effect metadata: "name@sliders;colors;palette;flags;defaults", flags contain '1' (1D) and/or '2' (2D)
+static bool isEffect2DOnly(const char *data) {
+  const char *p = strchr(data, '@');
+  if (!p) return false;
+  for (int field = 0; field < 3 && p; field++) p = strchr(p + 1, ';');
+  if (!p) return false;
+  bool has1D = false, has2D = false;
+  for (p++; *p && *p != ';'; p++) {
+    if (*p == '1') has1D = true;
+    if (*p == '2') has2D = true;
+  }
+  return has2D && !has1D;
+}
+
+static void effectName(const char *data, char *dest, size_t maxLen) {
+  size_t len = 0;
+  while (data[len] && data[len] != '@' && len < maxLen - 1) len++;
+  memcpy(dest, data, len);
+  dest[len] = '\0';
+}
+
+// (re)creates outputs and segments for the given size, buses are split at MAX_LEDS_PER_BUS
+static void setupStrip(const BenchSize &size) {
+  uint8_t pins[OUTPUT_MAX_PINS] = {2, 255, 255, 255, 255};
+  busConfigs.clear();
+  for (unsigned start = 0; start < size.length(); start += MAX_LEDS_PER_BUS) {
+    unsigned len = std::min(size.length() - start, (unsigned)MAX_LEDS_PER_BUS);
+    busConfigs.emplace_back(TYPE_WS2812_RGB, pins, start, len, COL_ORDER_GRB);
+  }
+
+  strip.panel.clear();
+  strip.isMatrix = size.is2D();
+  if (strip.isMatrix) {
+    WS2812FX::Panel p;
+    p.width  = size.width;
+    p.height = size.height;
+    strip.panel.push_back(p);
+  }
+
+  bri = 255;
+  strip.setTransition(0);
+  strip.finalizeInit();
+  strip.makeAutoSegments(true);
+  strip.setBrightness(255, true);
+}
+
+// FNV-1a over everything the buses were sent
+static uint32_t frameHash() {
+  uint32_t hash = 2166136261UL;
+  for (size_t b = 0; b < BusManager::getNumBusses(); b++) {
+    const BusRecording *bus = static_cast<const BusRecording *>(BusManager::getBus(b));
+    const uint32_t *data = bus->getData();
+    for (unsigned i = 0; i < bus->getLength(); i++) {
+      uint32_t c = data[i];
+      for (int k = 0; k < 4; k++, c >>= 8) hash = (hash ^ (c & 0xFF)) * 16777619UL;
+    }
+  }
+  return hash;
+}
+
+int main(int argc, char **argv) {
+  BenchOptions opt;
+  if (!parseOptions(argc, argv, opt)) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  NeoGammaWLEDMethod::calcGammaTable(gammaCorrectVal); // done by deserializeConfig() on device
+
+  if (opt.csv) printf("size,leds,effect,name,ns_per_frame,mpix_per_s,heap_hw,allocs_per_frame,hash\n");
+
+  for (const auto &size : opt.sizes) {
+    char sizeStr[16];
+    if (size.is2D()) snprintf(sizeStr, sizeof(sizeStr), "%ux%u", size.width, size.height);
+    else             snprintf(sizeStr, sizeof(sizeStr), "%u", size.width);
+
+    hostSetMillis(0);
+    setupStrip(size);
+    if (strip.getLengthTotal() != size.length()) {
+      fprintf(stderr, "size %s: could not set up %u LEDs (got %u)\n", sizeStr, size.length(), (unsigned)strip.getLengthTotal());
+      continue;
+    }
+    if (!opt.csv) printf("\n== %s (%u LEDs, %u buses) ==\n%4s %-24s %12s %10s %10s %8s %10s\n", sizeStr, size.length(), (unsigned)BusManager::getNumBusses(),
+                         "id", "effect", "ns/frame", "Mpix/s", "heap hw", "allocs", "hash");
+
+    double totalNs = 0;
+    unsigned runs = 0;
+    for (unsigned id = 0; id < strip.getModeCount(); id++) {
+      if (opt.effect >= 0 && (unsigned)opt.effect != id) continue;
+      const char *data = strip.getModeData(id);
+      if (!strncmp_P(data, PSTR("RSVD"), 4)) continue;
+      if (!size.is2D() && isEffect2DOnly(data)) continue;
+      char name[25];
+      effectName(data, name, sizeof(name));
+
+      // identical starting conditions for every effect so hashes are comparable between runs
+      hostSetMillis(0);
+      hostRandomSeed(0);
+      random16_set_seed(1337);
+      strip.getMainSegment().setMode(id, true);
+      for (unsigned f = 0; f < opt.warmup; f++) {
+        hostAdvanceMillis(std::max((unsigned)strip.getFrameTime(), (unsigned)MIN_FRAME_DELAY + 1));
+        strip.trigger();
+        strip.service();
+      }
+
+      hostHeapResetHighWater();
+      auto start = std::chrono::steady_clock::now();
+      for (unsigned f = 0; f < opt.frames; f++) {
+        hostAdvanceMillis(std::max((unsigned)strip.getFrameTime(), (unsigned)MIN_FRAME_DELAY + 1));
+        strip.trigger();
+        strip.service();
+      }
+      strip.waitForOutput(); // last frame may still be in output pipeline
+      auto stop = std::chrono::steady_clock::now();
+
+      double ns     = std::chrono::duration<double, std::nano>(stop - start).count() / opt.frames;
+      double mpix   = ns > 0 ? size.length() * 1e3 / ns : 0;
+      double allocs = double(hostHeapStats().allocations) / opt.frames;
+      size_t hw     = hostHeapStats().highWater;
+      uint32_t hash = frameHash();
+      totalNs += ns;
+      runs++;
+
+      if (opt.csv) printf("%s,%u,%u,\"%s\",%.0f,%.2f,%u,%.2f,%08x\n", sizeStr, size.length(), id, name, ns, mpix, (unsigned)hw, allocs, (unsigned)hash);
+      else         printf("%4u %-24s %12.0f %10.2f %10u %8.2f   %08x\n", id, name, ns, mpix, (unsigned)hw, allocs, (unsigned)hash);
+    }
+    if (!opt.csv && runs) printf("-- %u effects, mean %.0f ns/frame\n", runs, totalNs / runs);
+  }
+  return 0;
+}
@@ -0,0 +1,224 @@
+#pragma once
+#ifndef WLED_HOST_ARDUINO_H
+#define WLED_HOST_ARDUINO_H
+/*
+ * Minimal Arduino core replacement for the host-native benchmark build ([env:native]).
+ * Only what the render core (FX*.cpp, colors.cpp, util.cpp, wled_math.cpp) needs is provided.
+ * Time is virtual and only advances when the benchmark runner calls hostAdvanceMillis().
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdarg>
+#include <cctype>
+#include <cmath>
+#include <climits>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+using std::min;
+using std::max;
+using std::abs;
+using std::isinf;
+using std::isnan;
+using ::round;
+
+typedef uint8_t  byte;
+typedef bool     boolean;
+typedef uint16_t word;
+
+#undef unix // predefined by GNU C++ on Linux, used as identifier in Toki.h
+
+inline uint16_t makeWord(uint16_t w)            { return w; }
+inline uint16_t makeWord(uint8_t h, uint8_t l)  { return (h << 8) | l; }
+#define word(...) makeWord(__VA_ARGS__)
+
+#define PROGMEM
+#define PGM_P                const char *
+#define PSTR(s)              (s)
+#define IRAM_ATTR
+#define ICACHE_RAM_ATTR
+#define RTC_NOINIT_ATTR
+
+class __FlashStringHelper;
+#define FPSTR(p)             (reinterpret_cast<const __FlashStringHelper *>(p))
+#define F(s)                 FPSTR(PSTR(s))
+
+// pgm_read_dword() is used on ESP to read 32 bit pointer tables, keep the pointee type so 64 bit pointers survive
+template<typename T> inline T hostReadDword(const T *addr)    { return *addr; }
+inline uint32_t hostReadDword(const void *addr)                 { return *reinterpret_cast<const uint32_t *>(addr); }
+#define pgm_read_byte(addr)       (*reinterpret_cast<const uint8_t *>(addr))
+#define pgm_read_byte_near(addr)  pgm_read_byte(addr)
+#define pgm_read_word(addr)       (*reinterpret_cast<const uint16_t *>(addr))
+#define pgm_read_dword(addr)      hostReadDword(addr)
+#define pgm_read_float(addr)      (*reinterpret_cast<const float *>(addr))
+#define pgm_read_ptr(addr)        (*reinterpret_cast<const void * const *>(addr))
+
+#define memcpy_P    memcpy
+#define strcpy_P    strcpy
+#define strncpy_P   strncpy
+#define strcat_P    strcat
+#define strncat_P   strncat
+#define strcmp_P    strcmp
+#define strncmp_P   strncmp
+#define strcasecmp_P strcasecmp
+#define strchr_P    strchr
+#define strstr_P    strstr
+#define strlen_P    strlen
+#define sprintf_P   sprintf
+#define snprintf_P  snprintf
+#define vsnprintf_P vsnprintf
+
+#if !defined(__APPLE__) && !(defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 38)))
+inline size_t strlcpy(char *dst, const char *src, size_t size) {
+  size_t len = strlen(src);
+  if (size) {
+    size_t n = len < size - 1 ? len : size - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return len;
+}
+#endif
+
+#ifndef PI
+#define PI          3.1415926535897932384626433832795
+#endif
+#define HALF_PI     1.5707963267948966192313216916398
+#define TWO_PI      6.283185307179586476925286766559
+#define DEG_TO_RAD  0.017453292519943295769236907684886
+#define RAD_TO_DEG  57.295779513082320876798154814105
+#ifndef M_TWOPI
+#define M_TWOPI     6.283185307179586476925286766559 // newlib extension
+#endif
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define radians(deg)            ((deg)*DEG_TO_RAD)
+#define degrees(rad)            ((rad)*RAD_TO_DEG)
+#define sq(x)                   ((x)*(x))
+#define lowByte(w)              ((uint8_t) ((w) & 0xff))
+#define highByte(w)             ((uint8_t) ((w) >> 8))
+#define bitRead(value, bit)     (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit)      ((value) |= (1UL << (bit)))
+#define bitClear(value, bit)    ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// GPIO: there are no pins on host
+#define LOW    0
+#define HIGH   1
+#define INPUT  0x01
+#define OUTPUT 0x03
+inline void pinMode(uint8_t pin, uint8_t mode)      {}
+inline void digitalWrite(uint8_t pin, uint8_t val)  {}
+inline int  digitalRead(uint8_t pin)                { return LOW; }
+
+// virtual clock (tools/bench/host_platform.cpp)
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+void hostAdvanceMillis(unsigned long ms);
+void hostSetMillis(unsigned long ms);
+
+// deterministic replacement for the hardware RNG register (see soc/wdev_reg.h)
+uint32_t hostRandom32();
+void     hostRandomSeed(uint32_t seed);
+
+class String : public std::string {
+  public:
+    String() {}
+    String(const char *s) : std::string(s ? s : "") {}
+    String(const std::string &s) : std::string(s) {}
+    String(const __FlashStringHelper *s) : std::string(s ? reinterpret_cast<const char *>(s) : "") {}
+    explicit String(char c) : std::string(1, c) {}
+    explicit String(int v, unsigned char base = 10)           { fromInt(v, base); }
+    explicit String(unsigned v, unsigned char base = 10)      { fromInt(v, base); }
+    explicit String(long v, unsigned char base = 10)          { fromInt(v, base); }
+    explicit String(unsigned long v, unsigned char base = 10) { fromInt(v, base); }
+    explicit String(float v, unsigned char decimals = 2)      { fromFloat(v, decimals); }
+    explicit String(double v, unsigned char decimals = 2)     { fromFloat(v, decimals); }
+
+    inline unsigned length() const                   { return size(); }
+    inline bool     concat(const String &s)          { append(s); return true; }
+    inline bool     concat(const char *s)            { if (s) append(s); return true; }
+    inline bool     concat(char c)                   { push_back(c); return true; }
+    inline char     charAt(unsigned i) const         { return i < size() ? (*this)[i] : 0; }
+    inline void     setCharAt(unsigned i, char c)    { if (i < size()) (*this)[i] = c; }
+    inline int      indexOf(char c, unsigned from = 0) const            { size_t p = find(c, from); return p == npos ? -1 : int(p); }
+    inline int      indexOf(const String &s, unsigned from = 0) const   { size_t p = find(s, from); return p == npos ? -1 : int(p); }
+    inline int      lastIndexOf(char c) const        { size_t p = rfind(c); return p == npos ? -1 : int(p); }
+    inline String   substring(unsigned from) const   { return from < size() ? String(substr(from)) : String(); }
+    inline String   substring(unsigned from, unsigned to) const { return from < size() && to > from ? String(substr(from, to - from)) : String(); }
+    inline bool     startsWith(const String &s) const { return compare(0, s.size(), s) == 0; }
+    inline bool     endsWith(const String &s) const   { return size() >= s.size() && compare(size() - s.size(), s.size(), s) == 0; }
+    inline bool     equals(const String &s) const     { return *this == s; }
+    inline long     toInt() const                     { return atol(c_str()); }
+    inline float    toFloat() const                   { return atof(c_str()); }
+    inline void     toLowerCase()                     { for (auto &c : *this) c = tolower(c); }
+    inline void     toUpperCase()                     { for (auto &c : *this) c = toupper(c); }
+    inline void     trim() {
+      size_t b = find_first_not_of(" \t\r\n");
+      size_t e = find_last_not_of(" \t\r\n");
+      *this = b == npos ? String() : String(substr(b, e - b + 1));
+    }
+    inline String &operator+=(const String &s)       { append(s); return *this; }
+    inline String &operator+=(const char *s)         { if (s) append(s); return *this; }
+    inline String &operator+=(char c)                { push_back(c); return *this; }
+    inline String &operator+=(int v)                 { append(String(v)); return *this; }
+    inline String &operator+=(unsigned v)            { append(String(v)); return *this; }
+    inline String &operator+=(long v)                { append(String(v)); return *this; }
+    inline String &operator+=(unsigned long v)       { append(String(v)); return *this; }
+
+  private:
+    template<typename T> void fromInt(T v, unsigned char base) {
+      char buf[34];
+      if (base == 16)     snprintf(buf, sizeof(buf), "%lx", (unsigned long)v);
+      else if (base == 8) snprintf(buf, sizeof(buf), "%lo", (unsigned long)v);
+      else                snprintf(buf, sizeof(buf), std::is_signed<T>::value ? "%ld" : "%lu", (long)v);
+      assign(buf);
+    }
+    void fromFloat(double v, unsigned char decimals) {
+      char buf[48];
+      snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+      assign(buf);
+    }
+};
+
+inline String operator+(const String &a, const String &b) { String r(a); r += b; return r; }
+inline String operator+(const String &a, const char *b)   { String r(a); r += b; return r; }
+inline String operator+(const char *a, const String &b)   { String r(a); r += b; return r; }
+inline String operator+(const String &a, char b)          { String r(a); r += b; return r; }
+
+#include "Print.h"
+#include "IPAddress.h"
+
+class HostSerial : public Print {
+  public:
+    void   begin(unsigned long) {}
+    void   end() {}
+    void   flush() {}
+    int    available() { return 0; }
+    int    read() { return -1; }
+    size_t write(uint8_t c) override { return fputc(c, stderr) == EOF ? 0 : 1; }
+    size_t write(const uint8_t *buffer, size_t size) override { return fwrite(buffer, 1, size, stderr); }
+    using Print::write;
+    explicit operator bool() const { return true; }
+};
+extern HostSerial Serial;
+
+#endif
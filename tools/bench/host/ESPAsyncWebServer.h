@@ -0,0 +1,30 @@
+#pragma once
+#ifndef WLED_HOST_ASYNCWEBSERVER_H
+#define WLED_HOST_ASYNCWEBSERVER_H
+// host-native stand-in for ESPAsyncWebServer: the benchmark build has no web server,
+// only the types named in fcn_declare.h and the wled.h globals are provided
+#include "Arduino.h"
+
+#define ASYNC_JSON_H_  // skip AsyncJson-v6.h, its handlers need the real server
+
+class AsyncWebServerRequest;
+class AsyncWebSocket;
+class AsyncWebSocketClient;
+class AsyncWebHandler;
+class AsyncClient;
+
+typedef enum { WS_EVT_CONNECT, WS_EVT_DISCONNECT, WS_EVT_PONG, WS_EVT_ERROR, WS_EVT_DATA } AwsEventType;
+
+struct AsyncWebServerQueueLimits {
+  size_t nMaxQueued;
+  size_t nMaxConcurrent;
+  size_t nMinHeap;
+  size_t nHeapUsage;
+};
+
+class AsyncWebServer {
+  public:
+    AsyncWebServer(uint16_t port, const AsyncWebServerQueueLimits &limits = {}) {}
+};
+
+#endif
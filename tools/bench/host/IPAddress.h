@@ -0,0 +1,39 @@
+#pragma once
+#ifndef WLED_HOST_IPADDRESS_H
+#define WLED_HOST_IPADDRESS_H
+// host-native replacement for the Arduino IPAddress class (see Arduino.h)
+#include "Arduino.h"
+
+class IPAddress {
+  private:
+    union {
+      uint8_t  bytes[4];
+      uint32_t dword;
+    } _address;
+
+  public:
+    IPAddress()                                           { _address.dword = 0; }
+    IPAddress(uint32_t address)                           { _address.dword = address; }
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) { _address.bytes[0] = a; _address.bytes[1] = b; _address.bytes[2] = c; _address.bytes[3] = d; }
+
+    inline operator uint32_t() const                      { return _address.dword; }
+    inline bool operator==(const IPAddress &a) const      { return _address.dword == a._address.dword; }
+    inline bool operator!=(const IPAddress &a) const      { return _address.dword != a._address.dword; }
+    inline uint8_t  operator[](int index) const           { return _address.bytes[index]; }
+    inline uint8_t &operator[](int index)                 { return _address.bytes[index]; }
+    inline bool     isSet() const                         { return _address.dword != 0; }
+
+    bool fromString(const char *address) {
+      unsigned a, b, c, d;
+      if (sscanf(address, "%u.%u.%u.%u", &a, &b, &c, &d) != 4 || a > 255 || b > 255 || c > 255 || d > 255) return false;
+      *this = IPAddress(a, b, c, d);
+      return true;
+    }
+    String toString() const {
+      char buf[16];
+      snprintf(buf, sizeof(buf), "%u.%u.%u.%u", _address.bytes[0], _address.bytes[1], _address.bytes[2], _address.bytes[3]);
+      return String(buf);
+    }
+};
+
+#endif
@@ -0,0 +1,46 @@
+#pragma once
+#ifndef WLED_HOST_PRINT_H
+#define WLED_HOST_PRINT_H
+// host-native replacement for the Arduino Print class (see Arduino.h)
+#include "Arduino.h"
+
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size) {
+      size_t n = 0;
+      while (size--) n += write(*buffer++);
+      return n;
+    }
+    inline size_t write(const char *str)                      { return str ? write(reinterpret_cast<const uint8_t *>(str), strlen(str)) : 0; }
+    inline size_t write(const char *buffer, size_t size)      { return write(reinterpret_cast<const uint8_t *>(buffer), size); }
+
+    inline size_t print(const char *s)                        { return write(s); }
+    inline size_t print(const __FlashStringHelper *s)         { return write(reinterpret_cast<const char *>(s)); }
+    inline size_t print(const String &s)                      { return write(s.c_str(), s.length()); }
+    inline size_t print(char c)                               { return write(uint8_t(c)); }
+    inline size_t print(unsigned char v, int base = DEC)      { return print((unsigned long)v, base); }
+    inline size_t print(int v, int base = DEC)                { return print((long)v, base); }
+    inline size_t print(unsigned v, int base = DEC)           { return print((unsigned long)v, base); }
+    inline size_t print(long v, int base = DEC)               { return base == DEC ? printf("%ld", v) : print((unsigned long)v, base); }
+    inline size_t print(unsigned long v, int base = DEC)      { return printf(base == HEX ? "%lX" : base == OCT ? "%lo" : "%lu", v); }
+    inline size_t print(double v, int digits = 2)             { return printf("%.*f", digits, v); }
+
+    inline size_t println()                                   { return write("\r\n"); }
+    template<typename T> inline size_t println(const T &v)    { size_t n = print(v); return n + println(); }
+    template<typename T> inline size_t println(const T &v, int f) { size_t n = print(v, f); return n + println(); }
+
+    size_t printf(const char *format, ...) __attribute__ ((format (printf, 2, 3))) {
+      char buf[256];
+      va_list arg;
+      va_start(arg, format);
+      int len = vsnprintf(buf, sizeof(buf), format, arg);
+      va_end(arg);
+      if (len < 0) return 0;
+      return write(buf, std::min((size_t)len, sizeof(buf) - 1));
+    }
+    #define printf_P printf
+};
+
+#endif
@@ -0,0 +1,3 @@
+#pragma once
+// pre-1.0 Arduino header name used by the bundled Time/Timezone libraries
+#include "Arduino.h"
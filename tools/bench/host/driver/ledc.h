@@ -0,0 +1,4 @@
+#pragma once
+// host-native replacement for ESP-IDF driver/ledc.h: only the channel counts used by const.h (classic ESP32 values)
+#define LEDC_CHANNEL_MAX    8
+#define LEDC_SPEED_MODE_MAX 2
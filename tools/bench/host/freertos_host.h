@@ -0,0 +1,72 @@
+#pragma once
+#ifndef WLED_FREERTOS_HOST_H
+#define WLED_FREERTOS_HOST_H
+/*
+ * Host-native FreeRTOS emulation for -D WLED_PARALLEL_RENDER ([env:native_par], see tools/bench/README.md)
+ * Included by wled_host.h. Tasks are detached threads, each with the core ID it was pinned to; the Arduino loop
+ * (main thread) runs on core 1. Only the calls used by the render task are provided.
+ */
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#define portMAX_DELAY 0xFFFFFFFF
+#define pdTRUE        1
+#define pdFALSE       0
+
+struct HostSemaphore {
+  std::mutex              m;
+  std::condition_variable cv;
+  bool                    given = false;
+};
+struct HostTask {
+  std::mutex              m;
+  std::condition_variable cv;
+  unsigned                notified = 0;
+};
+typedef HostSemaphore* SemaphoreHandle_t;
+typedef HostTask*      TaskHandle_t;
+
+inline thread_local HostTask *hostCurrentTask = nullptr;
+inline thread_local int       hostCoreId = 1;
+inline bool                   hostTaskCreation = true; // false: task creation fails (single core reference runs)
+
+inline SemaphoreHandle_t xSemaphoreCreateBinary() { return new HostSemaphore; }
+inline void vSemaphoreDelete(SemaphoreHandle_t s)  { delete s; }
+inline int xSemaphoreGive(SemaphoreHandle_t s) {
+  std::lock_guard<std::mutex> lock(s->m); // notified under lock: the taker may delete the semaphore right after
+  s->given = true;
+  s->cv.notify_all();
+  return pdTRUE;
+}
+inline int xSemaphoreTake(SemaphoreHandle_t s, unsigned ticks) { // only portMAX_DELAY is supported
+  std::unique_lock<std::mutex> lock(s->m);
+  s->cv.wait(lock, [s]{ return s->given; });
+  s->given = false;
+  return pdTRUE;
+}
+
+inline int xTaskCreatePinnedToCore(void (*fn)(void*), const char *name, unsigned stack, void *arg, unsigned prio, TaskHandle_t *handle, int core) {
+  if (!hostTaskCreation) return pdFALSE;
+  HostTask *task = new HostTask;
+  *handle = task;
+  std::thread([=]{ hostCurrentTask = task; hostCoreId = core; fn(arg); }).detach();
+  return pdTRUE;
+}
+inline void vTaskDelete(TaskHandle_t task) {} // tasks wait for notifications forever, the thread is left behind
+inline void xTaskNotifyGive(TaskHandle_t task) {
+  std::lock_guard<std::mutex> lock(task->m);
+  task->notified++;
+  task->cv.notify_all();
+}
+inline unsigned ulTaskNotifyTake(int clear, unsigned ticks) { // only portMAX_DELAY is supported
+  HostTask *task = hostCurrentTask;
+  std::unique_lock<std::mutex> lock(task->m);
+  task->cv.wait(lock, [task]{ return task->notified > 0; });
+  unsigned n = task->notified;
+  task->notified = clear ? 0 : n - 1;
+  return n;
+}
+inline int xPortGetCoreID() { return hostCoreId; }
+
+#endif
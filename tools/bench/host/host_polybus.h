@@ -0,0 +1,86 @@
+#pragma once
+#ifndef WLED_HOST_POLYBUS_H
+#define WLED_HOST_POLYBUS_H
+/*
+ * Host-native replacement for bus_wrapper.h ([env:native_abl], see tools/bench/README.md)
+ * Included by bus_manager.cpp instead of NeoPixelBus when WLED_HOST_BUILD is defined.
+ * Every digital bus is a plain pixel array that keeps the colors BusDigital encoded for it, in WLED
+ * channel order (the color order and W swap are not applied). Nothing is ever transmitted.
+ */
+#include <algorithm>
+#include <vector>
+#include "wled_host.h"
+
+#define I_NONE   0
+#define I_HOST_3 1 // RGB
+#define I_HOST_4 2 // RGBW
+#define I_HOST_5 3 // 16 bit RGB/RGBW/RGBCW (UCS8903/UCS8904/SM16825)
+
+#define RGBW32(r,g,b,w) (uint32_t((byte(w) << 24) | (byte(r) << 16) | (byte(g) << 8) | (byte(b))))
+
+struct HostPixelBus {
+  std::vector<uint32_t> pixels;   // 8 bit encoded colors
+  std::vector<uint64_t> pixels16; // 16 bit encoded colors (W, R, G, B from high to low word)
+  std::vector<uint32_t> cct16;    // 16 bit WW (low word) and CW (high word) of SM16825 pixels
+  uint32_t              shows = 0;
+};
+inline std::vector<HostPixelBus*> hostPixelBuses; // all buses created by PolyBus, in creation order
+
+class PolyBus {
+  private:
+    static bool _useParallelI2S;
+
+    static inline HostPixelBus *bus(void *busPtr) { return static_cast<HostPixelBus*>(busPtr); }
+
+  public:
+    static inline void setParallelI2S1Output(bool b = true) { _useParallelI2S = b; }
+    static inline bool isParallelI2S1Output(void) { return _useParallelI2S; }
+
+    static void *create(uint8_t busType, uint8_t *pins, uint16_t len, uint8_t channel) {
+      if (busType == I_NONE) return nullptr;
+      HostPixelBus *b = new HostPixelBus;
+      b->pixels.resize(len);
+      if (busType == I_HOST_5) { b->pixels16.resize(len); b->cct16.resize(len); }
+      hostPixelBuses.push_back(b);
+      return b;
+    }
+    static void begin(void *busPtr, uint8_t busType, uint8_t *pins, uint16_t clock_kHz) {}
+    static void show(void *busPtr, uint8_t busType, bool consistent = true) { if (busPtr) bus(busPtr)->shows++; }
+    static bool canShow(void *busPtr, uint8_t busType)                      { return true; }
+    static void cleanup(void *busPtr, uint8_t busType) {
+      if (!busPtr) return;
+      hostPixelBuses.erase(std::find(hostPixelBuses.begin(), hostPixelBuses.end(), bus(busPtr)));
+      delete bus(busPtr);
+    }
+
+    static void setPixelColor(void *busPtr, uint8_t busType, uint16_t pix, uint32_t c, uint8_t co, uint16_t wwcw = 0) {
+      bus(busPtr)->pixels[pix] = c;
+    }
+    static void setPixelColor16(void *busPtr, uint8_t busType, uint16_t pix, const uint16_t c[4], uint8_t co, uint16_t cctWW = 0, uint16_t cctCW = 0) {
+      HostPixelBus *b = bus(busPtr);
+      b->pixels16[pix] = (uint64_t(c[3]) << 48) | (uint64_t(c[2]) << 32) | (uint64_t(c[1]) << 16) | c[0];
+      b->cct16[pix]    = cctWW | (uint32_t(cctCW) << 16);
+      b->pixels[pix]   = RGBW32(c[2] >> 8, c[1] >> 8, c[0] >> 8, c[3] >> 8);
+    }
+    static uint32_t getPixelColor(void *busPtr, uint8_t busType, uint16_t pix, uint8_t co) {
+      return bus(busPtr)->pixels[pix];
+    }
+    static uint8_t *getPixelBuffer(void *busPtr, uint8_t busType, unsigned &channels) {
+      channels = 0; // no wire buffer: BusDigital falls back to getPixelColor()
+      return nullptr;
+    }
+
+    static unsigned getDataSize(void *busPtr, uint8_t busType) {
+      return busPtr ? bus(busPtr)->pixels.size() * (busType == I_HOST_5 ? 10 : 4) : 0;
+    }
+    static unsigned memUsage(unsigned count, unsigned busType) {
+      return count * (busType == I_HOST_5 ? 10 : 4);
+    }
+    static uint8_t getI(uint8_t busType, const uint8_t *pins, uint8_t num = 0) {
+      if (!Bus::isDigital(busType) || Bus::is2Pin(busType)) return I_NONE; // no SPI chipsets on host
+      if (Bus::is16bit(busType)) return I_HOST_5;
+      return Bus::hasWhite(busType) ? I_HOST_4 : I_HOST_3;
+    }
+};
+
+#endif
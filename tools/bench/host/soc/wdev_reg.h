@@ -0,0 +1,7 @@
+#pragma once
+// host-native stand-in for the ESP32 hardware RNG register used by hw_random() (fcn_declare.h)
+// reads are served by a seeded xorshift generator so benchmark runs are reproducible
+#include "Arduino.h"
+
+#define WDEV_RND_REG  0
+#define REG_READ(reg) hostRandom32()
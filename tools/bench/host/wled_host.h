@@ -0,0 +1,173 @@
+#pragma once
+#ifndef WLED_HOST_H
+#define WLED_HOST_H
+/*
+ * Host-native build support ([env:native], see tools/bench/README.md)
+ * Included by wled.h in place of the Arduino, ESP-IDF and network libraries when WLED_HOST_BUILD is defined.
+ * Provides just enough of those APIs for the render core (WS2812FX, Segment, effects, colors, util) and
+ * the wled.h globals to compile on a PC. Nothing here talks to real hardware or the network.
+ */
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include <Print.h>
+#include <ESPAsyncWebServer.h>
+#include <ctime>
+
+#include "src/dependencies/time/TimeLib.h"
+#include "src/dependencies/timezone/Timezone.h"
+#include "src/dependencies/toki/Toki.h"
+#ifdef WLED_PARALLEL_RENDER
+  #include "freertos_host.h" // render task on emulated second core ([env:native_par])
+#endif
+
+#define SPIFFS_EDITOR_AIRCOOOKIE   // satisfies the library fork check in wled.h
+
+// heap: allocations made through heap_caps_*() are tracked so the benchmark can report a high-water mark
+#define MALLOC_CAP_EXEC     (1<<0)
+#define MALLOC_CAP_32BIT    (1<<1)
+#define MALLOC_CAP_8BIT     (1<<2)
+#define MALLOC_CAP_DMA      (1<<3)
+#define MALLOC_CAP_SPIRAM   (1<<10)
+#define MALLOC_CAP_INTERNAL (1<<11)
+#define MALLOC_CAP_DEFAULT  (1<<12)
+#define MALLOC_CAP_RTCRAM   (1<<15)
+#define SOC_DRAM_LOW        0  // host heap is never treated as low DRAM (see validateFreeHeap() in util.cpp)
+#define SOC_DRAM_HIGH       0
+
+#ifndef WLED_HOST_HEAP_SIZE
+  #define WLED_HOST_HEAP_SIZE (4*1024*1024) // allocation budget; use -D WLED_HOST_HEAP_SIZE=(320*1024) to emulate an ESP32 without PSRAM
+#endif
+
+void  *heap_caps_malloc(size_t size, uint32_t caps);
+void  *heap_caps_malloc_prefer(size_t size, size_t num, ...);
+void  *heap_caps_realloc(void *ptr, size_t size, uint32_t caps);
+void   heap_caps_free(void *ptr);
+size_t heap_caps_get_free_size(uint32_t caps);
+size_t heap_caps_get_largest_free_block(uint32_t caps);
+
+struct HostHeapStats {
+  size_t used;        // bytes currently allocated
+  size_t highWater;   // maximum of used since last reset
+  size_t allocations; // number of allocations since last reset
+};
+const HostHeapStats &hostHeapStats();
+void hostHeapResetHighWater();
+
+class EspClass {
+  public:
+    inline uint32_t getFreeHeap()          { return heap_caps_get_free_size(MALLOC_CAP_8BIT); }
+    inline uint32_t getMaxAllocHeap()      { return heap_caps_get_largest_free_block(MALLOC_CAP_8BIT); }
+    inline uint32_t getHeapSize()          { return WLED_HOST_HEAP_SIZE; }
+    inline uint32_t getFreePsram()         { return 0; }
+    inline uint32_t getPsramSize()         { return 0; }
+    inline uint32_t getCpuFreqMHz()        { return 240; }
+    inline uint32_t getCycleCount()        { return micros() * 240; }
+    inline void     restart()              { exit(0); }
+};
+extern EspClass ESP;
+
+// filesystem: always empty, so no ledmaps, 2D gaps or custom palettes are loaded
+namespace fs {
+  class File {
+    public:
+      explicit operator bool() const                              { return false; }
+      inline int    available()                                   { return 0; }
+      inline int    read()                                        { return -1; }
+      inline int    peek()                                        { return -1; }
+      inline size_t read(uint8_t *, size_t)                       { return 0; }
+      inline size_t readBytes(char *, size_t)                     { return 0; }
+      inline size_t readBytesUntil(char, char *, size_t)          { return 0; }
+      inline bool   find(const char *)                            { return false; }
+      inline bool   seek(size_t)                                  { return false; }
+      inline size_t position() const                              { return 0; }
+      inline size_t size() const                                  { return 0; }
+      inline const char *name() const                             { return ""; }
+      inline void   close()                                       {}
+  };
+  class FS {
+    public:
+      inline bool begin()                                         { return true; }
+      inline bool exists(const char *)                            { return false; }
+      inline bool exists(const String &)                          { return false; }
+      inline File open(const char *, const char * = "r")          { return File(); }
+      inline File open(const String &, const char * = "r")        { return File(); }
+      inline bool remove(const char *)                            { return false; }
+  };
+}
+using fs::File;
+extern fs::FS LittleFS;
+
+// network: types only, the benchmark never opens a socket
+typedef int WiFiEvent_t;
+
+class WiFiUDP {
+  public:
+    inline uint8_t begin(uint16_t)                                { return 0; }
+    inline void    stop()                                         {}
+    inline int     parsePacket()                                  { return 0; }
+    inline int     read(uint8_t *, size_t)                        { return 0; }
+    inline int     beginPacket(IPAddress, uint16_t)               { return 0; }
+    inline size_t  write(const uint8_t *, size_t size)            { return size; }
+    inline int     endPacket()                                    { return 0; }
+};
+
+class DNSServer {
+  public:
+    inline void processNextRequest()                              {}
+    inline void stop()                                            {}
+};
+
+class NetworkClass {
+  public:
+    inline IPAddress localIP()                                    { return IPAddress(); }
+    inline IPAddress subnetMask()                                 { return IPAddress(); }
+    inline IPAddress gatewayIP()                                  { return IPAddress(); }
+    inline void      localMAC(uint8_t *MAC)                       { memset(MAC, 0, 6); }
+    inline bool      isConnected()                                { return false; }
+    inline bool      isEthernet()                                 { return false; }
+};
+extern NetworkClass Network;
+
+// E1.31/Art-Net/DDP packet types named in fcn_declare.h (contents are never parsed on host)
+// ports and offsets are copied from ESPAsyncE131.h for the network bus in bus_manager.cpp ([env:native_abl])
+#define E131_DEFAULT_PORT   5568
+#define ARTNET_DEFAULT_PORT 6454
+#define DDP_DEFAULT_PORT    4048
+#define DDP_TYPE_RGB24      0x0B
+#define DDP_TYPE_RGBW32     0x1B
+#define E131_ROOT_FLENGTH   16
+#define E131_ROOT_VECTOR    18
+#define E131_ROOT_CID       22
+#define E131_FRAME_FLENGTH  38
+#define E131_FRAME_VECTOR   40
+#define E131_FRAME_SOURCE   44
+#define E131_FRAME_PRIORITY 108
+#define E131_FRAME_SEQ      111
+#define E131_FRAME_UNIVERSE 113
+#define E131_DMP_FLENGTH    115
+#define E131_DMP_VECTOR     117
+#define E131_DMP_TYPE       118
+#define E131_DMP_ADDR_INC   121
+#define E131_DMP_COUNT      123
+#define E131_DMP_DATA       125
+
+typedef union { uint8_t raw[638]; } e131_packet_t;
+typedef union { uint8_t raw[239]; } ArtPollReply;
+typedef void (*e131_packet_callback_function) (e131_packet_t* p, IPAddress clientIP, byte protocol);
+
+class ESPAsyncE131 {
+  public:
+    ESPAsyncE131(e131_packet_callback_function callback) {}
+    inline bool begin(bool multicast, uint16_t port = 5568, uint16_t universe = 1, uint8_t n = 1) { return false; }
+    inline void joinSyncUniverse(uint16_t universe) {}
+};
+
+class E131Priority {
+  public:
+    E131Priority(uint8_t timeout=3) {}
+    inline void    set(uint8_t prio)                              {}
+    inline uint8_t get()                                          { return 0; }
+};
+
+#endif
@@ -0,0 +1,147 @@
+/*
+ * BusManager for the host-native benchmark ([env:native]), see host_bus.h
+ * Mirrors the bookkeeping in bus_manager.cpp without any hardware drivers. ABL is never active
+ * because no bus reports an LED current.
+ */
+#include "host_bus.h"
+
+BusRecording::BusRecording(const BusConfig &bc)
+: Bus(bc.type, bc.start, bc.autoWhite, bc.count, bc.reversed, (bc.refreshReq || bc.type == TYPE_TM1814))
+, _shows(0)
+, _colorOrder(bc.colorOrder)
+{
+  _hasRgb   = hasRGB(bc.type);
+  _hasWhite = hasWhite(bc.type);
+  _hasCCT   = hasCCT(bc.type);
+  _data.resize(_len, 0);
+  _valid = _data.size() == _len;
+}
+
+void BusRecording::setPixelColor(unsigned pix, uint32_t c) {
+  if (!_valid || pix >= _len) return;
+  if (_reversed) pix = _len - pix - 1;
+  _data[pix] = c;
+}
+
+uint32_t BusRecording::getPixelColor(unsigned pix) const {
+  if (!_valid || pix >= _len) return 0;
+  if (_reversed) pix = _len - pix - 1;
+  return _data[pix];
+}
+
+
+size_t BusConfig::memUsage(unsigned nr) const {
+  return sizeof(BusRecording) + count * Bus::getNumberOfChannels(type); // what a wire buffer would take, keeps MAX_LED_MEMORY meaningful
+}
+
+
+static ColorOrderMap _colorOrderMap = {};
+
+size_t BusManager::memUsage() {
+  size_t size = 0;
+  for (const auto &bus : busses) size += bus->getBusSize();
+  return size;
+}
+
+int BusManager::add(const BusConfig &bc) {
+  if (busses.size() >= WLED_MAX_BUSSES) return -1;
+  busses.push_back(make_unique<BusRecording>(bc));
+  return busses.size();
+}
+
+String BusManager::getLEDTypesJSONString() { return String(F("[]")); }
+
+void BusManager::useParallelOutput() {}
+bool BusManager::hasParallelOutput() { return false; }
+
+void BusManager::removeAll() { busses.clear(); }
+
+void BusManager::on() {}
+
+void BusManager::off() { _gMilliAmpsUsed = 0; }
+
+void BusManager::show() { showBusses(); }
+
+void BusManager::setPixelColor(unsigned pix, uint32_t c) {
+  for (auto &bus : busses) {
+    if (!bus->containsPixel(pix)) continue;
+    bus->setPixelColor(pix - bus->getStart(), c);
+  }
+}
+
+void BusManager::setPixels(unsigned start, const uint32_t *colors, size_t len, bool gamma) {
+  const unsigned end = start + len;
+  for (auto &bus : busses) {
+    unsigned busStart = bus->getStart();
+    unsigned first    = std::max(start, busStart);
+    unsigned last     = std::min(end, busStart + bus->getLength());
+    if (first >= last) continue;
+    bus->setPixels(first - busStart, colors + (first - start), last - first, gamma);
+  }
+}
+
+#ifdef WLED_PIXEL16
+void BusManager::setPixels(unsigned start, const uint64_t *colors, size_t len, bool gamma) {
+  const unsigned end = start + len;
+  for (auto &bus : busses) {
+    unsigned busStart = bus->getStart();
+    unsigned first    = std::max(start, busStart);
+    unsigned last     = std::min(end, busStart + bus->getLength());
+    if (first >= last) continue;
+    bus->setPixels64(first - busStart, colors + (first - start), last - first, gamma);
+  }
+}
+#endif
+
+void BusManager::setSegmentCCT(int16_t cct, bool allowWBCorrection) {
+  if (cct > 255) cct = 255;
+  if (cct >= 0) {
+    if (allowWBCorrection) cct = 1900 + (cct << 5);
+  } else cct = -1;
+  Bus::setCCT(cct);
+}
+
+uint32_t BusManager::getPixelColor(unsigned pix) {
+  for (auto &bus : busses) {
+    if (!bus->containsPixel(pix)) continue;
+    return bus->getPixelColor(pix - bus->getStart());
+  }
+  return 0;
+}
+
+bool BusManager::canAllShow() { return true; }
+
+void BusManager::initializeABL() { _useABL = false; }
+
+void BusManager::sumColors(unsigned start, const uint32_t *colors, size_t len, bool gamma) {}
+#ifdef WLED_PIXEL16
+void BusManager::sumColors(unsigned start, const uint64_t *colors, size_t len, bool gamma) {}
+#endif
+
+void BusManager::applyABL() { _gMilliAmpsUsed = 0; }
+
+bool BusManager::pollBusses() { return false; }
+
+ColorOrderMap& BusManager::getColorOrderMap() { return _colorOrderMap; }
+
+
+void Bus::setPixels(unsigned pix, const uint32_t *colors, size_t len, bool gamma) {
+  for (size_t i = 0; i < len; i++) setPixelColor(pix + i, gamma ? gamma32(colors[i]) : colors[i]);
+}
+
+#ifdef WLED_PIXEL16
+void Bus::setPixels64(unsigned pix, const uint64_t *colors, size_t len, bool gamma) {
+  for (size_t i = 0; i < len; i++) setPixelColor(pix + i, gamma ? gamma32(fromPixel(colors[i])) : fromPixel(colors[i]));
+}
+#endif
+
+// Bus static member definition
+int16_t Bus::_cct = -1;
+uint8_t Bus::_cctBlend = 0;
+uint8_t Bus::_gAWM = 255;
+bool Bus::_gDither = false;
+
+std::vector<std::unique_ptr<Bus>> BusManager::busses;
+uint16_t BusManager::_gMilliAmpsUsed = 0;
+uint16_t BusManager::_gMilliAmpsMax = ABL_MILLIAMPS_DEFAULT;
+bool BusManager::_useABL = false;
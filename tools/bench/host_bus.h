@@ -0,0 +1,31 @@
+#pragma once
+#ifndef WLED_HOST_BUS_H
+#define WLED_HOST_BUS_H
+/*
+ * Recording null bus for the host-native benchmark ([env:native])
+ * Replaces bus_manager.cpp: every configured output becomes a BusRecording that keeps the last
+ * frame it was sent in memory, so the runner can hash what the strip would have put on the wire.
+ */
+#include "wled.h"
+
+class BusRecording : public Bus {
+  public:
+    BusRecording(const BusConfig &bc);
+
+    void     show() override                                { _shows++; }
+    void     setPixelColor(unsigned pix, uint32_t c) override;
+    uint32_t getPixelColor(unsigned pix) const override;
+    uint8_t  getColorOrder() const override                 { return _colorOrder; }
+    size_t   getBusSize() const override                    { return sizeof(BusRecording) + _data.capacity() * sizeof(uint32_t); }
+
+    inline const uint32_t *getData() const                  { return _data.data(); }
+    inline uint32_t        getShows() const                 { return _shows; }
+    inline void            resetShows()                     { _shows = 0; }
+
+  private:
+    std::vector<uint32_t> _data;
+    uint32_t              _shows;
+    uint8_t               _colorOrder;
+};
+
+#endif
@@ -0,0 +1,130 @@
+/*
+ * Host-native platform layer for the render benchmark ([env:native])
+ * Virtual clock, deterministic random source and a tracking heap behind the shims in tools/bench/host.
+ */
+#include "wled.h"
+
+#include <new>
+#include <cstdarg>
+#if defined(__APPLE__)
+  #include <malloc/malloc.h>
+  #define HOST_USABLE_SIZE(p) malloc_size(p)
+#else
+  #include <malloc.h>
+  #define HOST_USABLE_SIZE(p) malloc_usable_size(p)
+#endif
+
+HostSerial   Serial;
+EspClass     ESP;
+fs::FS       LittleFS;
+NetworkClass Network;
+
+// virtual clock: only the benchmark runner (or code waiting in delay()) moves time forward
+static unsigned long hostMillis = 0;
+
+unsigned long millis()                    { return hostMillis; }
+unsigned long micros()                    { return hostMillis * 1000UL; }
+void delay(unsigned long ms)              { hostMillis += ms; }
+void delayMicroseconds(unsigned int us)   { hostMillis += us / 1000; }
+void yield()                              {}
+void hostAdvanceMillis(unsigned long ms)  { hostMillis += ms; }
+void hostSetMillis(unsigned long ms)      { hostMillis = ms; }
+
+// xorshift32, reseeded by the runner before every effect so each run sees the same "hardware" random sequence
+static uint32_t hostRndState = 0x2545F491;
+
+uint32_t hostRandom32() {
+  uint32_t x = hostRndState;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return hostRndState = x;
+}
+
+void hostRandomSeed(uint32_t seed) { hostRndState = seed ? seed : 0x2545F491; }
+
+// tracking heap
+static HostHeapStats hostHeap = {0, 0, 0};
+#ifdef WLED_PARALLEL_RENDER
+static std::mutex hostHeapLock; // both render tasks allocate
+  #define HOST_HEAP_LOCK std::lock_guard<std::mutex> lock(hostHeapLock)
+#else
+  #define HOST_HEAP_LOCK
+#endif
+
+static inline void *trackAlloc(void *ptr) {
+  if (ptr) {
+    HOST_HEAP_LOCK;
+    hostHeap.used += HOST_USABLE_SIZE(ptr);
+    hostHeap.allocations++;
+    if (hostHeap.used > hostHeap.highWater) hostHeap.highWater = hostHeap.used;
+  }
+  return ptr;
+}
+
+static inline void trackFree(void *ptr) {
+  if (ptr) {
+    HOST_HEAP_LOCK;
+    hostHeap.used -= HOST_USABLE_SIZE(ptr);
+  }
+}
+
+const HostHeapStats &hostHeapStats() { return hostHeap; }
+
+void hostHeapResetHighWater() {
+  hostHeap.highWater   = hostHeap.used;
+  hostHeap.allocations = 0;
+}
+
+void *heap_caps_malloc(size_t size, uint32_t caps) {
+  if (caps & MALLOC_CAP_SPIRAM) return nullptr; // no PSRAM on host, callers fall back to DRAM
+  if (hostHeap.used + size > WLED_HOST_HEAP_SIZE) return nullptr;
+  return trackAlloc(malloc(size));
+}
+
+void *heap_caps_malloc_prefer(size_t size, size_t num, ...) {
+  va_list caps;
+  va_start(caps, num);
+  void *ptr = nullptr;
+  while (num-- && !ptr) ptr = heap_caps_malloc(size, va_arg(caps, uint32_t));
+  va_end(caps);
+  return ptr;
+}
+
+void *heap_caps_realloc(void *ptr, size_t size, uint32_t caps) {
+  if (caps & MALLOC_CAP_SPIRAM) return nullptr;
+  size_t old = ptr ? HOST_USABLE_SIZE(ptr) : 0;
+  if (hostHeap.used - old + size > WLED_HOST_HEAP_SIZE) return nullptr;
+  void *buffer = realloc(ptr, size);
+  if (!buffer) return nullptr;
+  hostHeap.used -= old;
+  hostHeap.allocations--; // realloc is not a new allocation
+  return trackAlloc(buffer);
+}
+
+void heap_caps_free(void *ptr) {
+  trackFree(ptr);
+  free(ptr);
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+  return hostHeap.used < WLED_HOST_HEAP_SIZE ? WLED_HOST_HEAP_SIZE - hostHeap.used : 0;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps) {
+  return heap_caps_get_free_size(caps);
+}
+
+// C++ allocations (segment vectors, particle systems, std::string) count towards the same budget
+void *operator new(size_t size) {
+  void *ptr = trackAlloc(malloc(size ? size : 1));
+  if (!ptr) throw std::bad_alloc();
+  return ptr;
+}
+void *operator new[](size_t size)                          { return operator new(size); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept   { return trackAlloc(malloc(size ? size : 1)); }
+void *operator new[](size_t size, const std::nothrow_t &) noexcept { return trackAlloc(malloc(size ? size : 1)); }
+void operator delete(void *ptr) noexcept                   { trackFree(ptr); free(ptr); }
+void operator delete[](void *ptr) noexcept                 { trackFree(ptr); free(ptr); }
+void operator delete(void *ptr, size_t) noexcept           { trackFree(ptr); free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept         { trackFree(ptr); free(ptr); }
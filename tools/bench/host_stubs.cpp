@@ -0,0 +1,38 @@
+/*
+ * Host-native benchmark ([env:native]): wled.h globals and the few functions the render core
+ * pulls in from modules that are not part of the host build (led.cpp, file.cpp, um_manager.cpp, ...)
+ */
+#define WLED_DEFINE_GLOBAL_VARS // only in one source file, wled.cpp is not compiled on host
+#include "wled.h"
+
+// led.cpp
+byte scaledBri(byte in) {
+  unsigned val = ((unsigned)in*briMultiplier)/100;
+  if (val > 255) val = 255;
+  return (byte)val;
+}
+
+uint32_t get_millisecond_timer() {
+  return strip.now;
+}
+
+// file.cpp: there is no filesystem on host
+bool readObjectFromFileUsingId(const char* file, uint16_t id, JsonDocument* dest, const JsonDocument* filter) {
+  return false;
+}
+
+bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest, const JsonDocument* filter) {
+  return false;
+}
+
+// wled_server.cpp
+void createEditHandler(bool enable) {}
+
+// e131.cpp (referenced by the e131/ddp globals)
+void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol) {}
+
+// um_manager.cpp: no usermods, audio reactive effects fall back to simulated sound
+bool UsermodManager::getUMData(um_data_t **data, uint8_t mod_id) {
+  if (data) *data = nullptr;
+  return false;
+}
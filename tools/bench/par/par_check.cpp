@@ -0,0 +1,136 @@
+/*
+ * Parallel render check for the host-native build ([env:native_par], see tools/bench/README.md)
+ * Renders multi-segment setups with the render task on the emulated second core (host/freertos_host.h) and
+ * compares every frame with a single core run of the same setup (render task creation fails, all segments are
+ * rendered by the loop in segment order, as without WLED_PARALLEL_RENDER).
+ * Each setup has a Copy segment whose source is rendered by the parallel jobs: Copy must only run once the
+ * render task is done, otherwise it reads the source while the other core is still drawing it.
+ */
+#include "wled.h"
+#include "host_bus.h"
+
+#include <vector>
+
+struct ParSegment {
+  uint16_t start, stop, startY, stopY;
+  uint8_t  mode;
+  uint8_t  copyOf; // source segment for FX_MODE_COPY
+};
+
+struct ParCase {
+  const char             *name;
+  unsigned                width, height; // height 1 for a plain strip
+  std::vector<ParSegment> segments;
+  uint8_t                 source;        // segment read by the Copy segment
+};
+
+static const ParCase cases[] = {
+  {"strip, copy last", 1200, 1, {
+    {0,    300,  0, 1, FX_MODE_RAINBOW_CYCLE, 0},
+    {300,  600,  0, 1, FX_MODE_COLORWAVES,    0},
+    {600,  900,  0, 1, FX_MODE_PLASMA,        0},
+    {900,  1200, 0, 1, FX_MODE_COPY,          2}}, 2},
+  {"strip, copy first", 1200, 1, {
+    {0,    300,  0, 1, FX_MODE_COPY,          3},
+    {300,  600,  0, 1, FX_MODE_RAINBOW_CYCLE, 0},
+    {600,  900,  0, 1, FX_MODE_COLORWAVES,    0},
+    {900,  1200, 0, 1, FX_MODE_PLASMA,        0}}, 3},
+#ifndef WLED_DISABLE_2D
+  {"matrix", 64, 64, {
+    {0,  32, 0,  32, FX_MODE_2DPLASMAROTOZOOM, 0},
+    {32, 64, 0,  32, FX_MODE_2DDNASPIRAL,      0},
+    {0,  32, 32, 64, FX_MODE_2DPLASMAROTOZOOM, 0},
+    {32, 64, 32, 64, FX_MODE_COPY,             2}}, 2},
+#endif
+};
+
+// (re)creates output and segments of a case
+static void setupCase(const ParCase &c) {
+  uint8_t pins[OUTPUT_MAX_PINS] = {2, 255, 255, 255, 255};
+  busConfigs.clear();
+  busConfigs.emplace_back(TYPE_WS2812_RGB, pins, 0, c.width * c.height, COL_ORDER_GRB);
+
+  strip.panel.clear();
+  strip.isMatrix = c.height > 1;
+  if (strip.isMatrix) {
+    WS2812FX::Panel p;
+    p.width  = c.width;
+    p.height = c.height;
+    strip.panel.push_back(p);
+  }
+
+  bri = 255;
+  strip.setTransition(0);
+  strip.finalizeInit();
+  strip.makeAutoSegments(true);
+  strip.setBrightness(255, true);
+  strip.resetSegments();
+
+  for (size_t i = 0; i < c.segments.size(); i++) {
+    const ParSegment &s = c.segments[i];
+    if (i == 0) strip.getSegment(0).setGeometry(s.start, s.stop, 1, 0, UINT16_MAX, s.startY, s.stopY);
+    else        strip.appendSegment(s.start, s.stop, s.startY, s.stopY);
+    Segment &seg = strip.getSegment(i);
+    seg.setMode(s.mode, true);
+    if (s.mode == FX_MODE_COPY) seg.custom3 = s.copyOf;
+  }
+}
+
+// FNV-1a over everything the bus was sent
+static uint32_t frameHash() {
+  uint32_t hash = 2166136261UL;
+  for (size_t b = 0; b < BusManager::getNumBusses(); b++) {
+    const BusRecording *bus = static_cast<const BusRecording *>(BusManager::getBus(b));
+    const uint32_t *data = bus->getData();
+    for (unsigned i = 0; i < bus->getLength(); i++) {
+      uint32_t c = data[i];
+      for (int k = 0; k < 4; k++, c >>= 8) hash = (hash ^ (c & 0xFF)) * 16777619UL;
+    }
+  }
+  return hash;
+}
+
+// renders frames of a case, returns hash of every frame; onTask counts frames whose Copy source was rendered by the render task
+static std::vector<uint32_t> runCase(const ParCase &c, unsigned frames, unsigned &onTask) {
+  std::vector<uint32_t> hashes;
+  hostSetMillis(0);
+  hostRandomSeed(0);
+  random16_set_seed(1337);
+  setupCase(c);
+  onTask = 0;
+  for (unsigned f = 0; f < frames; f++) {
+    hostAdvanceMillis(std::max((unsigned)strip.getFrameTime(), (unsigned)MIN_FRAME_DELAY + 1));
+    strip._currentSegment[0] = nullptr; // render task is pinned to core 0 (see freertos_host.h)
+    strip.trigger();
+    strip.service();
+    if (strip._currentSegment[0] == &strip.getSegment(c.source)) onTask++;
+    hashes.push_back(frameHash());
+  }
+  return hashes;
+}
+
+int main(int argc, char **argv) {
+  const unsigned frames = argc > 1 ? std::max(1UL, strtoul(argv[1], nullptr, 10)) : 200;
+  const size_t numCases = sizeof(cases) / sizeof(cases[0]);
+  NeoGammaWLEDMethod::calcGammaTable(gammaCorrectVal); // done by deserializeConfig() on device
+
+  // single core reference first: the render task is created once and kept by the strip
+  std::vector<std::vector<uint32_t>> reference;
+  unsigned onTask;
+  hostTaskCreation = false;
+  for (size_t i = 0; i < numCases; i++) reference.push_back(runCase(cases[i], frames, onTask));
+  hostTaskCreation = true;
+
+  int failed = 0;
+  for (size_t i = 0; i < numCases; i++) {
+    std::vector<uint32_t> hashes = runCase(cases[i], frames, onTask);
+    unsigned diff = 0, first = 0;
+    for (unsigned f = 0; f < frames; f++) if (hashes[f] != reference[i][f] && !diff++) first = f;
+    printf("%-20s %4u frames, source on render task %4u, differing %4u", cases[i].name, frames, onTask, diff);
+    if (diff) printf(" (first %u)", first);
+    printf("\n");
+    if (diff) failed++;
+  }
+  printf("%d of %u cases differ from single core\n", failed, (unsigned)numCases);
+  return failed ? 1 : 0;
+}
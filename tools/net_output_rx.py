@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+"""
+Loopback receiver for WLED network output busses (DDP, E1.31 and Art-Net).
+
+Listens on the protocol ports, validates every packet (headers, lengths, sequence numbers, frame completeness)
+and prints frame rate and throughput for each destination node and protocol once per second.
+
+Multiple destination nodes use consecutive IP addresses, so a local test with e.g. 4 nodes starting at 127.0.0.1:
+    python3 net_output_rx.py --addr 127.0.0.1 --nodes 4 --pixels 5000
+"""
+import argparse
+import ipaddress
+import select
+import socket
+import struct
+import time
+
+DDP_PORT = 4048
+E131_PORT = 5568
+ARTNET_PORT = 6454
+
+DDP_TYPES = {0x0B: 3, 0x1B: 4}  # RGB24, RGBW32
+ACN_ID = b"\x00\x10\x00\x00ASC-E1.17\x00\x00\x00"
+ARTNET_ID = b"Art-Net\x00"
+
+
+class NodeStats:
+    def __init__(self, name, expected_pixels, channels):
+        self.name = name
+        self.expected_pixels = expected_pixels
+        self.channels = channels
+        self.packets = 0
+        self.bytes = 0
+        self.frames = 0
+        self.pixels = 0
+        self.errors = 0
+        self.seq = None
+        self.frame_channels = 0  # channels received in current frame
+        self.next_offset = 0     # DDP: expected data offset / E1.31 & Art-Net: expected universe
+
+    def error(self, msg):
+        self.errors += 1
+        if self.errors <= 10:
+            print(f"{self.name}: {msg}")
+
+    def end_frame(self):
+        if self.frame_channels == 0:
+            return
+        pixels = self.frame_channels // self.channels
+        if self.frame_channels % self.channels:
+            self.error(f"frame has {self.frame_channels} channels, not a multiple of {self.channels}")
+        if self.expected_pixels and pixels != self.expected_pixels:
+            self.error(f"frame has {pixels} pixels, expected {self.expected_pixels}")
+        self.frames += 1
+        self.pixels += pixels
+        self.frame_channels = 0
+
+    def report(self, elapsed):
+        print(f"{self.name}: {self.frames / elapsed:6.1f} fps {self.pixels / elapsed:9.0f} px/s "
+              f"{self.packets / elapsed:7.0f} pkt/s {self.bytes * 8 / elapsed / 1e6:6.2f} Mbit/s errors: {self.errors}")
+        self.packets = self.bytes = self.frames = self.pixels = 0
+
+
+def check_ddp(st, data):
+    if len(data) < 10:
+        return st.error("DDP packet too short")
+    flags, seq, dtype, did, offset, length = struct.unpack(">BBBBIH", data[:10])
+    if flags & 0xC0 != 0x40:
+        st.error(f"DDP bad version flags 0x{flags:02x}")
+    if DDP_TYPES.get(dtype) != st.channels:
+        st.error(f"DDP data type 0x{dtype:02x} does not match {st.channels} channels")
+    if did != 1:
+        st.error(f"DDP destination id {did} is not display")
+    if length != len(data) - 10:
+        st.error(f"DDP length {length} does not match payload {len(data) - 10}")
+    if not 1 <= seq & 0x0F <= 15:
+        st.error(f"DDP sequence {seq} out of range")
+    if offset == 0:
+        if st.frame_channels:
+            st.error("DDP frame without push flag")
+            st.frame_channels = 0
+        st.seq = seq
+    elif offset != st.next_offset:
+        st.error(f"DDP offset {offset}, expected {st.next_offset} (lost packet?)")
+    elif seq != st.seq:
+        st.error(f"DDP sequence changed within frame ({st.seq} -> {seq})")
+    st.frame_channels += length
+    st.next_offset = offset + length
+    if flags & 0x01:  # push
+        st.end_frame()
+
+
+def check_dmx_frame(st, seq, universe, first_universe, channels):
+    if universe == first_universe:
+        st.end_frame()
+        st.seq = seq
+    elif universe != st.next_offset:
+        st.error(f"universe {universe}, expected {st.next_offset} (lost packet?)")
+    elif seq != st.seq:
+        st.error(f"sequence changed within frame ({st.seq} -> {seq})")
+    st.frame_channels += channels
+    st.next_offset = universe + 1
+
+
+def check_e131(st, data):
+    if len(data) < 126:
+        return st.error("E1.31 packet too short")
+    if data[:16] != ACN_ID:
+        return st.error("E1.31 bad ACN packet identifier")
+    for offset, name in ((16, "root"), (38, "framing"), (115, "DMP")):
+        flength = struct.unpack(">H", data[offset:offset + 2])[0]
+        if flength != 0x7000 | (len(data) - offset):
+            st.error(f"E1.31 {name} layer flags/length 0x{flength:04x} does not match packet length {len(data)}")
+    if struct.unpack(">I", data[18:22])[0] != 4 or struct.unpack(">I", data[40:44])[0] != 2 or data[117] != 2 or data[118] != 0xA1:
+        st.error("E1.31 bad vector or address type")
+    count = struct.unpack(">H", data[123:125])[0]
+    if count != len(data) - 125:
+        st.error(f"E1.31 property count {count} does not match payload {len(data) - 125}")
+    if data[125] != 0:
+        st.error(f"E1.31 start code {data[125]} is not 0")
+    universe = struct.unpack(">H", data[113:115])[0]
+    check_dmx_frame(st, data[111], universe, 1, len(data) - 126)
+
+
+def check_artnet(st, data):
+    if len(data) < 18:
+        return st.error("Art-Net packet too short")
+    if data[:8] != ARTNET_ID or data[8:10] != b"\x00\x50" or data[10:12] != b"\x00\x0e":
+        return st.error("Art-Net bad ID, opcode or version")
+    length = struct.unpack(">H", data[16:18])[0]
+    if length != len(data) - 18 or length > 512:
+        st.error(f"Art-Net length {length} does not match payload {len(data) - 18}")
+    if length & 1:
+        st.error(f"Art-Net length {length} is odd")
+    if data[12] == 0:
+        st.error("Art-Net sequence 0 (disabled)")
+    universe = data[14] | data[15] << 8
+    check_dmx_frame(st, data[12], universe, 0, length)
+
+
+PROTOCOLS = {"ddp": (DDP_PORT, check_ddp), "e131": (E131_PORT, check_e131), "artnet": (ARTNET_PORT, check_artnet)}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--addr", default="127.0.0.1", help="address of first node (default 127.0.0.1)")
+    parser.add_argument("--nodes", type=int, default=1, help="number of nodes (consecutive addresses)")
+    parser.add_argument("--pixels", type=int, default=0, help="expected pixels per frame per node (0 = don't check)")
+    parser.add_argument("--rgbw", action="store_true", help="expect 4 channels per pixel")
+    parser.add_argument("--protocol", choices=["all", *PROTOCOLS], default="all")
+    parser.add_argument("--duration", type=float, default=0, help="stop after given number of seconds")
+    args = parser.parse_args()
+
+    channels = 4 if args.rgbw else 3
+    first = ipaddress.ip_address(args.addr)
+    sockets = {}
+    for proto, (port, check) in PROTOCOLS.items():
+        if args.protocol not in ("all", proto):
+            continue
+        for n in range(args.nodes):
+            addr = str(first + n)
+            sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+            sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 4 << 20)
+            sock.bind((addr, port))
+            sockets[sock] = (check, NodeStats(f"{addr} {proto:6}", args.pixels, channels))
+
+    print(f"listening on {len(sockets)} sockets")
+    start = last = time.monotonic()
+    while not args.duration or time.monotonic() - start < args.duration:
+        ready, _, _ = select.select(list(sockets), [], [], 0.1)
+        for sock in ready:
+            data = sock.recv(2048)
+            check, st = sockets[sock]
+            st.packets += 1
+            st.bytes += len(data)
+            check(st, data)
+        now = time.monotonic()
+        if now - last >= 1:
+            for _, st in sockets.values():
+                if st.packets or st.errors:
+                    st.report(now - last)
+            last = now
+    errors = sum(st.errors for _, st in sockets.values())
+    print(f"total errors: {errors}")
+    return 1 if errors else 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -0,0 +1,436 @@
+#!/usr/bin/env python3
+"""
+Test harness for the WLED binary WebSocket control protocol (see wled00/ws.cpp).
+
+Sends a stream of segment commands (effect parameters, colors, brightness) over /ws, keeping up to --window
+commands in flight, and reports commands/s and acknowledgment latency. --json sends the equivalent JSON API
+commands for comparison, --subscribe additionally decodes the binary state pushes. --stream streams pixel frames
+into a segment, paced by the device's frame acknowledgments, and reports frames/s shown and dropped.
+
+Against a device:
+    python3 ws_binary_test.py --host 192.168.1.50 --count 2000
+    python3 ws_binary_test.py --host 192.168.1.50 --count 2000 --json
+    python3 ws_binary_test.py --host 192.168.1.50 --stream 2000 --fps 30 --seconds 10 --segment 0
+Loopback (built-in reference server on 127.0.0.1, checks the harness and protocol framing without a device):
+    python3 ws_binary_test.py --loopback --count 20000
+"""
+import argparse
+import base64
+import hashlib
+import json
+import os
+import socket
+import struct
+import threading
+import time
+
+WS_GUID = b"258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+OP_TEXT, OP_BINARY, OP_CLOSE, OP_PING, OP_PONG = 0x1, 0x2, 0x8, 0x9, 0xA
+
+ERR_NONE, ERR_CONCURRENCY, ERR_NOT_IMPL, ERR_NORAM, ERR_JSON = 0, 2, 4, 8, 9
+SEG_FIELDS = ["on", "bri", "fx", "sx", "ix", "pal", "c1", "c2", "c3"]
+STATE_FIELDS = ["on", "bri", "ps", "mainseg"]
+
+
+# --- protocol -------------------------------------------------------------------------------------------------------
+
+def cmd_bri(bri):
+    return struct.pack("<cB", b"b", bri)
+
+
+def cmd_on(on):
+    return struct.pack("<cB", b"o", on)
+
+
+def cmd_preset(ps):
+    return struct.pack("<cB", b"v", ps)
+
+
+def cmd_color(seg, slot, r, g, b, w=0):
+    return struct.pack("<cBBBBBB", b"c", seg, slot, r, g, b, w)
+
+
+def cmd_fx(seg, fx):
+    return struct.pack("<cBB", b"f", seg, fx)
+
+
+def cmd_params(seg, sx=None, ix=None, pal=None, c1=None, c2=None, c3=None, opacity=None, on=None):
+    mask, values = 0, []
+    for bit, v in enumerate((sx, ix, pal, c1, c2, c3, opacity, on)):
+        if v is not None:
+            mask |= 1 << bit
+            values.append(int(v))
+    return struct.pack("<cBB", b"p", seg, mask) + bytes(values)
+
+
+def cmd_pixels(start, data, rgbw=False):
+    stride = 4 if rgbw else 3
+    return struct.pack("<cBHH", b"r", 1 if rgbw else 0, start, len(data) // stride) + bytes(data)
+
+
+def cmd_stream(seg, frame, offset, data, rgbw=False, last=False):
+    stride = 4 if rgbw else 3
+    flags = (1 if rgbw else 0) | (2 if last else 0)
+    return struct.pack("<cBBBHH", b"d", seg, flags, frame & 0xFF, offset, len(data) // stride) + bytes(data)
+
+
+def cmd_subscribe(on=True):
+    return struct.pack("<cB", b"s", 1 if on else 0)
+
+
+def message(seq, *cmds):
+    return bytes([seq & 0xFF]) + b"".join(cmds)
+
+
+def decode_state(msg, state):
+    """Applies a binary state push ('S') to the dict state, returns the list of changed keys."""
+    if msg[1] != 1:
+        raise ValueError(f"unknown state version {msg[1]}")
+    changed, mask, pos = [], msg[2], 3
+    for bit, name in enumerate(STATE_FIELDS):
+        if mask & (1 << bit):
+            state[name] = msg[pos]
+            changed.append(name)
+            pos += 1
+    segs = state.setdefault("seg", {})
+    while pos < len(msg):
+        sid, smask = msg[pos], msg[pos + 1] | (msg[pos + 2] << 8)
+        pos += 3
+        if smask & 0x8000:
+            segs.pop(sid, None)
+            changed.append(f"seg{sid}.removed")
+            continue
+        seg = segs.setdefault(sid, {})
+        for bit, name in enumerate(SEG_FIELDS):
+            if smask & (1 << bit):
+                seg[name] = msg[pos]
+                changed.append(f"seg{sid}.{name}")
+                pos += 1
+        for c in range(3):
+            if smask & (1 << (9 + c)):
+                seg[f"col{c}"] = tuple(msg[pos:pos + 4])
+                changed.append(f"seg{sid}.col{c}")
+                pos += 4
+        if smask & (1 << 12):
+            seg["bounds"] = struct.unpack_from("<4H", msg, pos)
+            changed.append(f"seg{sid}.bounds")
+            pos += 8
+    return changed
+
+
+# --- minimal WebSocket framing ----------------------------------------------------------------------------------------
+
+def recv_exact(sock, n):
+    buf = b""
+    while len(buf) < n:
+        chunk = sock.recv(n - len(buf))
+        if not chunk:
+            raise ConnectionError("connection closed")
+        buf += chunk
+    return buf
+
+
+def read_frame(sock):
+    b0, b1 = recv_exact(sock, 2)
+    n = b1 & 0x7F
+    if n == 126:
+        n = struct.unpack(">H", recv_exact(sock, 2))[0]
+    elif n == 127:
+        n = struct.unpack(">Q", recv_exact(sock, 8))[0]
+    mask = recv_exact(sock, 4) if b1 & 0x80 else None
+    data = recv_exact(sock, n)
+    if mask:
+        data = bytes(c ^ mask[i % 4] for i, c in enumerate(data))
+    return b0 & 0x0F, data
+
+
+def write_frame(sock, opcode, data, masked):
+    header = bytearray([0x80 | opcode])
+    n = len(data)
+    flag = 0x80 if masked else 0
+    if n < 126:
+        header.append(flag | n)
+    elif n < 65536:
+        header += struct.pack(">BH", flag | 126, n)
+    else:
+        header += struct.pack(">BQ", flag | 127, n)
+    if masked:
+        mask = os.urandom(4)
+        header += mask
+        data = bytes(c ^ mask[i % 4] for i, c in enumerate(data))
+    sock.sendall(bytes(header) + data)
+
+
+class WsClient:
+    def __init__(self, host, port, path="/ws"):
+        self.sock = socket.create_connection((host, port), timeout=5)
+        self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        key = base64.b64encode(os.urandom(16)).decode()
+        self.sock.sendall((f"GET {path} HTTP/1.1\r\nHost: {host}\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                           f"Sec-WebSocket-Key: {key}\r\nSec-WebSocket-Version: 13\r\n\r\n").encode())
+        response = b""
+        while b"\r\n\r\n" not in response:
+            response += recv_exact(self.sock, 1)
+        if b" 101 " not in response.split(b"\r\n")[0]:
+            raise ConnectionError(response.split(b"\r\n")[0].decode())
+
+    def send(self, data):
+        write_frame(self.sock, OP_TEXT if isinstance(data, str) else OP_BINARY,
+                    data.encode() if isinstance(data, str) else data, True)
+
+    def recv(self):
+        while True:
+            opcode, data = read_frame(self.sock)
+            if opcode == OP_PING:
+                write_frame(self.sock, OP_PONG, data, True)
+            elif opcode == OP_CLOSE:
+                raise ConnectionError("closed by server")
+            else:
+                return opcode, data
+
+
+# --- loopback reference server ---------------------------------------------------------------------------------------
+
+CMD_LENGTHS = {ord("b"): 1, ord("o"): 1, ord("v"): 1, ord("c"): 6, ord("f"): 2, ord("s"): 1}
+PIXEL_CMDS = {ord("r"): (1, 0), ord("d"): (3, 1)}  # pixel data commands: header length before start and count u16, flags index
+
+
+def reference_status(msg):
+    """Validates a binary request the way the firmware parses it, returns its status code."""
+    pos = 1
+    while pos < len(msg):
+        cmd = msg[pos]
+        pos += 1
+        if cmd in CMD_LENGTHS:
+            n = CMD_LENGTHS[cmd]
+        elif cmd == ord("p"):
+            n = 2 + bin(msg[pos + 1]).count("1") if pos + 1 < len(msg) else 2
+        elif cmd in PIXEL_CMDS:
+            h, flags = PIXEL_CMDS[cmd]
+            if pos + h + 4 > len(msg):
+                return ERR_JSON
+            count = msg[pos + h + 2] | (msg[pos + h + 3] << 8)
+            n = h + 4 + count * (4 if msg[pos + flags] & 1 else 3)
+        else:
+            return ERR_NOT_IMPL
+        if pos + n > len(msg):
+            return ERR_JSON
+        pos += n
+    return ERR_NONE
+
+
+def loopback_server(listener):
+    conn, _ = listener.accept()
+    conn.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    request = b""
+    while b"\r\n\r\n" not in request:
+        request += recv_exact(conn, 1)
+    key = [l.split(b":", 1)[1].strip() for l in request.split(b"\r\n") if l.lower().startswith(b"sec-websocket-key")][0]
+    accept = base64.b64encode(hashlib.sha1(key + WS_GUID).digest())
+    conn.sendall(b"HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                 b"Sec-WebSocket-Accept: " + accept + b"\r\n\r\n")
+    try:
+        while True:
+            opcode, data = read_frame(conn)
+            if opcode == OP_CLOSE:
+                break
+            if opcode == OP_BINARY and data:
+                status = reference_status(data)
+                if status != ERR_NONE or data[1] != ord("d"):
+                    write_frame(conn, OP_BINARY, bytes([ord("A"), data[0], status]), False)
+                elif data[3] & 2:  # last chunk of a frame, one command per message assumed
+                    write_frame(conn, OP_BINARY, bytes([ord("F"), data[4], 0, 2]), False)
+            elif opcode == OP_TEXT:
+                write_frame(conn, OP_TEXT, b'{"success":true}', False)
+    except ConnectionError:
+        pass
+    conn.close()
+
+
+# --- benchmark ---------------------------------------------------------------------------------------------------------
+
+def make_command(i, use_json, segments):
+    seg = i % segments
+    kind = i % 4
+    if use_json:
+        if kind == 0:
+            return json.dumps({"seg": {"id": seg, "sx": i % 256, "ix": (i * 7) % 256}})
+        if kind == 1:
+            return json.dumps({"seg": {"id": seg, "col": [[i % 256, 255 - i % 256, 0]]}})
+        if kind == 2:
+            return json.dumps({"bri": 1 + i % 255})
+        return json.dumps({"seg": {"id": seg, "c1": i % 256, "pal": i % 10}})
+    if kind == 0:
+        return cmd_params(seg, sx=i % 256, ix=(i * 7) % 256)
+    if kind == 1:
+        return cmd_color(seg, 0, i % 256, 255 - i % 256, 0)
+    if kind == 2:
+        return cmd_bri(1 + i % 255)
+    return cmd_params(seg, c1=i % 256, pal=i % 10)
+
+
+def run(args):
+    ws = WsClient(args.host, args.port)
+    state, pushes, errors, latencies = {}, 0, 0, []
+    ws.sock.settimeout(None)
+    opcode, data = ws.recv()  # initial JSON state sent on connect
+    if args.subscribe and not args.json:
+        ws.send(message(0, cmd_subscribe(True)))
+        while True:  # the full state push may precede the acknowledgment
+            opcode, data = ws.recv()
+            if opcode == OP_BINARY and data[:1] == b"S":
+                pushes += 1
+                decode_state(data, state)
+            elif opcode == OP_BINARY and data[:1] == b"A":
+                break
+
+    sent, acked, in_flight = 0, 0, {}
+    start = time.perf_counter()
+    while acked < args.count:
+        while sent < args.count and len(in_flight) < args.window:
+            seq = sent & 0xFF
+            cmd = make_command(sent, args.json, args.segments)
+            in_flight[seq] = time.perf_counter()
+            ws.send(cmd if args.json else message(seq, cmd))
+            sent += 1
+        opcode, data = ws.recv()
+        if opcode == OP_BINARY and data[:1] == b"S":
+            pushes += 1
+            changed = decode_state(data, state)
+            if args.verbose:
+                print("state:", ", ".join(changed))
+            continue
+        if opcode == OP_BINARY and data[:1] == b"A":
+            t0 = in_flight.pop(data[1], None)
+            if data[2] != ERR_NONE:
+                errors += 1
+        elif opcode == OP_TEXT and not args.json:
+            continue  # JSON broadcast to a non-subscribed binary client
+        else:
+            if b'"error"' in data:
+                errors += 1
+            t0 = in_flight.pop(min(in_flight, key=in_flight.get)) if in_flight else None  # JSON replies are in order
+        if t0 is not None:
+            latencies.append(time.perf_counter() - t0)
+        acked += 1
+    elapsed = time.perf_counter() - start
+
+    latencies.sort()
+    p = lambda q: latencies[min(len(latencies) - 1, int(q * len(latencies)))] * 1000 if latencies else 0
+    print(f"{'JSON' if args.json else 'binary'}: {acked} commands in {elapsed:.2f}s = {acked / elapsed:.0f} cmd/s, "
+          f"latency p50 {p(0.5):.1f}ms p99 {p(0.99):.1f}ms, errors {errors}, state pushes {pushes}")
+    if args.subscribe and state:
+        print("last state:", {k: v for k, v in state.items() if k != "seg"}, f"{len(state.get('seg', {}))} segments")
+    return errors == 0
+
+
+def run_stream(args):
+    ws = WsClient(args.host, args.port)
+    ws.sock.settimeout(None)
+    ws.recv()  # initial JSON state sent on connect
+    ws.sock.settimeout(5)  # a frame acknowledgment never arrives if the device stopped streaming (e.g. realtime override)
+    stride = 4 if args.rgbw else 3
+    per_chunk = max(1, (args.chunk - 8) // stride)
+    credits, unacked, frame, shown, dropped, errors = 2, {}, 0, 0, 0, 0
+    latencies = []
+    interval = 1.0 / args.fps if args.fps else 0
+    start = next_frame = time.perf_counter()
+    while time.perf_counter() - start < args.seconds or unacked:
+        now = time.perf_counter()
+        if time.perf_counter() - start < args.seconds and len(unacked) < credits and now >= next_frame:
+            # moving gradient so frames differ
+            pixels = bytearray()
+            for i in range(args.stream):
+                v = (i * 4 + frame * 8) & 0xFF
+                pixels += bytes((v, 255 - v, (v * 2) & 0xFF, 0)[:stride])
+            for offset in range(0, args.stream, per_chunk):
+                n = min(per_chunk, args.stream - offset)
+                last = offset + n >= args.stream
+                ws.send(message(frame, cmd_stream(args.segment, frame, offset,
+                                                  pixels[offset * stride:(offset + n) * stride], args.rgbw, last)))
+            unacked[frame & 0xFF] = now
+            frame += 1
+            next_frame = max(next_frame + interval, now) if interval else now
+            continue
+        if not unacked:
+            time.sleep(max(0, next_frame - time.perf_counter()))
+            continue
+        try:
+            opcode, data = ws.recv()
+        except socket.timeout:
+            print(f"no acknowledgment for frames {list(unacked)}")
+            return False
+        if opcode != OP_BINARY:
+            continue
+        if data[:1] == b"F":
+            # earlier frames are acknowledged implicitly (dropped ones are only counted)
+            while unacked:
+                fid, t0 = next(iter(unacked.items()))
+                del unacked[fid]
+                if fid == data[1]:
+                    latencies.append(time.perf_counter() - t0)
+                    break
+            shown += 1
+            dropped += data[2]
+            credits = max(1, data[3])
+        elif data[:1] == b"A" and data[2] != ERR_NONE:
+            errors += 1
+            print(f"chunk of message {data[1]} rejected with status {data[2]}")
+            return False
+    elapsed = time.perf_counter() - start
+    latencies.sort()
+    p = lambda q: latencies[min(len(latencies) - 1, int(q * len(latencies)))] * 1000 if latencies else 0
+    print(f"stream: {args.stream} LEDs, {frame} frames sent, {shown} shown ({shown / elapsed:.1f} fps), {dropped} dropped, "
+          f"ack latency p50 {p(0.5):.1f}ms p99 {p(0.99):.1f}ms, errors {errors}")
+    return errors == 0
+
+
+def selftest():
+    # state decoder against a hand-encoded push: bri=40, seg 0 fx 9, seg 1 removed
+    msg = bytes([ord("S"), 1, 0x02, 40, 0, 0x04, 0x00, 9, 1, 0x00, 0x80])
+    state = {"seg": {1: {}}}
+    assert decode_state(msg, state) == ["bri", "seg0.fx", "seg1.removed"] and state["seg"] == {0: {"fx": 9}}
+    assert reference_status(message(1, cmd_params(0, sx=1, on=1), cmd_pixels(0, bytes(30)))) == ERR_NONE
+    assert reference_status(message(1, cmd_color(0, 0, 1, 2, 3)[:-1])) == ERR_JSON
+    assert reference_status(message(1, b"z")) == ERR_NOT_IMPL
+    assert reference_status(message(1, cmd_stream(0, 1, 10, bytes(40), rgbw=True, last=True))) == ERR_NONE
+    assert reference_status(message(1, cmd_stream(0, 1, 10, bytes(30))[:-1])) == ERR_JSON
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=80)
+    parser.add_argument("--count", type=int, default=1000, help="commands to send")
+    parser.add_argument("--window", type=int, default=4, help="commands in flight (unacknowledged)")
+    parser.add_argument("--segments", type=int, default=1, help="cycle commands over this many segments")
+    parser.add_argument("--json", action="store_true", help="send JSON API commands instead")
+    parser.add_argument("--subscribe", action="store_true", help="subscribe to binary state pushes")
+    parser.add_argument("--stream", type=int, default=0, metavar="LEDS", help="stream frames of this many pixels")
+    parser.add_argument("--segment", type=int, default=0, help="segment receiving the stream")
+    parser.add_argument("--fps", type=float, default=30, help="stream frame rate limit (0: as fast as acknowledged)")
+    parser.add_argument("--seconds", type=float, default=10, help="stream duration")
+    parser.add_argument("--chunk", type=int, default=1400, help="max. stream message size (device limit 4096/16384)")
+    parser.add_argument("--rgbw", action="store_true", help="stream RGBW pixels")
+    parser.add_argument("--loopback", action="store_true", help="run against the built-in reference server")
+    parser.add_argument("--verbose", action="store_true")
+    args = parser.parse_args()
+
+    selftest()
+    if args.loopback:
+        listener = socket.socket()
+        listener.bind(("127.0.0.1", 0))
+        listener.listen(1)
+        args.host, args.port = "127.0.0.1", listener.getsockname()[1]
+        threading.Thread(target=loopback_server, args=(listener,), daemon=True).start()
+        # the reference server does not send the initial state, feed the client one
+        original_recv = WsClient.recv
+        first = [True]
+
+        def recv_with_initial(self):
+            if first[0]:
+                first[0] = False
+                return OP_TEXT, b"{}"
+            return original_recv(self)
+        WsClient.recv = recv_with_initial
+    raise SystemExit(0 if (run_stream(args) if args.stream else run(args)) else 1)
@@ -105,6 +105,32 @@ int8_t tristate_square8(uint8_t x, uint8_t pulsewidth, uint8_t attdec) {
   return 0;
 }
 
+// renders len (default: all SEGLEN) pixels in short runs using Segment::writeSpan() instead of setPixelColor() for each pixel
+// colorAt(i) returns new color of pixel i and is called in pixel order
+#define SPAN_CHUNK 32
+template<typename ColorAt> static void renderSpans(ColorAt colorAt, unsigned len = SEGLEN) {
+  uint32_t span[SPAN_CHUNK];
+  for (unsigned i = 0; i < len; i += SPAN_CHUNK) {
+    const unsigned n = std::min(len - i, unsigned(SPAN_CHUNK));
+    for (unsigned k = 0; k < n; k++) span[k] = colorAt(i + k);
+    SEGMENT.writeSpan(i, span, n);
+  }
+}
+
+// same as renderSpans() but blends new colors into existing ones (blendPixelColor() for each pixel)
+template<typename ColorAt> static void blendSpans(ColorAt colorAt, uint8_t blend) {
+  uint32_t span[SPAN_CHUNK];
+  const unsigned len = SEGLEN;
+  // arc, corner & pinwheel expansion draw shapes that overlap the pixel read for the next index: one pixel at a time
+  const unsigned chunk = (SEGMENT.is2D() && SEGMENT.map1D2D > M12_pBar) ? 1 : SPAN_CHUNK;
+  for (unsigned i = 0; i < len; i += chunk) {
+    const unsigned n = std::min(len - i, chunk);
+    SEGMENT.readSpan(i, span, n);
+    for (unsigned k = 0; k < n; k++) span[k] = color_blend(span[k], colorAt(i + k), blend);
+    SEGMENT.writeSpan(i, span, n);
+  }
+}
+
 static um_data_t* getAudioData() {
   um_data_t *um_data;
   if (!UsermodManager::getUMData(&um_data, USERMOD_ID_AUDIOREACTIVE)) {
@@ -534,11 +560,11 @@ uint16_t mode_rainbow_cycle(void) {
   unsigned counter = (strip.now * ((SEGMENT.speed >> 2) +2)) & 0xFFFF;
   counter = counter >> 8;
 
-  for (unsigned i = 0; i < SEGLEN; i++) {
-    //intensity/29 = 0 (1/16) 1 (1/8) 2 (1/4) 3 (1/2) 4 (1) 5 (2) 6 (4) 7 (8) 8 (16)
-    uint8_t index = (i * (16 << (SEGMENT.intensity /29)) / SEGLEN) + counter;
-    SEGMENT.setPixelColor(i, SEGMENT.color_wheel(index));
-  }
+  const unsigned size = 16 << (SEGMENT.intensity /29); //intensity/29 = 0 (1/16) 1 (1/8) 2 (1/4) 3 (1/2) 4 (1) 5 (2) 6 (4) 7 (8) 8 (16)
+  renderSpans([&](unsigned i) {
+    uint8_t index = (i * size / SEGLEN) + counter;
+    return SEGMENT.color_wheel(index);
+  });
 
   return FRAMETIME;
 }
@@ -1951,7 +1977,7 @@ uint16_t mode_colorwaves_pride_base(bool isPride2015) {
   sHue16 += duration * beatsin88_t(400, 5, 9);
   unsigned brightnesstheta16 = sPseudotime;
 
-  for (unsigned i = 0; i < SEGLEN; i++) {
+  const auto newColor = [&](unsigned i) -> uint32_t {
     hue16 += hueinc16;
     uint8_t hue8;
 
@@ -1970,12 +1996,11 @@ uint16_t mode_colorwaves_pride_base(bool isPride2015) {
 
     if (isPride2015) {
       CRGBW newcolor = CRGB(CHSV(hue8, sat8, bri8));
-      newcolor.color32 = gamma32inv(newcolor.color32);
-      SEGMENT.blendPixelColor(i, newcolor, 64);
-    } else {
-      SEGMENT.blendPixelColor(i, SEGMENT.color_from_palette(hue8, false, PALETTE_SOLID_WRAP, 0, bri8), 128);
+      return gamma32inv(newcolor.color32);
     }
-  }
+    return SEGMENT.color_from_palette(hue8, false, PALETTE_SOLID_WRAP, 0, bri8);
+  };
+  blendSpans(newColor, isPride2015 ? 64 : 128);
 
   SEGENV.step = sPseudotime;
   SEGENV.aux0 = sHue16;
@@ -2081,7 +2106,7 @@ uint16_t mode_palette() {
   for (int y = yFrom; y <= yTo; ++y) {
     // translate, scale, rotate
     const mathType ytCosTheta = mathType((wideMathType(cosTheta) * wideMathType(y * sInt16Scale - centerY * maxYIn))/wideMathType(maxYIn * scale));
-    for (int x = 0; x < cols; ++x) {
+    const auto colorAt = [&](int x) -> uint32_t {
       // translate, scale, rotate
       const mathType xtSinTheta = mathType((wideMathType(sinTheta) * wideMathType(x * sInt16Scale - centerX * maxXIn))/wideMathType(maxXIn * scale));
       // Map the pixel coordinate to an imaginary-rectangle-coordinate.
@@ -2105,12 +2130,12 @@ uint16_t mode_palette() {
       // Finally, shift the palette a bit.
       const int paletteOffset = (!inputAnimateShift) ? (inputShift) : (((strip.now * ((inputShift >> 3) +1)) & 0xFFFF) >> 8);
       colorIndex -= paletteOffset;
-      const uint32_t color = SEGMENT.color_wheel((uint8_t)colorIndex);
-      if (isMatrix) {
-        SEGMENT.setPixelColorXY(x, y, color);
-      } else {
-        SEGMENT.setPixelColor(x, color);
-      }
+      return SEGMENT.color_wheel((uint8_t)colorIndex);
+    };
+    if (isMatrix) {
+      for (int x = 0; x < cols; ++x) SEGMENT.setPixelColorXY(x, y, colorAt(x));
+    } else {
+      renderSpans(colorAt, cols);
     }
   }
   return FRAMETIME;
@@ -2221,10 +2246,10 @@ static const char _data_FX_MODE_BPM[] PROGMEM = "Bpm@!;!;!;;sx=64";
 
 uint16_t mode_fillnoise8() {
   if (SEGENV.call == 0) SEGENV.step = hw_random();
-  for (unsigned i = 0; i < SEGLEN; i++) {
+  renderSpans([](unsigned i) {
     unsigned index = perlin8(i * SEGLEN, SEGENV.step + i * SEGLEN);
-    SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0));
-  }
+    return SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0);
+  });
   SEGENV.step += beatsin8_t(SEGMENT.speed, 1, 6); //10,1,4
 
   return FRAMETIME;
@@ -2236,17 +2261,17 @@ uint16_t mode_noise16_1() {
   unsigned scale = 320;                                       // the "zoom factor" for the noise
   SEGENV.step += (1 + SEGMENT.speed/16);
 
-  for (unsigned i = 0; i < SEGLEN; i++) {
-    unsigned shift_x = beatsin8_t(11);                          // the x position of the noise field swings @ 17 bpm
-    unsigned shift_y = SEGENV.step/42;                        // the y position becomes slowly incremented
+  const unsigned shift_x = beatsin8_t(11);                    // the x position of the noise field swings @ 17 bpm
+  const unsigned shift_y = SEGENV.step/42;                  // the y position becomes slowly incremented
+  renderSpans([&](unsigned i) {
     unsigned real_x = (i + shift_x) * scale;                  // the x position of the noise field swings @ 17 bpm
     unsigned real_y = (i + shift_y) * scale;                  // the y position becomes slowly incremented
     uint32_t real_z = SEGENV.step;                            // the z position becomes quickly incremented
     unsigned noise = perlin16(real_x, real_y, real_z) >> 8;   // get the noise data and scale it down
     unsigned index = sin8_t(noise * 3);                         // map LED color based on noise data
 
-    SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0));
-  }
+    return SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0);
+  });
 
   return FRAMETIME;
 }
@@ -2257,14 +2282,14 @@ uint16_t mode_noise16_2() {
   unsigned scale = 1000;                                        // the "zoom factor" for the noise
   SEGENV.step += (1 + (SEGMENT.speed >> 1));
 
-  for (unsigned i = 0; i < SEGLEN; i++) {
-    unsigned shift_x = SEGENV.step >> 6;                        // x as a function of time
+  const unsigned shift_x = SEGENV.step >> 6;                  // x as a function of time
+  renderSpans([&](unsigned i) {
     uint32_t real_x = (i + shift_x) * scale;                    // calculate the coordinates within the noise field
     unsigned noise = perlin16(real_x, 0, 4223) >> 8;            // get the noise data and scale it down
     unsigned index = sin8_t(noise * 3);                           // map led color based on noise data
 
-    SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0, noise));
-  }
+    return SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0, noise);
+  });
 
   return FRAMETIME;
 }
@@ -2275,7 +2300,7 @@ uint16_t mode_noise16_3() {
   unsigned scale = 800;                                       // the "zoom factor" for the noise
   SEGENV.step += (1 + SEGMENT.speed);
 
-  for (unsigned i = 0; i < SEGLEN; i++) {
+  renderSpans([&](unsigned i) {
     unsigned shift_x = 4223;                                  // no movement along x and y
     unsigned shift_y = 1234;
     uint32_t real_x = (i + shift_x) * scale;                  // calculate the coordinates within the noise field
@@ -2284,8 +2309,8 @@ uint16_t mode_noise16_3() {
     unsigned noise = perlin16(real_x, real_y, real_z) >> 8;   // get the noise data and scale it down
     unsigned index = sin8_t(noise * 3);                         // map led color based on noise data
 
-    SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0, noise));
-  }
+    return SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0, noise);
+  });
 
   return FRAMETIME;
 }
@@ -2295,10 +2320,10 @@ static const char _data_FX_MODE_NOISE16_3[] PROGMEM = "Noise 3@!;!;!;;pal=35";
 //https://github.com/aykevl/ledstrip-spark/blob/master/ledstrip.ino
 uint16_t mode_noise16_4() {
   uint32_t stp = (strip.now * SEGMENT.speed) >> 7;
-  for (unsigned i = 0; i < SEGLEN; i++) {
+  renderSpans([stp](unsigned i) {
     int index = perlin16(uint32_t(i) << 12, stp);
-    SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0));
-  }
+    return SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0);
+  });
   return FRAMETIME;
 }
 static const char _data_FX_MODE_NOISE16_4[] PROGMEM = "Noise 4@!;!;!;;pal=26";
@@ -4228,10 +4253,10 @@ uint16_t mode_noisepal(void) {                                    // Slow noise
 
   if (SEGMENT.palette > 0) palettes[0] = SEGPALETTE;
 
-  for (unsigned i = 0; i < SEGLEN; i++) {
+  renderSpans([&](unsigned i) {
     unsigned index = perlin8(i*scale, SEGENV.aux0+i*scale);                // Get a value from the noise function. I'm using both x and y axis.
-    SEGMENT.setPixelColor(i,  ColorFromPalette(palettes[0], index, 255, LINEARBLEND));  // Use my own palette.
-  }
+    return ColorFromPalette(palettes[0], index, 255, LINEARBLEND);          // Use my own palette.
+  });
 
   SEGENV.aux0 += beatsin8_t(10,1,4);                                        // Moving along the distance. Vary it a bit with a sine wave.
 
@@ -10627,6 +10652,24 @@ static const char _data_RESERVED[] PROGMEM = "RSVD";
 // use id==255 to find unallocated gaps (with "Reserved" data string)
 // if vector size() is smaller than id (single) data is appended at the end (regardless of id)
 // return the actual id used for the effect or 255 if the add failed.
+#ifdef WLED_PARALLEL_RENDER
+// effects must be rendered by Arduino loop if they use shared state: audio reactive effects (metadata flags 'v' or 'f')
+// read usermod data, copy reads other segments and usermod effects are unknown
+// effects reseeding the global random16() PRNG rely on a repeatable sequence that the other core would interleave with
+static bool isMainCoreEffect(const char *mode_name, bool builtin) {
+  if (!builtin || mode_name == _data_FX_MODE_COPY) return true;
+  if (mode_name == _data_FX_MODE_RANDOM_CHASE || mode_name == _data_FX_MODE_TWINKLEUP) return true;
+  #ifndef WLED_DISABLE_2D
+  if (mode_name == _data_FX_MODE_2DCRAZYBEES) return true;
+  #endif
+  const char *p = strchr_P(mode_name, '@');
+  for (int field = 0; field < 3 && p; field++) p = strchr_P(p + 1, ';'); // flags are 4th field
+  if (!p) return false;
+  for (p++; pgm_read_byte(p) && pgm_read_byte(p) != ';'; p++) if (pgm_read_byte(p) == 'v' || pgm_read_byte(p) == 'f') return true;
+  return false;
+}
+#endif
+
 uint8_t WS2812FX::addEffect(uint8_t id, mode_ptr mode_fn, const char *mode_name) {
   if (id == 255) { // find empty slot
     for (size_t i=1; i<_mode.size(); i++) if (_modeData[i] == _data_RESERVED) { id = i; break; }
@@ -10635,10 +10678,16 @@ uint8_t WS2812FX::addEffect(uint8_t id, mode_ptr mode_fn, const char *mode_name)
     if (_modeData[id] != _data_RESERVED) return 255; // do not overwrite an already added effect
     _mode[id]     = mode_fn;
     _modeData[id] = mode_name;
+    #ifdef WLED_PARALLEL_RENDER
+    _modeMainCore[id] = isMainCoreEffect(mode_name, _addingBuiltinFX);
+    #endif
     return id;
   } else if (_mode.size() < 255) { // 255 is reserved for indicating the effect wasn't added
     _mode.push_back(mode_fn);
     _modeData.push_back(mode_name);
+    #ifdef WLED_PARALLEL_RENDER
+    _modeMainCore.push_back(isMainCoreEffect(mode_name, _addingBuiltinFX));
+    #endif
     if (_modeCount < _mode.size()) _modeCount++;
     return _mode.size() - 1;
   } else {
@@ -10655,6 +10704,10 @@ void WS2812FX::setupEffectData() {
     _mode.push_back(&mode_static);
     _modeData.push_back(_data_RESERVED);
   }
+  #ifdef WLED_PARALLEL_RENDER
+  _modeMainCore.assign(_modeCount, false);
+  _addingBuiltinFX = true;
+  #endif
   // now replace all pre-allocated effects
   addEffect(FX_MODE_COPY, &mode_copy_segment, _data_FX_MODE_COPY);
   // --- 1D non-audio effects ---
@@ -10892,4 +10945,7 @@ addEffect(FX_MODE_PS1DSONICBOOM, &mode_particle1DsonicBoom, _data_FX_MODE_PS_SON
 addEffect(FX_MODE_PS1DSPRINGY, &mode_particleSpringy, _data_FX_MODE_PS_SPRINGY);
 #endif // WLED_DISABLE_PARTICLESYSTEM1D
 
+  #ifdef WLED_PARALLEL_RENDER
+  _addingBuiltinFX = false; // effects added later (usermods) are rendered by Arduino loop
+  #endif
 }
@@ -88,6 +88,44 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
 #endif
 #define FPS_CALC_SHIFT 7 // bit shift for fixed point math
 
+// adaptive frame rate governor (see WS2812FX::governFrameRate())
+#ifndef GOVERNOR_LOAD
+#define GOVERNOR_LOAD      75  // max. percentage of frame time spent rendering, rest is left to Arduino loop (network)
+#endif
+#define GOVERNOR_MAX_FRAMETIME 100 // governor will not go below 10 FPS
+#define GOVERNOR_RECOVERY  16  // frames with headroom needed before frame rate is raised again
+
+// frame profiler history (number of frames with per stage durations kept for /json/perf)
+#ifndef WLED_PERF_FRAMES
+  #ifdef ESP8266
+    #define WLED_PERF_FRAMES 16
+  #else
+    #define WLED_PERF_FRAMES 64
+  #endif
+#endif
+
+// optional render pipeline (-D WLED_PIPELINED_OUTPUT): frame output (gamma, ledmap, CCT, ABL & bus transmission) runs
+// in its own task on the second core while the next frame is rendered, only available on dual core ESP32
+#if defined(WLED_PIPELINED_OUTPUT) && (!defined(ARDUINO_ARCH_ESP32) || defined(CONFIG_FREERTOS_UNICORE))
+  #undef WLED_PIPELINED_OUTPUT
+#endif
+
+// optional parallel rendering (-D WLED_PARALLEL_RENDER): due segments are shared between the Arduino loop and a render
+// task on the second core, only available on dual core ESP32 (and host builds, see tools/bench/host/freertos_host.h)
+// state used by effect functions (current segment, draw dimensions, colors & palette) is kept per render task (core)
+#if defined(WLED_PARALLEL_RENDER) && !defined(WLED_HOST_BUILD) && (!defined(ARDUINO_ARCH_ESP32) || defined(CONFIG_FREERTOS_UNICORE))
+  #undef WLED_PARALLEL_RENDER
+#endif
+#ifdef WLED_PARALLEL_RENDER
+  #include <atomic>
+  #include <mutex>
+  #define WLED_RENDER_TASKS 2
+  #define RENDER_TASK_ID    xPortGetCoreID()  // render tasks are pinned to different cores
+#else
+  #define WLED_RENDER_TASKS 1
+  #define RENDER_TASK_ID    0
+#endif
+
 // heap memory limit for effects data, pixel buffers try to reserve it if PSRAM is available
 #ifdef ESP8266
   #define MAX_NUM_SEGMENTS  16
@@ -108,12 +146,15 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
 /* How much data bytes each segment should max allocate to leave enough space for other segments,
   assuming each segment uses the same amount of data. 256 for ESP8266, 640 for ESP32. */
 #define FAIR_DATA_PER_SEG (MAX_SEGMENT_DATA / MAX_NUM_SEGMENTS)
+#ifndef SEGMENT_DATA_ARENA
+  #define SEGMENT_DATA_ARENA (4*FAIR_DATA_PER_SEG) // effect data kept in arena, larger allocations spill to heap
+#endif
 
 #define MIN_SHOW_DELAY   (_frametime < 16 ? 8 : 15)
 
 #define NUM_COLORS       3 /* number of colors per segment */
-#define SEGMENT          (*strip._currentSegment)
-#define SEGENV           (*strip._currentSegment)
+#define SEGMENT          (*strip._currentSegment[RENDER_TASK_ID])
+#define SEGENV           (*strip._currentSegment[RENDER_TASK_ID])
 #define SEGCOLOR(x)      Segment::getCurrentColor(x)
 #define SEGPALETTE       Segment::getCurrentPalette()
 #define SEGLEN           Segment::vLength()
@@ -488,16 +529,22 @@ class Segment {
     };
 
     // static variables are use to speed up effect calculations by stashing common pre-calculated values
+    // (those set by beginDraw() exist once per render task, see WLED_PARALLEL_RENDER)
     static unsigned      _usedSegmentData;    // amount of data used by all segments
-    static unsigned      _vLength;            // 1D dimension used for current effect
-    static unsigned      _vWidth, _vHeight;   // 2D dimensions used for current effect
-    static uint32_t      _currentColors[NUM_COLORS]; // colors used for current effect (faster access from effect functions)
-    static CRGBPalette16 _currentPalette;     // palette used for current effect (includes transition, used in color_from_palette())
+    static unsigned      _vLength[WLED_RENDER_TASKS];            // 1D dimension used for current effect
+    static unsigned      _vWidth[WLED_RENDER_TASKS], _vHeight[WLED_RENDER_TASKS]; // 2D dimensions used for current effect
+    static uint32_t      _currentColors[WLED_RENDER_TASKS][NUM_COLORS]; // colors used for current effect (faster access from effect functions)
+    static CRGBPalette16 _currentPalette[WLED_RENDER_TASKS]; // palette used for current effect (includes transition, used in color_from_palette())
     static CRGBPalette16 _randomPalette;      // actual random palette
     static CRGBPalette16 _newRandomPalette;   // target random palette
     static uint16_t      _lastPaletteChange;  // last random palette change time (in seconds)
     static uint16_t      _nextPaletteBlend;   // next due time for random palette morph (in millis())
-    static bool          _modeBlend;          // mode/effect blending semaphore
+    static bool          _modeBlend[WLED_RENDER_TASKS]; // mode/effect blending semaphore
+  #ifdef WLED_PARALLEL_RENDER
+    static std::mutex    _dataLock;           // effects on both cores may (de)allocate data
+  #endif
+    static BufferArena   _pixelArena;         // frame buffer(s) and segment pixel buffers (PSRAM if available, 32 bit access only)
+    static BufferArena   _dataArena;          // effect data (DRAM preferred)
     // clipping rectangle used for blending
     static uint16_t      _clipStart, _clipStop;
     static uint8_t       _clipStartY, _clipStopY;
@@ -534,15 +581,44 @@ class Segment {
       }
     } *_t;
 
+    // compositing state (see WS2812FX::show()): segment is only re-blended into frame buffer if its contribution may have changed
+    mutable bool _dirty;                    // pixel buffer was modified since segment was last blended
+    mutable struct {
+      uint16_t start, stop, startY, stopY;  // footprint in frame buffer
+      uint16_t offset, options;
+      uint8_t  grouping, spacing, bri, cct, blendMode;
+      bool     valid      : 1;              // parameters are valid (cleared when segment is copied or moved)
+      bool     visible    : 1;              // segment was blended into frame buffer
+      bool     transition : 1;
+    } _blended;                             // parameters used when segment was last blended
+
+    // expansion of 1D virtual pixels to pixel buffer indices for M12_pArc, M12_pCorner & M12_sPinwheel, built on first use
+    // pixels of each virtual pixel are grouped by draw category (pinwheel rays skip pixels shared with an adjacent ray)
+    typedef struct GeometryMap {
+      uint16_t vWidth, vHeight;             // virtual dimensions and mapping the table was built for
+      uint8_t  mapping;
+      uint16_t vLength;                     // number of virtual pixels
+      size_t   size;                        // allocated size (including tables)
+      uint32_t *runs;                       // vLength*4+1 offsets into indices[], one run per virtual pixel and draw category
+      uint16_t *readIndex;                  // pixel buffer index used by getPixelColor() (0xFFFF: outside of segment)
+      uint16_t *indices;                    // pixel buffer indices
+    } GeometryMap;
+    mutable GeometryMap *_geomMap;
+    mutable bool _geomMapFailed;            // do not retry building map until geometry changes (not enough RAM)
+
   protected:
 
     inline static void     addUsedSegmentData(int len)     { Segment::_usedSegmentData += len; }
+    bool allocatePixels(bool clear);        // allocates render buffer for length() pixels from pixel arena (heap if arena is full)
+    inline void freePixels()                { _pixelArena.release(pixels); pixels = nullptr; }
 
-    inline uint32_t *getPixels() const                              { return pixels; }
-    inline void     setPixelColorRaw(unsigned i, uint32_t c) const  { pixels[i] = c; }
+    inline uint32_t *getPixels() const                              { _dirty = true; return pixels; } // caller may modify pixels
+    inline void     setPixelColorRaw(unsigned i, uint32_t c) const  { pixels[i] = c; _dirty = true; }
     inline uint32_t getPixelColorRaw(unsigned i) const              { return pixels[i]; };
+    inline const uint32_t *getPixelsRaw() const                     { return pixels; } // read only (used for blending)
+    template<typename ColorAt> void putSpan(int i, unsigned n, ColorAt colorAt) const; // see writeSpan()
   #ifndef WLED_DISABLE_2D
-    inline void     setPixelColorXYRaw(unsigned x, unsigned y, uint32_t c) const  { auto XY = [](unsigned X, unsigned Y){ return X + Y*Segment::vWidth(); }; pixels[XY(x,y)] = c; }
+    inline void     setPixelColorXYRaw(unsigned x, unsigned y, uint32_t c) const  { auto XY = [](unsigned X, unsigned Y){ return X + Y*Segment::vWidth(); }; pixels[XY(x,y)] = c; _dirty = true; }
     inline uint32_t getPixelColorXYRaw(unsigned x, unsigned y) const              { auto XY = [](unsigned X, unsigned Y){ return X + Y*Segment::vWidth(); }; return pixels[XY(x,y)]; };
   #endif
     void resetIfRequired();         // sets all SEGENV variables to 0 and clears data buffer
@@ -558,9 +634,20 @@ class Segment {
     inline uint16_t progress() const          { return isInTransition() ? _t->_progress : 0xFFFFU; } // relies on handleTransition()/updateTransitionProgress() to update progression variable
     inline Segment *getOldSegment() const     { return isInTransition() ? _t->_oldSegment : nullptr; }
 
-    inline static void modeBlend(bool blend)  { Segment::_modeBlend = blend; }
+    // compositing functions (see WS2812FX::compositeSegments())
+    inline bool isVisible() const             { return isActive() && (on || isInTransition()); } // segment is blended into frame buffer
+    inline void invalidateBlend() const       { _dirty = true; _blended.valid = false; }         // forces full recomposition of frame buffer
+    bool footprintChanged() const;          // segment appeared, disappeared or moved since last blend
+    bool needsBlend() const;                // segment's pixels or blending parameters changed since last blend
+    void setBlended() const;                // stores blending parameters, called after frame buffer composition
+
+    // geometry map functions (1D effects expanded on 2D segment)
+    const GeometryMap *getGeometryMap(int vW, int vH) const; // returns map for current geometry, builds it if needed (nullptr if not enough RAM)
+    void freeGeometryMap() const;
+
+    inline static void modeBlend(bool blend)  { Segment::_modeBlend[RENDER_TASK_ID] = blend; }
     inline static void setClippingRect(int startX, int stopX, int startY = 0, int stopY = 1) { _clipStart = startX; _clipStop = stopX; _clipStartY = startY; _clipStopY = stopY; };
-    inline static bool isPreviousMode()       { return Segment::_modeBlend; }    // needed for determining CCT/opacity during non-BLEND_STYLE_FADE transition
+    inline static bool isPreviousMode()       { return Segment::_modeBlend[RENDER_TASK_ID]; }    // needed for determining CCT/opacity during non-BLEND_STYLE_FADE transition
 
     static void handleRandomPalette();
 
@@ -600,11 +687,14 @@ class Segment {
     , _default_palette(6)
     , _capabilities(0)
     , _t(nullptr)
+    , _dirty(true)
+    , _blended{}
+    , _geomMap(nullptr)
+    , _geomMapFailed(false)
     {
       DEBUGFX_PRINTF_P(PSTR("-- Creating segment: %p [%d,%d:%d,%d]\n"), this, (int)start, (int)stop, (int)startY, (int)stopY);
-      // allocate render buffer (always entire segment), prefer PSRAM if DRAM is running low. Note: impact on FPS with PSRAM buffer is low (<2% with QSPI PSRAM)
-      pixels = static_cast<uint32_t*>(allocate_buffer(length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_CLEAR));
-      if (!pixels) {
+      // allocate render buffer (always entire segment) from pixel arena. Note: impact on FPS with PSRAM buffer is low (<2% with QSPI PSRAM)
+      if (!allocatePixels(true)) {
         DEBUGFX_PRINTLN(F("!!! Not enough RAM for pixel buffer !!!"));
         extern byte errorFlag;
         errorFlag = ERR_NORAM_PX;
@@ -625,16 +715,18 @@ class Segment {
       #endif
       clearName();
       deallocateData();
-      p_free(pixels);
+      freeGeometryMap();
+      freePixels();
     }
 
     Segment& operator= (const Segment &orig); // copy assignment
     Segment& operator= (Segment &&orig) noexcept; // move assignment
 
 #ifdef WLED_DEBUG
-    size_t getSize() const { return sizeof(Segment) + (data?_dataLen:0) + (name?strlen(name):0) + (_t?sizeof(Transition):0) + (pixels?length()*sizeof(uint32_t):0); }
+    size_t getSize() const { return sizeof(Segment) + (data?_dataLen:0) + (name?strlen(name):0) + (_t?sizeof(Transition):0) + (pixels?length()*sizeof(uint32_t):0) + getGeometryMapSize(); }
 #endif
 
+    inline size_t   getGeometryMapSize()   const { return _geomMap ? _geomMap->size : 0; } // RAM used by cached 1D->2D expansion
     inline bool     getOption(uint8_t n)   const { return ((options >> n) & 0x01); }
     inline bool     isSelected()           const { return selected; }
     inline bool     isInTransition()       const { return _t != nullptr; }
@@ -651,13 +743,16 @@ class Segment {
     inline Segment &clearName()                  { p_free(name); name = nullptr; return *this; }
     inline Segment &setName(const String &name)  { return setName(name.c_str()); }
 
-    inline static unsigned vLength()                       { return Segment::_vLength; }
-    inline static unsigned vWidth()                        { return Segment::_vWidth; }
-    inline static unsigned vHeight()                       { return Segment::_vHeight; }
-    inline static uint32_t getCurrentColor(unsigned i)     { return Segment::_currentColors[i<NUM_COLORS?i:0]; }
-    inline static const CRGBPalette16 &getCurrentPalette() { return Segment::_currentPalette; }
+    inline static unsigned vLength()                       { return Segment::_vLength[RENDER_TASK_ID]; }
+    inline static unsigned vWidth()                        { return Segment::_vWidth[RENDER_TASK_ID]; }
+    inline static unsigned vHeight()                       { return Segment::_vHeight[RENDER_TASK_ID]; }
+    inline static uint32_t getCurrentColor(unsigned i)     { return Segment::_currentColors[RENDER_TASK_ID][i<NUM_COLORS?i:0]; }
+    inline static const CRGBPalette16 &getCurrentPalette() { return Segment::_currentPalette[RENDER_TASK_ID]; }
 
-    inline void setDrawDimensions() const { Segment::_vWidth = virtualWidth(); Segment::_vHeight = virtualHeight(); Segment::_vLength = virtualLength(); }
+    inline void setDrawDimensions() const {
+      const unsigned task = RENDER_TASK_ID;
+      Segment::_vWidth[task] = virtualWidth(); Segment::_vHeight[task] = virtualHeight(); Segment::_vLength[task] = virtualLength();
+    }
 
     void    beginDraw(uint16_t prog = 0xFFFFU);         // set up parameters for current effect
     void    setGeometry(uint16_t i1, uint16_t i2, uint8_t grp=1, uint8_t spc=0, uint16_t ofs=UINT16_MAX, uint16_t i1Y=0, uint16_t i2Y=1, uint8_t m12=0);
@@ -672,9 +767,11 @@ class Segment {
 
     // runtime data functions
     inline uint16_t dataSize() const { return _dataLen; }
-    bool allocateData(size_t len);  // allocates effect data buffer in heap and clears it
-    void deallocateData();          // deallocates (frees) effect data buffer from heap
+    bool allocateData(size_t len);  // allocates effect data buffer from data arena (heap if arena is full) and clears it
+    void deallocateData();          // deallocates (frees) effect data buffer
     inline static unsigned getUsedSegmentData()            { return Segment::_usedSegmentData; }
+    inline static BufferArena::Stats getPixelArenaStats()  { return _pixelArena.getStats(); }
+    inline static BufferArena::Stats getDataArenaStats()   { return _dataArena.getStats(); }
     /**
       * Flags that before the next effect is calculated,
       * the internal segment state should be reset.
@@ -695,6 +792,9 @@ class Segment {
     inline void setPixelColor(int n, byte r, byte g, byte b, byte w = 0) const { setPixelColor(n, RGBW32(r,g,b,w)); }
     inline void setPixelColor(int n, CRGB c) const                             { setPixelColor(n, RGBW32(c.r,c.g,c.b,0)); }
     void setRawPixelColor(int i, uint32_t col) const                           { if (i >= 0 && i < length()) setPixelColorRaw(i,col); }
+    void writeSpan(int n, const uint32_t *c, unsigned len) const; // set len consecutive pixels starting at n (mapping is resolved once per span)
+    void fillSpan(int n, uint32_t c, unsigned len) const;          // set len consecutive pixels starting at n to the same color
+    void readSpan(int n, uint32_t *c, unsigned len) const;         // get len consecutive pixels starting at n
     #ifdef WLED_USE_AA_PIXELS
     void setPixelColor(float i, uint32_t c, bool aa = true) const;
     inline void setPixelColor(float i, uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0, bool aa = true) const { setPixelColor(i, RGBW32(r,g,b,w), aa); }
@@ -841,26 +941,56 @@ class WS2812FX {
 #endif
       correctWB(false),
       cctFromRgb(false),
+      fpsGovernor(false),
       // true private variables
       _pixels(nullptr),
       _pixelCCT(nullptr),
+#ifdef WLED_PIPELINED_OUTPUT
+      _outPixels(nullptr),
+      _outCCT(nullptr),
+      _outGamma(true),
+      _outputTask(nullptr),
+      _outputIdle(nullptr),
+      _outProfile{},
+#endif
+      _stageTimes{0, 0, 0, 0},
+      _frameProfile{},
+      _frameLog{},
+      _frameCount(0),
+      _segmentTime{0},
+      _effectCost(nullptr),
+      _effectCostCount(0),
       _suspend(false),
       _brightness(DEFAULT_BRIGHTNESS),
       _length(DEFAULT_LED_COUNT),
       _transitionDur(750),
       _frametime(FRAMETIME_FIXED),
+      _governedFrametime(FRAMETIME_FIXED),
+      _governorHeadroom(0),
       _cumulativeFps(WLED_FPS << FPS_CALC_SHIFT),
       _targetFps(WLED_FPS),
       _isServicing(false),
       _isOffRefreshRequired(false),
       _hasWhiteChannel(false),
       _triggered(false),
-      _segment_index(0),
+      _frameValid(false),
+      _segment_index{0},
+#ifdef WLED_PARALLEL_RENDER
+      _numParallelJobs(0),
+      _nextParallelJob(0),
+      _addingBuiltinFX(false),
+      _renderTask(nullptr),
+      _renderDone(nullptr),
+#endif
       _mainSegment(0),
+      _compositedSegments(0),
+      _compositedPixels(0),
       _modeCount(MODE_COUNT),
       _callback(nullptr),
       customMappingTable(nullptr),
       customMappingSize(0),
+      _ledmapRuns(nullptr),
+      _ledmapRunCount(0),
       _lastShow(0),
       _lastServiceShow(0)
     {
@@ -871,9 +1001,26 @@ class WS2812FX {
     }
 
     ~WS2812FX() {
-      p_free(_pixels);
+#ifdef WLED_PIPELINED_OUTPUT
+      if (_outputTask) {
+        waitForOutput();
+        vTaskDelete(_outputTask);
+        vSemaphoreDelete(_outputIdle);
+      }
+      Segment::_pixelArena.release(_outPixels);
+      p_free(_outCCT);
+#endif
+#ifdef WLED_PARALLEL_RENDER
+      if (_renderTask) {
+        vTaskDelete(_renderTask);
+        vSemaphoreDelete(_renderDone);
+      }
+#endif
+      Segment::_pixelArena.release(_pixels);
       p_free(_pixelCCT); // just in case
+      p_free(_effectCost);
       d_free(customMappingTable);
+      d_free(_ledmapRuns);
       _mode.clear();
       _modeData.clear();
       _segments.clear();
@@ -882,6 +1029,32 @@ class WS2812FX {
 #endif
     }
 
+    // time spent in each stage of frame rendering in us (moving average)
+    typedef struct StageTimes {
+      uint32_t effects;   // running effect functions (service())
+      uint32_t composite; // blending segments into frame buffer (show())
+      uint32_t output;    // gamma, ledmap, CCT, ABL and bus transmission (output task if pipelined)
+      uint32_t wait;      // render waiting for output task to finish previous frame (back-pressure, pipelined only)
+    } StageTimes;
+
+    // per stage durations of a single frame in us (see /json/perf)
+    typedef struct FrameProfile {
+      uint32_t frame;     // frame number
+      uint16_t effects;   // effect functions
+      uint16_t composite; // segment blending (incl. show callback)
+      uint16_t remap;     // gamma, ledmap, CCT (copying frame to buses)
+      uint16_t abl;       // automatic brightness limiter
+      uint16_t transmit;  // bus show()
+      uint16_t wait;      // back-pressure (pipelined only)
+      uint8_t  segments;  // number of effect function calls
+    } FrameProfile;
+
+    // cumulative cost of an effect (halved when counters get large, average stays valid)
+    typedef struct EffectCost {
+      uint32_t time;      // us spent in effect function
+      uint32_t runs;      // effect function calls
+    } EffectCost;
+
     void
 #ifdef WLED_DEBUG
       printSize(),                                // prints memory usage for strip components
@@ -897,13 +1070,19 @@ class WS2812FX {
       makeAutoSegments(bool forceReset = false),  // will create segments based on configured outputs
       fixInvalidSegments(),                       // fixes incorrect segment configuration
       blendSegment(const Segment &topSegment) const,    // blends topSegment into pixels
+      compositeSegments(),                        // blends changed segments into frame buffer
       show(),                                     // initiates LED output
+      outputFrame(const pixel_t *frame, const uint8_t *cct, bool gamma, FrameProfile &profile), // sends frame to buses (gamma, ledmap, CCT, ABL)
       setTargetFps(unsigned fps),
       setupEffectData(),                          // add default effects to the list; defined in FX.cpp
       waitForIt();                                // wait until frame is over (service() has finished or time for 1 frame has passed)
 
     void setRealtimePixelColor(unsigned i, uint32_t c);
-    inline void setPixelColor(unsigned n, uint32_t c) const   { if (n < getLengthTotal()) _pixels[n] = c; }  // paints absolute strip pixel with index n and color c
+    void ingestPixels(int start, const uint8_t *data, size_t count, unsigned stride, bool white); // bulk setRealtimePixelColor() of packed R,G,B[,W] data
+    inline void ingestRGB(int start, const uint8_t *data, size_t count, unsigned stride = 3)  { ingestPixels(start, data, count, stride, false); }
+    inline void ingestRGBW(int start, const uint8_t *data, size_t count, unsigned stride = 4) { ingestPixels(start, data, count, stride, true); }
+    void ingestSegmentPixels(const Segment &seg, unsigned offset, const uint8_t *data, size_t count, unsigned stride, bool white); // ingestPixels() into segment footprint
+    inline void setPixelColor(unsigned n, uint32_t c) const   { if (n < getLengthTotal()) { _pixels[n] = toPixel(c); _frameValid = false; } }  // paints absolute strip pixel with index n and color c
     inline void resetTimebase()                               { timebase = 0UL - millis(); }
     inline void setPixelColor(unsigned n, uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0) const
                                                               { setPixelColor(n, RGBW32(r,g,b,w)); }
@@ -925,12 +1104,23 @@ class WS2812FX {
     bool hasCCTBus() const;
     bool deserializeMap(unsigned n = 0);
 
-    inline bool isUpdating() const           { return !BusManager::canAllShow(); } // return true if the strip is being sent pixel updates
+    inline bool isUpdating() const           { return !BusManager::canAllShow() || isOutputBusy(); } // return true if the strip is being sent pixel updates
     inline bool isServicing() const          { return _isServicing; }           // returns true if strip.service() is executing
     inline bool hasWhiteChannel() const      { return _hasWhiteChannel; }       // returns true if strip contains separate white chanel
     inline bool isOffRefreshRequired() const { return _isOffRefreshRequired; }  // returns true if strip requires regular updates (i.e. TM1814 chipset)
     inline bool isSuspended() const          { return _suspend; }               // returns true if strip.service() execution is suspended
     inline bool needsUpdate() const          { return _triggered; }             // returns true if strip received a trigger() request
+  #ifdef WLED_PIPELINED_OUTPUT
+    inline bool isPipelined() const          { return _outputTask && _outPixels; } // returns true if frames are sent by output task
+    inline bool isOutputBusy() const         { return _outputTask && uxSemaphoreGetCount(_outputIdle) == 0; } // returns true if output task is sending a frame
+    void waitForOutput() const;                                                 // waits until output task has sent last frame (call before modifying buses or ledmap)
+  #else
+    inline bool isPipelined() const          { return false; }
+    inline bool isOutputBusy() const         { return false; }
+    inline void waitForOutput() const        {}
+  #endif
+    void pollOutput() const;                                                    // starts frames deferred by buses that were still sending (called from service())
+    void compactBuffers();                                                      // closes holes left in buffer arenas by freed segment buffers (called from service())
 
     uint8_t paletteBlend;
     uint8_t getActiveSegmentsNum() const;
@@ -942,7 +1132,7 @@ class WS2812FX {
     inline uint8_t getBrightness() const    { return _brightness; }       // returns current strip brightness
     inline static constexpr unsigned getMaxSegments() { return MAX_NUM_SEGMENTS; }  // returns maximum number of supported segments (fixed value)
     inline uint8_t getSegmentsNum() const   { return _segments.size(); }  // returns currently present segments
-    inline uint8_t getCurrSegmentId() const { return _segment_index; }    // returns current segment index (only valid while strip.isServicing())
+    inline uint8_t getCurrSegmentId() const { return _segment_index[RENDER_TASK_ID]; } // returns current segment index (only valid while strip.isServicing())
     inline uint8_t getMainSegmentId() const { return _mainSegment; }      // returns main segment index
     inline uint8_t getTargetFps() const     { return _targetFps; }        // returns rough FPS value for las 2s interval
     inline uint8_t getModeCount() const     { return _modeCount; }        // returns number of registered modes/effects
@@ -951,17 +1141,26 @@ class WS2812FX {
     uint16_t getLengthTotal() const; // will include virtual/nonexistent pixels in matrix
 
     inline uint16_t getFps() const          { return (millis() - _lastShow > 2000) ? 0 : (FPS_MULTIPLIER * _cumulativeFps) >> FPS_CALC_SHIFT; } // Returns the refresh rate of the LED strip (_cumulativeFps is stored in fixed point)
+    inline uint32_t getCompositedPixels() const { return _compositedPixels; } // returns number of segment pixels blended into frame buffer in last frame
+    inline size_t   getFrameBufferSize() const { return _pixels ? (isPipelined() ? 2 : 1) * getLengthTotal() * sizeof(pixel_t) : 0; } // returns RAM used by frame buffer(s)
+    inline const StageTimes &getStageTimes() const { return _stageTimes; } // returns time spent in each stage of frame rendering
+    inline uint32_t getProfiledFrames() const { return _frameCount; }    // returns number of frames sent since boot
+    inline const FrameProfile &getFrameProfile(unsigned age) const { return _frameLog[(_frameCount - 1 - age) % WLED_PERF_FRAMES]; } // age 0 is last frame sent (age < min(WLED_PERF_FRAMES, getProfiledFrames()))
+    inline uint16_t getSegmentTime(unsigned n) const { return n < MAX_NUM_SEGMENTS ? _segmentTime[n] : 0; } // returns time spent in effect function of segment n (moving average, us)
+    inline const EffectCost *getEffectCost(unsigned id) const { return id < _effectCostCount ? &_effectCost[id] : nullptr; } // returns cumulative cost of effect (nullptr if never run)
     inline uint16_t getFrameTime() const    { return _frametime; }        // returns amount of time a frame should take (in ms)
+    inline uint16_t getGovernedFrameTime() const { return _governedFrametime; } // returns actual time between frames set by governor (in ms, same as getFrameTime() if not throttled)
+    inline bool isThrottled() const         { return _governedFrametime > _frametime; } // frame rate governor lowered frame rate
     inline uint16_t getMinShowDelay() const { return MIN_FRAME_DELAY; }   // returns minimum amount of time strip.service() can be delayed (constant)
     inline uint16_t getLength() const       { return _length; }           // returns actual amount of LEDs on a strip (2D matrix may have less LEDs than W*H)
     inline uint16_t getTransition() const   { return _transitionDur; }    // returns currently set transition time (in ms)
     inline uint16_t getMappedPixelIndex(uint16_t index) const {           // convert logical address to physical
-      if (index < customMappingSize && (realtimeMode == REALTIME_MODE_INACTIVE || realtimeRespectLedMaps)) index = customMappingTable[index];
+      if (index < customMappingSize && (realtimeMode == REALTIME_MODE_INACTIVE || realtimeRespectLedMaps)) index = customMappingTable ? customMappingTable[index] : getLedmapRunIndex(index);
       return index;
     };
 
     unsigned long now, timebase;
-    inline uint32_t getPixelColor(unsigned n) const { return (n < getLengthTotal()) ? _pixels[n] : 0; } // returns color of pixel n
+    inline uint32_t getPixelColor(unsigned n) const { return (n < getLengthTotal()) ? fromPixel(_pixels[n]) : 0; } // returns color of pixel n
     inline uint32_t getLastShow() const             { return _lastShow; }                 // returns millis() timestamp of last strip.show() call
 
     const char *getModeData(unsigned id = 0) const  { return (id && id < _modeCount) ? _modeData[id] : PSTR("Solid"); }
@@ -1014,13 +1213,37 @@ class WS2812FX {
       bool autoSegments : 1;
       bool correctWB    : 1;
       bool cctFromRgb   : 1;
+      bool fpsGovernor  : 1; // adapt frame rate to render cost (see governFrameRate())
     };
 
-    Segment *_currentSegment;
+    Segment *_currentSegment[WLED_RENDER_TASKS]; // segment being rendered by each render task (see SEGMENT)
 
   private:
-    uint32_t *_pixels;
+    pixel_t  *_pixels;                // frame buffer (16 bits per channel with WLED_PIXEL16)
     uint8_t  *_pixelCCT;
+  #ifdef WLED_PIPELINED_OUTPUT
+    pixel_t  *_outPixels;             // frame being sent by output task
+    uint8_t  *_outCCT;                // CCT of frame being sent (swapped with _pixelCCT)
+    bool      _outGamma;              // apply gamma to frame being sent
+    TaskHandle_t      _outputTask;
+    SemaphoreHandle_t _outputIdle;    // given by output task when frame was sent
+    FrameProfile      _outProfile;    // profile of frame being sent
+    static void outputTask(void *arg);
+  #endif
+    StageTimes _stageTimes;
+    // frame profiler
+    FrameProfile  _frameProfile;                    // frame being rendered
+    FrameProfile  _frameLog[WLED_PERF_FRAMES];      // ring buffer of frames sent
+    uint32_t      _frameCount;                      // frames sent (next entry in _frameLog)
+    uint16_t      _segmentTime[MAX_NUM_SEGMENTS];   // moving average of effect function time per segment (us)
+    EffectCost   *_effectCost;                      // indexed by effect id, allocated when first effect runs
+    uint16_t      _effectCostCount;
+  #ifdef WLED_PARALLEL_RENDER
+    std::mutex    _profileLock;                     // effects are profiled by both render tasks
+  #endif
+    void profileEffect(unsigned index, uint8_t mode, uint32_t us);
+    void governFrameRate();
+    void commitFrameProfile(FrameProfile &profile);
     std::vector<Segment> _segments;
 
     volatile bool _suspend;
@@ -1030,6 +1253,8 @@ class WS2812FX {
     uint16_t _transitionDur;
 
     uint16_t _frametime;
+    uint16_t _governedFrametime;      // frame time used by service(), >= _frametime
+    uint8_t  _governorHeadroom;       // consecutive frames that would fit in shorter frame time
     uint16_t _cumulativeFps;
     uint8_t  _targetFps;
 
@@ -1039,10 +1264,33 @@ class WS2812FX {
       bool _isOffRefreshRequired : 1; //periodic refresh is required for the strip to remain off.
       bool _hasWhiteChannel      : 1;
       bool _triggered            : 1;
+      mutable bool _frameValid   : 1; // frame buffer holds last composition of segments (false if it was painted directly)
     };
 
-    uint8_t _segment_index;
+    uint8_t _segment_index[WLED_RENDER_TASKS];
+  #ifdef WLED_PARALLEL_RENDER
+    // segments due in current frame, shared between render tasks (work-sharing)
+    typedef struct RenderJob {
+      Segment *seg;         // segment (parent segment if old mode is rendered)
+      uint16_t frameDelay;  // returned by effect function
+      uint8_t  index;       // segment index (see getCurrSegmentId())
+      bool     oldMode;     // render old mode of segment in transition
+    } RenderJob;
+    RenderJob            _renderJobs[2*MAX_NUM_SEGMENTS]; // parallel jobs from front, main core only jobs from back
+    unsigned             _numParallelJobs;
+    std::atomic<unsigned> _nextParallelJob; // next parallel job to be claimed by any render task
+    std::vector<bool>    _modeMainCore;     // effect uses shared state and must be rendered by Arduino loop
+    bool                 _addingBuiltinFX;  // effects added by setupEffectData() are known to be safe (unless audio reactive)
+    TaskHandle_t         _renderTask;
+    SemaphoreHandle_t    _renderDone;       // given by render task when it found no more jobs
+    static void renderTask(void *arg);
+    void renderParallelJobs();
+  #endif
+    unsigned renderSegment(Segment &seg, unsigned index, bool oldMode); // runs effect function, returns delay until next frame
+    bool     needsOldModeRun(const Segment &seg) const;                 // segment in transition needs old effect to run too
     uint8_t _mainSegment;
+    uint8_t _compositedSegments;      // number of segments at last composition
+    uint32_t _compositedPixels;       // segment pixels blended into frame buffer in last frame
 
     uint8_t                  _modeCount;
     std::vector<mode_ptr>    _mode;     // SRAM footprint: 4 bytes per element
@@ -1053,6 +1301,19 @@ class WS2812FX {
     uint16_t* customMappingTable;
     uint16_t  customMappingSize;
 
+    // ledmap compiled into runs of logical pixels mapped to target + i*stride (replaces customMappingTable if smaller)
+    typedef struct LedmapRun {
+      uint16_t start;   // first logical pixel
+      uint16_t length;
+      uint16_t target;  // physical pixel of first logical pixel (0xFFFF = unmapped, stride 0)
+      int16_t  stride;
+    } LedmapRun;
+    LedmapRun *_ledmapRuns;
+    uint16_t   _ledmapRunCount;
+    void     compileLedmap();                            // compiles customMappingTable into runs if that saves memory
+    uint16_t getLedmapRunIndex(uint16_t index) const;    // physical pixel of logical pixel index using compiled ledmap
+    void     outputLedmapRuns(const pixel_t *frame, size_t len, bool gamma, void (*spanFn)(unsigned, const pixel_t*, size_t, bool)) const; // hands frame to buses run by run
+
     unsigned long _lastShow;
     unsigned long _lastServiceShow;
 
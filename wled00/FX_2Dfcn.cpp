@@ -52,6 +52,8 @@ void WS2812FX::setUpMatrix() {
     customMappingSize = 0; // prevent use of mapping if anything goes wrong
 
     d_free(customMappingTable);
+    d_free(_ledmapRuns);
+    _ledmapRuns = nullptr;
     customMappingTable = static_cast<uint16_t*>(d_malloc(sizeof(uint16_t)*getLengthTotal())); // prefer to not use SPI RAM
 
     if (customMappingTable) {
@@ -114,7 +116,6 @@ void WS2812FX::setUpMatrix() {
 
       // delete gap array as we no longer need it
       p_free(gapTable);
-      resume();
 
       #ifdef WLED_DEBUG
       DEBUG_PRINT(F("Matrix ledmap:"));
@@ -124,6 +125,8 @@ void WS2812FX::setUpMatrix() {
       }
       DEBUG_PRINTLN();
       #endif
+      compileLedmap();
+      resume();
     } else { // memory allocation error
       DEBUG_PRINTLN(F("ERROR 2D LED map allocation error."));
       isMatrix = false;
@@ -245,54 +248,16 @@ void Segment::blur2D(uint8_t blur_x, uint8_t blur_y, bool smear) const {
   if (!isActive()) return; // not active
   const unsigned cols = vWidth();
   const unsigned rows = vHeight();
-  const auto XY = [&](unsigned x, unsigned y){ return x + y*cols; };
-  uint32_t lastnew; // not necessary to initialize lastnew and last, as both will be initialized by the first loop iteration
-  uint32_t last;
+  uint32_t *px = getPixels();
   if (blur_x) {
-    const uint8_t keepx = smear ? 255 : 255 - blur_x;
-    const uint8_t seepx = blur_x >> 1;
-    for (unsigned row = 0; row < rows; row++) { // blur rows (x direction)
-      uint32_t carryover = BLACK;
-      uint32_t curnew = BLACK;
-      for (unsigned x = 0; x < cols; x++) {
-        uint32_t cur = getPixelColorRaw(XY(x, row));
-        uint32_t part = color_fade(cur, seepx);
-        curnew = color_fade(cur, keepx);
-        if (x > 0) {
-          if (carryover) curnew = color_add(curnew, carryover);
-          uint32_t prev = color_add(lastnew, part);
-          // optimization: only set pixel if color has changed
-          if (last != prev) setPixelColorRaw(XY(x - 1, row), prev);
-        } else setPixelColorRaw(XY(x, row), curnew); // first pixel
-        lastnew = curnew;
-        last = cur; // save original value for comparison on next iteration
-        carryover = part;
-      }
-      setPixelColorRaw(XY(cols-1, row), curnew); // set last pixel
-    }
+    const unsigned keepx = smear ? 255 : 255 - blur_x;
+    const unsigned seepx = blur_x >> 1;
+    for (unsigned row = 0; row < rows; row++) blur_span(px + row * cols, cols, 1, keepx + 1, seepx + 1); // blur rows (x direction)
   }
   if (blur_y) {
-    const uint8_t keepy = smear ? 255 : 255 - blur_y;
-    const uint8_t seepy = blur_y >> 1;
-    for (unsigned col = 0; col < cols; col++) {
-      uint32_t carryover = BLACK;
-      uint32_t curnew = BLACK;
-      for (unsigned y = 0; y < rows; y++) {
-        uint32_t cur = getPixelColorRaw(XY(col, y));
-        uint32_t part = color_fade(cur, seepy);
-        curnew = color_fade(cur, keepy);
-        if (y > 0) {
-          if (carryover) curnew = color_add(curnew, carryover);
-          uint32_t prev = color_add(lastnew, part);
-          // optimization: only set pixel if color has changed
-          if (last != prev) setPixelColorRaw(XY(col, y - 1), prev);
-        } else setPixelColorRaw(XY(col, y), curnew); // first pixel
-        lastnew = curnew;
-        last = cur; //save original value for comparison on next iteration
-        carryover = part;
-      }
-      setPixelColorRaw(XY(col, rows - 1), curnew);
-    }
+    const unsigned keepy = smear ? 255 : 255 - blur_y;
+    const unsigned seepy = blur_y >> 1;
+    for (unsigned col = 0; col < cols; col++) blur_span(px + col, rows, cols, keepy + 1, seepy + 1); // blur columns (y direction)
   }
 }
 
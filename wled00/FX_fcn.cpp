@@ -40,17 +40,22 @@
 unsigned      Segment::_usedSegmentData   = 0U; // amount of RAM all segments use for their data[]
 uint16_t      Segment::maxWidth           = DEFAULT_LED_COUNT;
 uint16_t      Segment::maxHeight          = 1;
-unsigned      Segment::_vLength           = 0;
-unsigned      Segment::_vWidth            = 0;
-unsigned      Segment::_vHeight           = 0;
-uint32_t      Segment::_currentColors[NUM_COLORS] = {0,0,0};
-CRGBPalette16 Segment::_currentPalette    = CRGBPalette16(CRGB::Black);
+unsigned      Segment::_vLength[WLED_RENDER_TASKS] = {0};
+unsigned      Segment::_vWidth[WLED_RENDER_TASKS]  = {0};
+unsigned      Segment::_vHeight[WLED_RENDER_TASKS] = {0};
+uint32_t      Segment::_currentColors[WLED_RENDER_TASKS][NUM_COLORS] = {{0,0,0}};
+CRGBPalette16 Segment::_currentPalette[WLED_RENDER_TASKS];
 CRGBPalette16 Segment::_randomPalette     = generateRandomPalette();  // was CRGBPalette16(DEFAULT_COLOR);
 CRGBPalette16 Segment::_newRandomPalette  = generateRandomPalette();  // was CRGBPalette16(DEFAULT_COLOR);
 uint16_t      Segment::_lastPaletteChange = 0; // in seconds; perhaps it should be per segment
 uint16_t      Segment::_nextPaletteBlend  = 0; // in millis
 
-bool     Segment::_modeBlend = false;
+bool     Segment::_modeBlend[WLED_RENDER_TASKS] = {false};
+#ifdef WLED_PARALLEL_RENDER
+std::mutex Segment::_dataLock;
+#endif
+BufferArena Segment::_pixelArena(BFRALLOC_ENFORCE_PSRAM | BFRALLOC_NOBYTEACCESS);
+BufferArena Segment::_dataArena(BFRALLOC_PREFER_DRAM);
 uint16_t Segment::_clipStart = 0;
 uint16_t Segment::_clipStop = 0;
 uint8_t  Segment::_clipStartY = 0;
@@ -60,16 +65,17 @@ uint8_t  Segment::_clipStopY = 1;
 Segment::Segment(const Segment &orig) {
   //DEBUG_PRINTF_P(PSTR("-- Copy segment constructor: %p -> %p\n"), &orig, this);
   memcpy((void*)this, (void*)&orig, sizeof(Segment));
+  invalidateBlend(); // frame buffer does not contain this segment yet
   _t   = nullptr; // copied segment cannot be in transition
   name = nullptr;
   data = nullptr;
   _dataLen = 0;
   pixels = nullptr;
+  _geomMap = nullptr; // rebuilt on first use
   if (!stop) return;  // nothing to do if segment is inactive/invalid
   if (orig.pixels) {
-    // allocate pixel buffer: prefer IRAM/PSRAM
-    pixels = static_cast<uint32_t*>(allocate_buffer(orig.length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS));
-    if (pixels) {
+    // allocate pixel buffer from pixel arena
+    if (allocatePixels(false)) {
       memcpy(pixels, orig.pixels, sizeof(uint32_t) * orig.length());
       if (orig.name) { name = static_cast<char*>(allocate_buffer(strlen(orig.name)+1, BFRALLOC_PREFER_PSRAM)); if (name) strcpy(name, orig.name); }
       if (orig.data) { if (allocateData(orig._dataLen)) memcpy(data, orig.data, orig._dataLen); }
@@ -85,11 +91,15 @@ Segment::Segment(const Segment &orig) {
 Segment::Segment(Segment &&orig) noexcept {
   //DEBUG_PRINTF_P(PSTR("-- Move segment constructor: %p -> %p\n"), &orig, this);
   memcpy((void*)this, (void*)&orig, sizeof(Segment));
+  invalidateBlend(); // segment may have changed its place in segment list
+  _pixelArena.rebind(pixels, reinterpret_cast<void**>(&pixels)); // arena updates owner if buffer is moved by compaction
+  _dataArena.rebind(data, reinterpret_cast<void**>(&data));
   orig._t   = nullptr; // old segment cannot be in transition any more
   orig.name = nullptr;
   orig.data = nullptr;
   orig._dataLen = 0;
   orig.pixels = nullptr;
+  orig._geomMap = nullptr;
 }
 
 // copy assignment
@@ -100,19 +110,21 @@ Segment& Segment::operator= (const Segment &orig) {
     if (name) { p_free(name); name = nullptr; }
     if (_t) stopTransition(); // also erases _t
     deallocateData();
-    p_free(pixels);
+    freeGeometryMap();
+    freePixels();
     // copy source
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
+    invalidateBlend(); // frame buffer does not contain this segment yet
     // erase pointers to allocated data
     data = nullptr;
     _dataLen = 0;
     pixels = nullptr;
+    _geomMap = nullptr; // rebuilt on first use
     if (!stop) return *this;  // nothing to do if segment is inactive/invalid
     // copy source data
     if (orig.pixels) {
-      // allocate pixel buffer: prefer IRAM/PSRAM
-      pixels = static_cast<uint32_t*>(allocate_buffer(orig.length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS));
-      if (pixels) {
+      // allocate pixel buffer from pixel arena
+      if (allocatePixels(false)) {
         memcpy(pixels, orig.pixels, sizeof(uint32_t) * orig.length());
         if (orig.name) { name = static_cast<char*>(allocate_buffer(strlen(orig.name)+1, BFRALLOC_PREFER_PSRAM)); if (name) strcpy(name, orig.name); }
         if (orig.data) { if (allocateData(orig._dataLen)) memcpy(data, orig.data, orig._dataLen); }
@@ -133,13 +145,18 @@ Segment& Segment::operator= (Segment &&orig) noexcept {
     if (name) { p_free(name); name = nullptr; } // free old name
     if (_t) stopTransition(); // also erases _t
     deallocateData(); // free old runtime data
-    p_free(pixels);   // free old pixel buffer
+    freeGeometryMap();
+    freePixels();     // free old pixel buffer
     // move source data
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
+    invalidateBlend(); // segment may have changed its place in segment list
+    _pixelArena.rebind(pixels, reinterpret_cast<void**>(&pixels));
+    _dataArena.rebind(data, reinterpret_cast<void**>(&data));
     orig.name = nullptr;
     orig.data = nullptr;
     orig._dataLen = 0;
     orig.pixels = nullptr;
+    orig._geomMap = nullptr;
     orig._t = nullptr; // old segment cannot be in transition
   }
   return *this;
@@ -160,6 +177,9 @@ bool Segment::allocateData(size_t len) {
       return true;
   }
   //DEBUG_PRINTF_P(PSTR("--   Allocating data (%d): %p\n"), len, this);
+  #ifdef WLED_PARALLEL_RENDER
+  const std::lock_guard<std::mutex> lock(_dataLock); // effects on the other core may allocate too
+  #endif
   // limit to MAX_SEGMENT_DATA if there is no PSRAM, otherwise prefer functionality over speed
   #ifndef BOARD_HAS_PSRAM
   if (Segment::getUsedSegmentData() + len - _dataLen > MAX_SEGMENT_DATA) {
@@ -171,11 +191,11 @@ bool Segment::allocateData(size_t len) {
   #endif
 
   if (data) {
-    d_free(data); // free data and try to allocate again (segment buffer may be blocking contiguous heap)
+    _dataArena.release(data); // free data and try to allocate again (segment buffer may be blocking contiguous space)
     Segment::addUsedSegmentData(-_dataLen); // subtract buffer size
   }
 
-  data = static_cast<byte*>(allocate_buffer(len, BFRALLOC_PREFER_DRAM | BFRALLOC_CLEAR)); // prefer DRAM over PSRAM for speed
+  data = static_cast<byte*>(_dataArena.allocate(len, reinterpret_cast<void**>(&data), true)); // data arena prefers DRAM over PSRAM for speed
 
   if (data) {
     Segment::addUsedSegmentData(len);
@@ -191,9 +211,12 @@ bool Segment::allocateData(size_t len) {
 
 void Segment::deallocateData() {
   if (!data) { _dataLen = 0; return; }
+  #ifdef WLED_PARALLEL_RENDER
+  const std::lock_guard<std::mutex> lock(_dataLock);
+  #endif
   if ((Segment::getUsedSegmentData() > 0) && (_dataLen > 0)) { // check that we don't have a dangling / inconsistent data pointer
     //DEBUG_PRINTF_P(PSTR("---  Released data (%p): %d/%d -> %p\n"), this, _dataLen, Segment::getUsedSegmentData(), data);
-    d_free(data);
+    _dataArena.release(data);
   } else {
     DEBUG_PRINTF_P(PSTR("---- Released data (%p): inconsistent UsedSegmentData (%d/%d), cowardly refusing to free nothing.\n"), this, _dataLen, Segment::getUsedSegmentData());
   }
@@ -202,6 +225,12 @@ void Segment::deallocateData() {
   _dataLen = 0;
 }
 
+// allocates render buffer (always entire segment) from pixel arena (heap is used if arena is full)
+bool Segment::allocatePixels(bool clear) {
+  pixels = static_cast<uint32_t*>(_pixelArena.allocate(length() * sizeof(uint32_t), reinterpret_cast<void**>(&pixels), clear));
+  return pixels != nullptr;
+}
+
 /**
   * If reset of this segment was requested, clears runtime
   * settings of this segment.
@@ -218,6 +247,7 @@ void Segment::resetIfRequired() {
     DEBUG_PRINTF_P(PSTR("-- Segment %p reset, data cleared\n"), this);
   }
   if (pixels) for (size_t i = 0; i < length(); i++) pixels[i] = BLACK; // clear pixel buffer
+  _dirty = true;
   next_time = 0; step = 0; call = 0; aux0 = 0; aux1 = 0;
   reset = false;
   #ifdef WLED_ENABLE_GIF
@@ -358,33 +388,66 @@ uint8_t Segment::currentBri() const {
   return curBri;
 }
 
+// segment appeared, disappeared or changed its footprint in frame buffer since it was last blended
+bool Segment::footprintChanged() const {
+  if (!_blended.valid || isVisible() != _blended.visible) return true;
+  return _blended.visible && (start != _blended.start || stop != _blended.stop || startY != _blended.startY || stopY != _blended.stopY);
+}
+
+// segment's pixels or any of the parameters used by WS2812FX::blendSegment() changed since it was last blended
+bool Segment::needsBlend() const {
+  return _dirty || isInTransition() || _blended.transition
+      || offset != _blended.offset || options != _blended.options || grouping != _blended.grouping || spacing != _blended.spacing
+      || currentBri() != _blended.bri || currentCCT() != _blended.cct || blendMode != _blended.blendMode;
+}
+
+void Segment::setBlended() const {
+  _blended.start      = start;
+  _blended.stop       = stop;
+  _blended.startY     = startY;
+  _blended.stopY      = stopY;
+  _blended.offset     = offset;
+  _blended.options    = options;
+  _blended.grouping   = grouping;
+  _blended.spacing    = spacing;
+  _blended.bri        = currentBri();
+  _blended.cct        = currentCCT();
+  _blended.blendMode  = blendMode;
+  _blended.valid      = true;
+  _blended.visible    = isVisible();
+  _blended.transition = isInTransition();
+  _dirty = false;
+}
+
 // pre-calculate drawing parameters for faster access (based on the idea from @softhack007 from MM fork)
 // and blends colors and palettes if necessary
 // prog is the progress of the transition (0-65535) and is passed to the function as it may be called in the context of old segment
 // which does not have transition structure
 void Segment::beginDraw(uint16_t prog) {
   setDrawDimensions();
+  uint32_t      *currentColors  = _currentColors[RENDER_TASK_ID];
+  CRGBPalette16 &currentPalette = _currentPalette[RENDER_TASK_ID];
   // load colors into _currentColors
-  for (unsigned i = 0; i < NUM_COLORS; i++) _currentColors[i] = colors[i];
+  for (unsigned i = 0; i < NUM_COLORS; i++) currentColors[i] = colors[i];
   // load palette into _currentPalette
-  loadPalette(Segment::_currentPalette, palette);
+  loadPalette(currentPalette, palette);
   if (isInTransition() && prog < 0xFFFFU && blendingStyle == BLEND_STYLE_FADE) {
     // blend colors
-    for (unsigned i = 0; i < NUM_COLORS; i++) _currentColors[i] = color_blend16(_t->_colors[i], colors[i], prog);
+    for (unsigned i = 0; i < NUM_COLORS; i++) currentColors[i] = color_blend16(_t->_colors[i], colors[i], prog);
     // blend palettes
     // there are about 255 blend passes of 48 "blends" to completely blend two palettes (in _dur time)
     // minimum blend time is 100ms maximum is 65535ms
     #ifndef WLED_SAVE_RAM
     unsigned noOfBlends = ((255U * prog) / 0xFFFFU) - _t->_prevPaletteBlends;
     if(noOfBlends > 255) noOfBlends = 255; // safety check
-    for (unsigned i = 0; i < noOfBlends; i++, _t->_prevPaletteBlends++) nblendPaletteTowardPalette(_t->_palT, Segment::_currentPalette, 48);
-    Segment::_currentPalette = _t->_palT; // copy transitioning/temporary palette
+    for (unsigned i = 0; i < noOfBlends; i++, _t->_prevPaletteBlends++) nblendPaletteTowardPalette(_t->_palT, currentPalette, 48);
+    currentPalette = _t->_palT; // copy transitioning/temporary palette
     #else
     unsigned noOfBlends = ((255U * prog) / 0xFFFFU);
     CRGBPalette16 tmpPalette;
     loadPalette(tmpPalette, _t->_palette);
-    for (unsigned i = 0; i < noOfBlends; i++) nblendPaletteTowardPalette(tmpPalette, Segment::_currentPalette, 48);
-    Segment::_currentPalette = tmpPalette; // copy transitioning/temporary palette
+    for (unsigned i = 0; i < noOfBlends; i++) nblendPaletteTowardPalette(tmpPalette, currentPalette, 48);
+    currentPalette = tmpPalette; // copy transitioning/temporary palette
     #endif
   }
 }
@@ -432,6 +495,10 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
     spacing = 0;
   }
   if (ofs < UINT16_MAX) offset = ofs;
+  if (!boundsUnchanged || m12 != map1D2D) {
+    freeGeometryMap(); // release RAM now, map is rebuilt when needed
+    _geomMapFailed = false;
+  }
   map1D2D  = constrain(m12, 0, 7);
 
   if (boundsUnchanged) return;
@@ -446,8 +513,7 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
   // apply change immediately
   if (i2 <= i1) { //disable segment
     deallocateData();
-    p_free(pixels);
-    pixels = nullptr;
+    freePixels();
     stop = 0;
     return;
   }
@@ -464,17 +530,15 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
   // safety check
   if (start >= stop || startY >= stopY) {
     deallocateData();
-    p_free(pixels);
-    pixels = nullptr;
+    freePixels();
     stop = 0;
     return;
   }
   // allocate FX render buffer
   if (length() != oldLength) {
-    // allocate render buffer (always entire segment), prefer IRAM/PSRAM. Note: impact on FPS with PSRAM buffer is low (<2% with QSPI PSRAM) on S2/S3
-    p_free(pixels);
-    pixels = static_cast<uint32_t*>(allocate_buffer(length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS));
-    if (!pixels) {
+    // allocate render buffer (always entire segment) from pixel arena. Note: impact on FPS with PSRAM buffer is low (<2% with QSPI PSRAM) on S2/S3
+    freePixels();
+    if (!allocatePixels(false)) {
       DEBUGFX_PRINTLN(F("!!! Not enough RAM for pixel buffer !!!"));
       deallocateData();
       errorFlag = ERR_NORAM_PX;
@@ -635,6 +699,230 @@ static void setPinwheelParameters(int i, int vW, int vH, int& startx, int& start
   startx = (vW * Fixed_Scale) / 2; // + cosVal[0] / 4; // starting position = center + 1/4 pixel (in fixed point)
   starty = (vH * Fixed_Scale) / 2; // + sinVal[0] / 4;
 }
+
+// draw categories of expanded pixels, pinwheel rays skip pixels they share with an adjacent ray drawn just before
+enum : uint8_t { GM_ALWAYS = 0, GM_FIRST = 1, GM_LAST = 2, GM_BOTH = 3 }; // always drawn, on first line, on last line, on both lines
+
+// calls emit(x, y, category) for every pixel of virtual pixel i expanded onto vW x vH (M12_pArc, M12_pCorner & M12_sPinwheel)
+// pixels outside of the segment are skipped, pixels may be emitted more than once
+template<typename Emit> static void forEachExpandedPixel(uint8_t mapping, int i, int vW, int vH, Emit emit) {
+  const auto inside = [&](int x, int y) { return (unsigned)x < (unsigned)vW && (unsigned)y < (unsigned)vH; };
+  switch (mapping) {
+    case M12_pArc:
+      // expand in circular fashion from center
+      if (i == 0)
+        emit(0, 0, GM_ALWAYS);
+      else {
+        float r = i;
+        float step = HALF_PI / (2.8284f * r + 4); // we only need (PI/4)/(r/sqrt(2)+1) steps
+        for (float rad = 0.0f; rad <= (HALF_PI/2)+step/2; rad += step) {
+          int x = roundf(sin_t(rad) * r);
+          int y = roundf(cos_t(rad) * r);
+          // exploit symmetry
+          if (inside(x, y)) emit(x, y, GM_ALWAYS);
+          if (inside(y, x)) emit(y, x, GM_ALWAYS);
+        }
+      }
+      break;
+    case M12_pCorner:
+      for (int x = 0; x <= i; x++) if (inside(x, i)) emit(x, i, GM_ALWAYS); // note: <= to include i=0
+      for (int y = 0; y <  i; y++) if (inside(i, y)) emit(i, y, GM_ALWAYS);
+      break;
+    case M12_sPinwheel: {
+      // Uses Bresenham's algorithm to place coordinates of two lines in arrays then draws between them
+      int startX, startY, cosVal[2], sinVal[2]; // in fixed point scale
+      setPinwheelParameters(i, vW, vH, startX, startY, cosVal, sinVal);
+
+      unsigned maxLineLength = max(vW, vH) + 2; // pixels drawn is always smaller than dx or dy, +1 pair for rounding errors
+      uint16_t lineCoords[2][maxLineLength];    // uint16_t to save ram
+      int lineLength[2] = {0};
+
+      int closestEdgeIdx = INT_MAX; // index of the closest edge pixel
+
+      for (int lineNr = 0; lineNr < 2; lineNr++) {
+        int x0 = startX; // x, y coordinates in fixed scale
+        int y0 = startY;
+        int x1 = (startX + (cosVal[lineNr] << 9)); // outside of grid
+        int y1 = (startY + (sinVal[lineNr] << 9)); // outside of grid
+        const int dx =  abs(x1-x0), sx = x0<x1 ? 1 : -1; // x distance & step
+        const int dy = -abs(y1-y0), sy = y0<y1 ? 1 : -1; // y distance & step
+        uint16_t* coordinates = lineCoords[lineNr]; // 1D access is faster
+        int* length = &lineLength[lineNr];          // faster access
+        x0 /= Fixed_Scale; // convert to pixel coordinates
+        y0 /= Fixed_Scale;
+
+        // Bresenham's algorithm
+        int idx = 0;
+        int err = dx + dy;
+        while (true) {
+          if ((unsigned)x0 >= (unsigned)vW || (unsigned)y0 >= (unsigned)vH) {
+            closestEdgeIdx = min(closestEdgeIdx, idx-2);
+            break; // stop if outside of grid (exploit unsigned int overflow)
+          }
+          coordinates[idx++] = x0;
+          coordinates[idx++] = y0;
+          (*length)++;
+          // note: since endpoint is out of grid, no need to check if endpoint is reached
+          int e2 = 2 * err;
+          if (e2 >= dy) { err += dy; x0 += sx; }
+          if (e2 <= dx) { err += dx; y0 += sy; }
+        }
+      }
+
+      // fill up the shorter line with missing coordinates, so block filling works correctly and efficiently
+      int diff = lineLength[0] - lineLength[1];
+      int longLineIdx = (diff > 0) ? 0 : 1;
+      int shortLineIdx = longLineIdx ? 0 : 1;
+      if (diff != 0) {
+        int idx = (lineLength[shortLineIdx] - 1) * 2; // last valid coordinate index
+        int lastX = lineCoords[shortLineIdx][idx++];
+        int lastY = lineCoords[shortLineIdx][idx++];
+        bool keepX = lastX == 0 || lastX == vW - 1;
+        for (int d = 0; d < abs(diff); d++) {
+          lineCoords[shortLineIdx][idx] = keepX ? lastX :lineCoords[longLineIdx][idx];
+          idx++;
+          lineCoords[shortLineIdx][idx] =  keepX ? lineCoords[longLineIdx][idx] : lastY;
+          idx++;
+        }
+      }
+
+      // block-fill the line coordinates. Note: block filling only efficient if angle between lines is small
+      closestEdgeIdx += 2;
+      for (int idx = 0; idx < lineLength[longLineIdx] * 2;) {
+        int x1 = lineCoords[0][idx];
+        int x2 = lineCoords[1][idx++];
+        int y1 = lineCoords[0][idx];
+        int y2 = lineCoords[1][idx++];
+        int minX, maxX, minY, maxY;
+        (x1 < x2) ? (minX = x1, maxX = x2) : (minX = x2, maxX = x1);
+        (y1 < y2) ? (minY = y1, maxY = y2) : (minY = y2, maxY = y1);
+
+        // fill the block between the two x,y points
+        bool alwaysDraw = (idx > closestEdgeIdx) || // Edge pixels on uneven lines are always drawn
+                          (i == 0 && idx == 2);     // Center pixel special case
+        for (int x = minX; x <= maxX; x++) {
+          for (int y = minY; y <= maxY; y++) {
+            if (!inside(x, y)) continue;
+            bool onLine1 = x == x1 && y == y1;
+            bool onLine2 = x == x2 && y == y2;
+            emit(x, y, alwaysDraw ? GM_ALWAYS : uint8_t((onLine1 ? GM_FIRST : 0) | (onLine2 ? GM_LAST : 0)));
+          }
+        }
+      }
+      break;
+    }
+  }
+}
+
+// pixel returned by getPixelColor() for virtual pixel i expanded onto vW x vH (M12_pArc, M12_pCorner & M12_sPinwheel)
+static void getExpandedReadXY(uint8_t mapping, int i, int vW, int vH, int &x, int &y) {
+  x = y = 0;
+  switch (mapping) {
+    case M12_pArc:
+      if (i > vW && i > vH) {
+        x = y = sqrt32_bw(i*i/2);
+        break; // use diagonal
+      }
+      // otherwise fallthrough
+    case M12_pCorner:
+      // use longest dimension
+      if (vW > vH) x = i;
+      else         y = i;
+      break;
+    case M12_sPinwheel: {
+      // not 100% accurate, returns pixel at outer edge
+      int cosVal[2], sinVal[2];
+      setPinwheelParameters(i, vW, vH, x, y, cosVal, sinVal, true);
+      int maxX = (vW-1) * Fixed_Scale;
+      int maxY = (vH-1) * Fixed_Scale;
+      // trace ray from center until we hit any edge - to avoid rounding problems, we use fixed point coordinates
+      while ((x < maxX)  && (y < maxY) && (x > Fixed_Scale) && (y > Fixed_Scale)) {
+        x += cosVal[0]; // advance to next position
+        y += sinVal[0];
+      }
+      x /= Fixed_Scale;
+      y /= Fixed_Scale;
+      break;
+    }
+  }
+}
+
+/*
+ * Geometry map: arc, corner and pinwheel expansions trace the same shapes every time a virtual pixel is set, which
+ * dominates rendering of 1D effects on 2D segments. The pixel buffer indices of each shape are traced once and cached
+ * (in PSRAM if available), grouped by draw category. The map is keyed on virtual dimensions and mapping and is freed
+ * when segment geometry changes. If there is not enough RAM, setPixelColor() keeps tracing shapes.
+ */
+void Segment::freeGeometryMap() const {
+  if (_geomMap) {
+    p_free(_geomMap);
+    _geomMap = nullptr;
+  }
+}
+
+const Segment::GeometryMap *Segment::getGeometryMap(int vW, int vH) const {
+  if (_geomMap && _geomMap->vWidth == vW && _geomMap->vHeight == vH && _geomMap->mapping == map1D2D) return _geomMap;
+  freeGeometryMap();
+  const unsigned vLen = vLength();
+  if (_geomMapFailed || vLen == 0 || vW * vH >= 0xFFFF) return nullptr; // indices are 16 bit
+
+  // pixels are emitted multiple times (arc symmetry, overlapping pinwheel blocks), keep only the first in each run
+  uint16_t *stamp = static_cast<uint16_t *>(allocate_buffer(vW * vH * sizeof(uint16_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_CLEAR));
+  if (!stamp) {
+    _geomMapFailed = true;
+    return nullptr;
+  }
+  // run r = i*4 + category, stamp holds last run + 1 that contained the pixel
+  const unsigned lastCat = map1D2D == M12_sPinwheel ? GM_BOTH : GM_ALWAYS; // only pinwheel uses other categories
+  const auto collect = [&](uint16_t *indices) -> size_t {
+    size_t count = 0;
+    for (unsigned i = 0; i < vLen; i++) {
+      for (unsigned cat = GM_ALWAYS; cat <= GM_BOTH; cat++) {
+        if (indices) _geomMap->runs[i*4 + cat] = count;
+        if (cat > lastCat) continue;
+        forEachExpandedPixel(map1D2D, i, vW, vH, [&](int x, int y, uint8_t c) {
+          const unsigned idx = x + y * vW;
+          if (c != cat || stamp[idx] == i*4 + cat + 1) return;
+          stamp[idx] = i*4 + cat + 1;
+          if (indices) indices[count] = idx;
+          count++;
+        });
+      }
+    }
+    return count;
+  };
+
+  // first pass counts pixels, second fills the tables
+  const size_t count = collect(nullptr);
+  const size_t runsSize = (vLen*4 + 1) * sizeof(uint32_t);
+  const size_t size = sizeof(GeometryMap) + runsSize + vLen * sizeof(uint16_t) + count * sizeof(uint16_t);
+  _geomMap = static_cast<GeometryMap *>(allocate_buffer(size, BFRALLOC_PREFER_PSRAM));
+  if (!_geomMap) {
+    p_free(stamp);
+    _geomMapFailed = true;
+    return nullptr;
+  }
+  _geomMap->vWidth    = vW;
+  _geomMap->vHeight   = vH;
+  _geomMap->mapping   = map1D2D;
+  _geomMap->vLength   = vLen;
+  _geomMap->size      = size;
+  _geomMap->runs      = reinterpret_cast<uint32_t *>(_geomMap + 1);
+  _geomMap->readIndex = reinterpret_cast<uint16_t *>(_geomMap->runs + vLen*4 + 1);
+  _geomMap->indices   = _geomMap->readIndex + vLen;
+  memset(stamp, 0, vW * vH * sizeof(uint16_t));
+  _geomMap->runs[vLen*4] = collect(_geomMap->indices);
+  p_free(stamp);
+
+  for (unsigned i = 0; i < vLen; i++) {
+    int x, y;
+    getExpandedReadXY(map1D2D, i, vW, vH, x, y);
+    _geomMap->readIndex[i] = ((unsigned)x < (unsigned)vW && (unsigned)y < (unsigned)vH) ? x + y * vW : 0xFFFF;
+  }
+  return _geomMap;
+}
+#else
+void Segment::freeGeometryMap() const {}
 #endif
 
 // 1D strip
@@ -732,132 +1020,32 @@ void IRAM_ATTR_YN Segment::setPixelColor(int i, uint32_t col) const
         else for (int x = 0; x < vW; x++) setPixelColorRaw(XY(x, vH - i - 1), col);
         break;
       case M12_pArc:
-        // expand in circular fashion from center
-        if (i == 0)
-          setPixelColorRaw(XY(0, 0), col);
-        else {
-          float r = i;
-          float step = HALF_PI / (2.8284f * r + 4); // we only need (PI/4)/(r/sqrt(2)+1) steps
-          for (float rad = 0.0f; rad <= (HALF_PI/2)+step/2; rad += step) {
-            int x = roundf(sin_t(rad) * r);
-            int y = roundf(cos_t(rad) * r);
-            // exploit symmetry
-            setPixelColorXY(x, y, col);
-            setPixelColorXY(y, x, col);
-          }
-          // Bresenham’s Algorithm (may not fill every pixel)
-          //int d = 3 - (2*i);
-          //int y = i, x = 0;
-          //while (y >= x) {
-          //  setPixelColorXY(x, y, col);
-          //  setPixelColorXY(y, x, col);
-          //  x++;
-          //  if (d > 0) {
-          //    y--;
-          //    d += 4 * (x - y) + 10;
-          //  } else {
-          //    d += 4 * x + 6;
-          //  }
-          //}
-        }
-        break;
       case M12_pCorner:
-        for (int x = 0; x <= i; x++) setPixelColorXY(x, i, col); // note: <= to include i=0. Relies on overflow check in sPC()
-        for (int y = 0; y <  i; y++) setPixelColorXY(i, y, col);
-        break;
       case M12_sPinwheel: {
-        // Uses Bresenham's algorithm to place coordinates of two lines in arrays then draws between them
-        int startX, startY, cosVal[2], sinVal[2]; // in fixed point scale
-        setPinwheelParameters(i, vW, vH, startX, startY, cosVal, sinVal);
-
-        unsigned maxLineLength = max(vW, vH) + 2; // pixels drawn is always smaller than dx or dy, +1 pair for rounding errors
-        uint16_t lineCoords[2][maxLineLength];    // uint16_t to save ram
-        int lineLength[2] = {0};
-
-        static int prevRays[2] = {INT_MAX, INT_MAX}; // previous two ray numbers
-        int closestEdgeIdx = INT_MAX; // index of the closest edge pixel
-
-        for (int lineNr = 0; lineNr < 2; lineNr++) {
-          int x0 = startX; // x, y coordinates in fixed scale
-          int y0 = startY;
-          int x1 = (startX + (cosVal[lineNr] << 9)); // outside of grid
-          int y1 = (startY + (sinVal[lineNr] << 9)); // outside of grid
-          const int dx =  abs(x1-x0), sx = x0<x1 ? 1 : -1; // x distance & step
-          const int dy = -abs(y1-y0), sy = y0<y1 ? 1 : -1; // y distance & step
-          uint16_t* coordinates = lineCoords[lineNr]; // 1D access is faster
-          int* length = &lineLength[lineNr];          // faster access
-          x0 /= Fixed_Scale; // convert to pixel coordinates
-          y0 /= Fixed_Scale;
-
-          // Bresenham's algorithm
-          int idx = 0;
-          int err = dx + dy;
-          while (true) {
-            if ((unsigned)x0 >= (unsigned)vW || (unsigned)y0 >= (unsigned)vH) {
-              closestEdgeIdx = min(closestEdgeIdx, idx-2);
-              break; // stop if outside of grid (exploit unsigned int overflow)
-            }
-            coordinates[idx++] = x0;
-            coordinates[idx++] = y0;
-            (*length)++;
-            // note: since endpoint is out of grid, no need to check if endpoint is reached
-            int e2 = 2 * err;
-            if (e2 >= dy) { err += dy; x0 += sx; }
-            if (e2 <= dx) { err += dx; y0 += sy; }
-          }
+        // pinwheel rays skip pixels shared with the adjacent ray drawn just before (unless drawn twice in a frame)
+        static struct { int rays[2] = {INT_MAX, INT_MAX}; } prevRaysTask[WLED_RENDER_TASKS]; // previous two ray numbers (of each render task)
+        int *prevRays = prevRaysTask[RENDER_TASK_ID].rays;
+        bool drawFirst = true, drawLast = true;
+        if (map1D2D == M12_sPinwheel) {
+          int max_i = getPinwheelLength(vW, vH) - 1;
+          drawFirst = !(prevRays[0] == i - 1 || (i == 0 && prevRays[0] == max_i)); // draw first line if previous ray was not adjacent including wrap
+          drawLast  = !(prevRays[0] == i + 1 || (i == max_i && prevRays[0] == 0)); // same as above for last line
         }
-
-        // fill up the shorter line with missing coordinates, so block filling works correctly and efficiently
-        int diff = lineLength[0] - lineLength[1];
-        int longLineIdx = (diff > 0) ? 0 : 1;
-        int shortLineIdx = longLineIdx ? 0 : 1;
-        if (diff != 0) {
-          int idx = (lineLength[shortLineIdx] - 1) * 2; // last valid coordinate index
-          int lastX = lineCoords[shortLineIdx][idx++];
-          int lastY = lineCoords[shortLineIdx][idx++];
-          bool keepX = lastX == 0 || lastX == vW - 1;
-          for (int d = 0; d < abs(diff); d++) {
-            lineCoords[shortLineIdx][idx] = keepX ? lastX :lineCoords[longLineIdx][idx];
-            idx++;
-            lineCoords[shortLineIdx][idx] =  keepX ? lineCoords[longLineIdx][idx] : lastY;
-            idx++;
+        const bool drawBoth = (drawFirst && drawLast) || i == prevRays[1];
+        const bool drawCat[4] = { true, drawFirst || drawBoth, drawLast || drawBoth, drawBoth }; // indexed by GM_ALWAYS..GM_BOTH
+        if (const GeometryMap *map = getGeometryMap(vW, vH)) {
+          const uint32_t *run = &map->runs[i*4];
+          for (unsigned cat = GM_ALWAYS; cat <= GM_BOTH; cat++) {
+            if (!drawCat[cat]) continue;
+            for (unsigned k = run[cat]; k < run[cat+1]; k++) setPixelColorRaw(map->indices[k], col);
           }
+        } else {
+          forEachExpandedPixel(map1D2D, i, vW, vH, [&](int x, int y, uint8_t cat) { if (drawCat[cat]) setPixelColorXYRaw(x, y, col); });
         }
-
-        // draw and block-fill the line coordinates. Note: block filling only efficient if angle between lines is small
-        closestEdgeIdx += 2;
-        int max_i = getPinwheelLength(vW, vH) - 1;
-        bool drawFirst = !(prevRays[0] == i - 1 || (i == 0 && prevRays[0] == max_i)); // draw first line if previous ray was not adjacent including wrap
-        bool drawLast  = !(prevRays[0] == i + 1 || (i == max_i && prevRays[0] == 0)); // same as above for last line
-        for (int idx = 0; idx < lineLength[longLineIdx] * 2;) { //!! should be long line idx!
-          int x1 = lineCoords[0][idx];
-          int x2 = lineCoords[1][idx++];
-          int y1 = lineCoords[0][idx];
-          int y2 = lineCoords[1][idx++];
-          int minX, maxX, minY, maxY;
-          (x1 < x2) ? (minX = x1, maxX = x2) : (minX = x2, maxX = x1);
-          (y1 < y2) ? (minY = y1, maxY = y2) : (minY = y2, maxY = y1);
-
-          // fill the block between the two x,y points
-          bool alwaysDraw = (drawFirst && drawLast) || // No adjacent rays, draw all pixels
-                            (idx > closestEdgeIdx)  || // Edge pixels on uneven lines are always drawn
-                            (i == 0 && idx == 2)    || // Center pixel special case
-                            (i == prevRays[1]);        // Effect drawing twice in 1 frame
-          for (int x = minX; x <= maxX; x++) {
-            for (int y = minY; y <= maxY; y++) {
-              bool onLine1 = x == x1 && y == y1;
-              bool onLine2 = x == x2 && y == y2;
-              if ((alwaysDraw) ||
-                  (!onLine1 && (!onLine2 || drawLast))  || // Middle pixels and line2 if drawLast
-                  (!onLine2 && (!onLine1 || drawFirst))    // Middle pixels and line1 if drawFirst
-                ) {
-                setPixelColorXY(x, y, col);
-              }
-            }
-          }
+        if (map1D2D == M12_sPinwheel) {
+          prevRays[1] = prevRays[0];
+          prevRays[0] = i;
         }
-        prevRays[1] = prevRays[0];
-        prevRays[0] = i;
         break;
       }
     }
@@ -876,6 +1064,67 @@ void IRAM_ATTR_YN Segment::setPixelColor(int i, uint32_t col) const
   setPixelColorRaw(i, col);
 }
 
+/*
+ * Span drawing: same mapping as setPixelColor()/getPixelColor() for n consecutive virtual pixels, but the
+ * virtual-strip, 1D->2D expansion and bounds checks are resolved once per span instead of once per pixel.
+ * 1D segments and M12_Pixels expansion use the pixel buffer as a strip, M12_pBar writes rows (or a single column
+ * for virtual strips), other expansions draw shapes and fall back to setPixelColor().
+ */
+template<typename ColorAt>
+void Segment::putSpan(int i, unsigned n, ColorAt colorAt) const {
+  if (!isActive() || i < 0 || n == 0) return; // not active or invalid index
+#ifndef WLED_DISABLE_2D
+  int vStrip = 0;
+#endif
+  const int vL = vLength();
+  if (i >= vL) {
+    #ifndef WLED_DISABLE_2D
+    vStrip = i>>16; // virtual strip (see setPixelColor())
+    #endif
+    i &= 0xFFFF;
+    if (i >= vL) return;
+  }
+  n = std::min(n, unsigned(vL - i));
+#ifndef WLED_DISABLE_2D
+  if (is2D() && map1D2D != M12_Pixels) {
+    const int vW = vWidth();
+    const int vH = vHeight();
+    if (map1D2D == M12_pBar) {
+      for (unsigned k = 0; k < n; k++) {
+        uint32_t *row = pixels + (vH - i - int(k) - 1) * vW; // bar grows from the bottom
+        if (vStrip > 0) row[vStrip - 1] = colorAt(k);
+        else            std::fill_n(row, vW, colorAt(k));
+      }
+      _dirty = true;
+    } else {
+      for (unsigned k = 0; k < n; k++) setPixelColor(i + int(k), colorAt(k));
+    }
+    return;
+  }
+#endif
+  uint32_t *px = pixels + i;
+  for (unsigned k = 0; k < n; k++) px[k] = colorAt(k);
+  _dirty = true;
+}
+
+void Segment::writeSpan(int i, const uint32_t *c, unsigned n) const {
+  putSpan(i, n, [c](unsigned k) { return c[k]; });
+}
+
+void Segment::fillSpan(int i, uint32_t c, unsigned n) const {
+  putSpan(i, n, [c](unsigned) { return c; });
+}
+
+void Segment::readSpan(int i, uint32_t *c, unsigned n) const {
+#ifndef WLED_DISABLE_2D
+  const bool isStrip = !is2D() || map1D2D == M12_Pixels;
+#else
+  const bool isStrip = true;
+#endif
+  if (isActive() && isStrip && i >= 0 && i + n <= vLength()) memcpy(c, pixels + i, n * sizeof(uint32_t));
+  else for (unsigned k = 0; k < n; k++) c[k] = getPixelColor(i + int(k));
+}
+
 #ifdef WLED_USE_AA_PIXELS
 // anti-aliased normalized version of setPixelColor()
 void Segment::setPixelColor(float i, uint32_t col, bool aa) const
@@ -936,31 +1185,14 @@ uint32_t IRAM_ATTR_YN Segment::getPixelColor(int i) const
         else            { y = vH - i - 1; };
         break;
       case M12_pArc:
-        if (i > vW && i > vH) {
-          x = y = sqrt32_bw(i*i/2);
-          break; // use diagonal
-        }
-        // otherwise fallthrough
       case M12_pCorner:
-        // use longest dimension
-        if (vW > vH) x = i;
-        else         y = i;
-        break;
-      case M12_sPinwheel: {
-        // not 100% accurate, returns pixel at outer edge
-        int cosVal[2], sinVal[2];
-        setPinwheelParameters(i, vW, vH, x, y, cosVal, sinVal, true);
-        int maxX = (vW-1) * Fixed_Scale;
-        int maxY = (vH-1) * Fixed_Scale;
-        // trace ray from center until we hit any edge - to avoid rounding problems, we use fixed point coordinates
-        while ((x < maxX)  && (y < maxY) && (x > Fixed_Scale) && (y > Fixed_Scale)) {
-          x += cosVal[0]; // advance to next position
-          y += sinVal[0];
+      case M12_sPinwheel:
+        if (const GeometryMap *map = getGeometryMap(vW, vH)) {
+          const unsigned idx = map->readIndex[i];
+          return idx == 0xFFFF ? 0 : getPixelColorRaw(idx);
         }
-        x /= Fixed_Scale;
-        y /= Fixed_Scale;
+        getExpandedReadXY(map1D2D, i, vW, vH, x, y);
         break;
-      }
     }
     return getPixelColorXY(x, y);
   }
@@ -1008,7 +1240,9 @@ void Segment::refreshLightCapabilities() const {
  */
 void Segment::fill(uint32_t c) const {
   if (!isActive()) return; // not active
-  for (unsigned i = 0; i < length(); i++) setPixelColorRaw(i,c); // always fill all pixels (blending will take care of grouping, spacing and clipping)
+  // always fill all pixels (blending will take care of grouping, spacing and clipping)
+  // but only touch changed ones so that repeatedly filled (static) segments do not need re-blending
+  for (unsigned i = 0; i < length(); i++) if (getPixelColorRaw(i) != c) setPixelColorRaw(i,c);
 }
 
 /*
@@ -1020,37 +1254,19 @@ void Segment::fade_out(uint8_t rate) const {
   if (!isActive()) return; // not active
   rate = (256-rate) >> 1;
   const int mappedRate = 256 / (rate + 1);
-  const size_t rlength = rawLength();  // calculate only once
-  for (unsigned j = 0; j < rlength; j++) {
-    uint32_t color = getPixelColorRaw(j);
-    if (color == colors[1]) continue; // already at target color
-    for (int i = 0; i < 32; i += 8) {
-      uint8_t c2 = (colors[1]>>i);  // get background channel
-      uint8_t c1 = (color>>i);      // get foreground channel
-      // we can't use bitshift since we are using int
-      int delta = (c2 - c1) * mappedRate / 256;
-      // if fade isn't complete, make sure delta is at least 1 (fixes rounding issues)
-      if (delta == 0) delta += (c2 == c1) ? 0 : (c2 > c1) ? 1 : -1;
-      // stuff new value back into color
-      color &= ~(0xFF<<i);
-      color |= ((c1 + delta) & 0xFF) << i;
-    }
-    setPixelColorRaw(j, color);
-  }
+  if (fade_toward_span(pixels, rawLength(), colors[1], mappedRate)) _dirty = true;
 }
 
 // fades all pixels to secondary color
 void Segment::fadeToSecondaryBy(uint8_t fadeBy) const {
   if (!isActive() || fadeBy == 0) return;   // optimization - no scaling to apply
-  const size_t rlength = rawLength();  // calculate only once
-  for (unsigned i = 0; i < rlength; i++) setPixelColorRaw(i, color_blend(getPixelColorRaw(i), colors[1], fadeBy));
+  if (blend_span(pixels, rawLength(), colors[1], fadeBy)) _dirty = true;
 }
 
 // fades all pixels to black using nscale8()
 void Segment::fadeToBlackBy(uint8_t fadeBy) const {
   if (!isActive() || fadeBy == 0) return;   // optimization - no scaling to apply
-  const size_t rlength = rawLength();  // calculate only once
-  for (unsigned i = 0; i < rlength; i++) setPixelColorRaw(i, color_fade(getPixelColorRaw(i), 255-fadeBy));
+  if (fade_span(pixels, rawLength(), 256-fadeBy)) _dirty = true; // same as color_fade(c, 255-fadeBy)
 }
 
 /*
@@ -1067,28 +1283,9 @@ void Segment::blur(uint8_t blur_amount, bool smear) const {
     return;
   }
 #endif
-  uint8_t keep = smear ? 255 : 255 - blur_amount;
-  uint8_t seep = blur_amount >> 1;
-  unsigned vlength = vLength();
-  uint32_t carryover = BLACK;
-  uint32_t lastnew; // not necessary to initialize lastnew and last, as both will be initialized by the first loop iteration
-  uint32_t last;
-  uint32_t curnew = BLACK;
-  for (unsigned i = 0; i < vlength; i++) {
-    uint32_t cur = getPixelColorRaw(i);
-    uint32_t part = color_fade(cur, seep);
-    curnew = color_fade(cur, keep);
-    if (i > 0) {
-      if (carryover) curnew = color_add(curnew, carryover);
-      uint32_t prev = color_add(lastnew, part);
-      // optimization: only set pixel if color has changed
-      if (last != prev) setPixelColorRaw(i - 1, prev);
-    } else setPixelColorRaw(i, curnew); // first pixel
-    lastnew = curnew;
-    last = cur; // save original value for comparison on next iteration
-    carryover = part;
-  }
-  setPixelColorRaw(vlength - 1, curnew);
+  const unsigned keep = smear ? 255 : 255 - blur_amount;
+  const unsigned seep = blur_amount >> 1;
+  blur_span(getPixels(), vLength(), 1, keep + 1, seep + 1); // +1: same scaling as color_fade()
 }
 
 /*
@@ -1130,7 +1327,7 @@ uint32_t Segment::color_from_palette(uint16_t i, bool mapping, bool moving, uint
     case 1: blend = LINEARBLEND; break;
     case 2: blend = LINEARBLEND_NOWRAP; break;
   }
-  CRGBW palcol = ColorFromPalette(_currentPalette, paletteIndex, pbri, blend);
+  CRGBW palcol = ColorFromPalette(getCurrentPalette(), paletteIndex, pbri, blend);
   palcol.w = W(color);
 
   return palcol.color32;
@@ -1153,6 +1350,7 @@ void WS2812FX::finalizeInit() {
   enumerateLedmaps();
 
   _hasWhiteChannel = _isOffRefreshRequired = false;
+  waitForOutput(); // output task must not use buses while they are recreated
   BusManager::removeAll();
 
   unsigned digitalCount = 0;
@@ -1219,26 +1417,192 @@ void WS2812FX::finalizeInit() {
   deserializeMap();     // (re)load default ledmap (will also setUpMatrix() if ledmap does not exist)
 
   // allocate frame buffer after matrix has been set up (gaps!)
-  p_free(_pixels); // using realloc on large buffers can cause additional fragmentation instead of reducing it
+  // frame buffer(s) and segment pixel buffers share one arena sized for a frame buffer per stage and one set of segments covering all LEDs,
+  // segments and transitions exceeding that are allocated from heap
   // use PSRAM if available: there is no measurable perfomance impact between PSRAM and DRAM on S2/S3 with QSPI PSRAM for this buffer
-  _pixels = static_cast<uint32_t*>(allocate_buffer(getLengthTotal() * sizeof(uint32_t), BFRALLOC_ENFORCE_PSRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_CLEAR));
-  DEBUG_PRINTF_P(PSTR("strip buffer size: %uB\n"), getLengthTotal() * sizeof(uint32_t));
+  Segment::_pixelArena.release(_pixels);
+  _pixels = nullptr;
+  p_free(_pixelCCT); // CCT buffers are reallocated by show() with new length
+  _pixelCCT = nullptr;
+#ifdef WLED_PIPELINED_OUTPUT
+  Segment::_pixelArena.release(_outPixels);
+  _outPixels = nullptr;
+  p_free(_outCCT);
+  _outCCT = nullptr;
+  constexpr size_t frameBuffers = 2;
+#else
+  constexpr size_t frameBuffers = 1;
+#endif
+  Segment::_pixelArena.resize(getLengthTotal() * (frameBuffers * sizeof(pixel_t) + sizeof(uint32_t)) + (MAX_NUM_SEGMENTS + frameBuffers) * BufferArena::BLOCK_OVERHEAD);
+  Segment::_dataArena.resize(SEGMENT_DATA_ARENA);
+  _pixels = static_cast<pixel_t*>(Segment::_pixelArena.allocate(getLengthTotal() * sizeof(pixel_t), reinterpret_cast<void**>(&_pixels), true));
+  _frameValid = false;
+  DEBUG_PRINTF_P(PSTR("strip buffer size: %uB\n"), getLengthTotal() * sizeof(pixel_t));
+#ifdef WLED_PIPELINED_OUTPUT
+  // second frame buffer for output task, if it cannot be allocated frames are sent from show() as usual
+  _outPixels = static_cast<pixel_t*>(Segment::_pixelArena.allocate(getLengthTotal() * sizeof(pixel_t), reinterpret_cast<void**>(&_outPixels)));
+  if (!_outputTask && _outPixels) {
+    _outputIdle = xSemaphoreCreateBinary();
+    if (_outputIdle) {
+      xSemaphoreGive(_outputIdle);
+      // run output on the core that is not rendering (Arduino loop)
+      xTaskCreatePinnedToCore(outputTask, "WLED_OUT", 4096, this, 2, &_outputTask, xPortGetCoreID() ? 0 : 1);
+    }
+    if (!_outputTask) DEBUG_PRINTLN(F("Error: Failed to create output task."));
+  }
+  DEBUG_PRINTF_P(PSTR("Output pipeline: %s\n"), isPipelined() ? "on" : "off");
+#endif
+#ifdef WLED_PARALLEL_RENDER
+  if (!_renderTask) {
+    _renderDone = xSemaphoreCreateBinary();
+    // render on the core that is not running the Arduino loop, same stack size as loop task as it runs effect functions
+    if (_renderDone) xTaskCreatePinnedToCore(renderTask, "WLED_FX", 8192, this, 1, &_renderTask, xPortGetCoreID() ? 0 : 1);
+    if (!_renderTask) DEBUG_PRINTLN(F("Error: Failed to create render task."));
+  }
+#endif
   DEBUG_PRINTF_P(PSTR("Heap after strip init: %uB\n"), getFreeHeapSize());
 }
 
+// moving average of stage times (us)
+static inline void updateStageTime(uint32_t &avg, uint32_t us) {
+  avg = (avg * 7 + us + 4) >> 3;
+}
+
+// frame profile fields are 16 bit (us)
+static inline uint16_t profileTime(uint32_t us) {
+  return us > UINT16_MAX ? UINT16_MAX : us;
+}
+
+// records time spent in effect function of segment (called by render tasks)
+void WS2812FX::profileEffect(unsigned index, uint8_t mode, uint32_t us) {
+#ifdef WLED_PARALLEL_RENDER
+  std::lock_guard<std::mutex> lock(_profileLock);
+#endif
+  _frameProfile.segments++;
+  if (index < MAX_NUM_SEGMENTS) _segmentTime[index] = (_segmentTime[index] * 7U + profileTime(us) + 4) >> 3;
+  if (mode >= _effectCostCount && mode < _mode.size()) {
+    // effect table is allocated on first use and grows if effects were added later (usermods)
+    EffectCost *cost = static_cast<EffectCost*>(p_calloc(_mode.size(), sizeof(EffectCost)));
+    if (!cost) return;
+    if (_effectCost) memcpy(cost, _effectCost, _effectCostCount * sizeof(EffectCost));
+    p_free(_effectCost);
+    _effectCost      = cost;
+    _effectCostCount = _mode.size();
+  }
+  if (mode >= _effectCostCount) return;
+  EffectCost &cost = _effectCost[mode];
+  if (cost.runs >= 0x00FFFFFFU || cost.time >= 0x7FFFFFFFU - us) { // keep counters from overflowing, average is retained
+    cost.time >>= 1;
+    cost.runs >>= 1;
+  }
+  cost.time += us;
+  cost.runs++;
+}
+
+// adaptive frame rate governor: lowers frame rate when rendering (effects, blending and output unless pipelined)
+// takes more than GOVERNOR_LOAD % of frame time and raises it again when there is headroom
+// this keeps frame pacing even (instead of dropping random frames) and leaves time for network in Arduino loop
+void WS2812FX::governFrameRate() {
+  if (!fpsGovernor || _targetFps == FPS_UNLIMITED) {
+    _governedFrametime = _frametime;
+    _governorHeadroom  = 0;
+    return;
+  }
+  uint32_t cost = _stageTimes.effects + _stageTimes.composite + _stageTimes.wait; // us, moving averages
+  if (!isPipelined()) cost += _stageTimes.output; // output task renders in parallel
+  unsigned needed = (cost * 100 / GOVERNOR_LOAD + 999) / 1000; // ms
+  needed = max(min(needed, (unsigned)GOVERNOR_MAX_FRAMETIME), (unsigned)_frametime);
+  if (needed > _governedFrametime) {
+    _governedFrametime = needed; // back off immediately
+    _governorHeadroom  = 0;
+  } else if (needed == _governedFrametime) {
+    _governorHeadroom  = 0;
+  } else if (++_governorHeadroom >= GOVERNOR_RECOVERY) {
+    _governedFrametime -= (_governedFrametime - needed + 3) / 4; // recover gradually
+    _governorHeadroom   = 0;
+  }
+}
+
+// adds frame to profiler history (called after frame was sent)
+void WS2812FX::commitFrameProfile(FrameProfile &profile) {
+  profile.frame = _frameCount;
+  _frameLog[_frameCount % WLED_PERF_FRAMES] = profile;
+  _frameCount++;
+}
+
+// if segment is in transition and no old segment exists we don't need to run the old mode
+// (blendSegments() takes care of On/Off transitions and clipping)
+bool WS2812FX::needsOldModeRun(const Segment &seg) const {
+  const Segment *segO = seg.getOldSegment();
+  return segO && segO->isActive() && (seg.mode != segO->mode || blendingStyle != BLEND_STYLE_FADE ||
+         (segO->name != seg.name && segO->name && seg.name && strncmp(segO->name, seg.name, WLED_MAX_SEGNAME_LEN) != 0));
+}
+
+// runs current mode of segment (or old mode of segment in transition) on calling render task
+unsigned WS2812FX::renderSegment(Segment &seg, unsigned index, bool oldMode) {
+  const unsigned task = RENDER_TASK_ID;
+  // Effect blending
+  uint16_t prog = seg.progress();
+  Segment *run = oldMode ? seg.getOldSegment() : &seg;
+  if (oldMode) Segment::modeBlend(true); // set semaphore for beginDraw() to blend colors and palette
+  run->beginDraw(prog);                  // set up parameters for get/setPixelColor() (will also blend colors and palette if blend style is FADE), old segment uses parent's progress
+  _currentSegment[task] = run;           // set current segment for effect functions (SEGMENT & SEGENV)
+  _segment_index[task]  = index;
+  // workaround for on/off transition to respect blending style
+  unsigned long start = micros();
+  unsigned frameDelay = (*_mode[run->mode])(); // run new/current or old mode (needed for bri workaround; semaphore!!)
+  profileEffect(index, run->mode, micros() - start);
+  run->call++;                           // increment mode run counter
+  if (oldMode) Segment::modeBlend(false); // unset semaphore
+  return frameDelay;
+}
+
+#ifdef WLED_PARALLEL_RENDER
+// claims and renders parallel jobs until there are none left (called by both render tasks)
+void WS2812FX::renderParallelJobs() {
+  for (unsigned j = _nextParallelJob++; j < _numParallelJobs; j = _nextParallelJob++) {
+    RenderJob &job = _renderJobs[j];
+    job.frameDelay = _suspend ? FRAMETIME : renderSegment(*job.seg, job.index, job.oldMode);
+  }
+}
+
+// render task: helps Arduino loop with rendering segments during service()
+void WS2812FX::renderTask(void *arg) {
+  WS2812FX *instance = static_cast<WS2812FX*>(arg);
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // wait for service()
+    instance->renderParallelJobs();
+    xSemaphoreGive(instance->_renderDone);
+  }
+}
+#endif
+
 void WS2812FX::service() {
   unsigned long nowUp = millis(); // Be aware, millis() rolls over every 49 days
   now = nowUp + timebase;
   unsigned long elapsed = nowUp - _lastServiceShow;
+  if (!_suspend) pollOutput();                          // start frames of buses that were still sending at last show()
   if (_suspend || elapsed <= MIN_FRAME_DELAY) return;   // keep wifi alive - no matter if triggered or unlimited
   if (!_triggered && (_targetFps != FPS_UNLIMITED)) {   // unlimited mode = no frametime
-    if (elapsed < _frametime) return;                   // too early for service
+    if (elapsed < _governedFrametime) return;           // too early for service
   }
+  if (Segment::_pixelArena.isFragmented() || Segment::_dataArena.isFragmented()) compactBuffers(); // no effect is running yet
 
   bool doShow = false;
 
   _isServicing = true;
-  _segment_index = 0;
+  unsigned segIndex = 0;
+  unsigned long startFx = micros();
+#ifdef WLED_PARALLEL_RENDER
+  // due segments are collected as jobs first: effects that are safe to run on any core go to the front of the list,
+  // effects using shared state (audio reactive, usermods, copy) to the back where only the Arduino loop picks them up
+  unsigned numJobs = 0, firstMainJob = 2*MAX_NUM_SEGMENTS;
+  const auto addJob = [&](Segment &seg, unsigned index, bool oldMode) {
+    const uint8_t mode = oldMode ? seg.getOldSegment()->mode : seg.mode;
+    const bool mainCore = mode >= _modeMainCore.size() || _modeMainCore[mode] || !_renderTask;
+    _renderJobs[mainCore ? --firstMainJob : numJobs++] = {&seg, FRAMETIME, uint8_t(index), oldMode};
+  };
+#endif
 
   for (Segment &seg : _segments) {
     if (_suspend) break; // immediately stop processing segments if suspend requested during service()
@@ -1257,45 +1621,72 @@ void WS2812FX::service() {
       unsigned frameDelay = FRAMETIME;
 
       if (!seg.freeze) { //only run effect function if not frozen
-        // Effect blending
-        uint16_t prog = seg.progress();
-        seg.beginDraw(prog);                // set up parameters for get/setPixelColor() (will also blend colors and palette if blend style is FADE)
-        _currentSegment = &seg;             // set current segment for effect functions (SEGMENT & SEGENV)
-        // workaround for on/off transition to respect blending style
-        frameDelay = (*_mode[seg.mode])();  // run new/current mode (needed for bri workaround)
-        seg.call++;
-        // if segment is in transition and no old segment exists we don't need to run the old mode
-        // (blendSegments() takes care of On/Off transitions and clipping)
-        Segment *segO = seg.getOldSegment();
-        if (segO && segO->isActive() && (seg.mode != segO->mode || blendingStyle != BLEND_STYLE_FADE ||
-            (segO->name != seg.name && segO->name && seg.name && strncmp(segO->name, seg.name, WLED_MAX_SEGNAME_LEN) != 0))) {
-          Segment::modeBlend(true);         // set semaphore for beginDraw() to blend colors and palette
-          segO->beginDraw(prog);            // set up palette & colors (also sets draw dimensions), parent segment has transition progress
-          _currentSegment = segO;           // set current segment
-          // workaround for on/off transition to respect blending style
-          frameDelay = min(frameDelay, (unsigned)(*_mode[segO->mode])());  // run old mode (needed for bri workaround; semaphore!!)
-          segO->call++;                     // increment old mode run counter
-          Segment::modeBlend(false);        // unset semaphore
-        }
+#ifdef WLED_PARALLEL_RENDER
+        frameDelay = UINT16_MAX;            // shortest delay returned by effect functions is applied after rendering
+        addJob(seg, segIndex, false);
+        if (needsOldModeRun(seg) && !isThrottled()) addJob(seg, segIndex, true); // throttled: old effect is frozen during transition
+#else
+        frameDelay = renderSegment(seg, segIndex, false);
+        if (needsOldModeRun(seg) && !isThrottled()) frameDelay = min(frameDelay, renderSegment(seg, segIndex, true)); // throttled: old effect is frozen during transition
         if (seg.isInTransition() && frameDelay > FRAMETIME) frameDelay = FRAMETIME; // force faster updates during transition
+#endif
       }
 
       seg.next_time = nowUp + frameDelay;
     }
-    _segment_index++;
-  }
+    segIndex++;
+  }
+
+#ifdef WLED_PARALLEL_RENDER
+  const unsigned numMainJobs = 2*MAX_NUM_SEGMENTS - firstMainJob;
+  _numParallelJobs = numJobs;
+  _nextParallelJob = 0;
+  const bool shareJobs = numJobs > 0 && numJobs + numMainJobs > 1; // waking render task only pays off with 2+ jobs
+  // main core jobs (back of the list, in segment order) must never overlap the render task: jobs of segments in
+  // front of the first parallel one run before it is woken, the others after it is done (keeps order for Copy)
+  unsigned nextMainJob = 2*MAX_NUM_SEGMENTS;
+  const auto renderMainJobs = [&](unsigned beforeIndex) {
+    while (nextMainJob > firstMainJob && _renderJobs[nextMainJob - 1].index < beforeIndex) {
+      RenderJob &job = _renderJobs[--nextMainJob];
+      job.frameDelay = _suspend ? FRAMETIME : renderSegment(*job.seg, job.index, job.oldMode);
+    }
+  };
+  renderMainJobs(numJobs ? _renderJobs[0].index : UINT_MAX);
+  if (shareJobs) xTaskNotifyGive(_renderTask);
+  renderParallelJobs();                                  // help render task
+  if (shareJobs) xSemaphoreTake(_renderDone, portMAX_DELAY); // render task may still be busy with its last job
+  renderMainJobs(UINT_MAX);
+  // segment is due again after shortest delay of its current and old mode
+  const auto applyDelays = [&](unsigned first, unsigned last) {
+    for (unsigned j = first; j < last; j++) {
+      Segment &seg = *_renderJobs[j].seg;
+      unsigned frameDelay = min((unsigned)_renderJobs[j].frameDelay, unsigned(seg.next_time - nowUp));
+      if (seg.isInTransition() && frameDelay > FRAMETIME) frameDelay = FRAMETIME; // force faster updates during transition
+      seg.next_time = nowUp + frameDelay;
+    }
+  };
+  applyDelays(0, numJobs);
+  applyDelays(firstMainJob, 2*MAX_NUM_SEGMENTS);
+#endif
 
   #ifdef WLED_DEBUG
-  if ((_targetFps != FPS_UNLIMITED) && (millis() - nowUp > _frametime)) DEBUG_PRINTF_P(PSTR("Slow effects %u/%d.\n"), (unsigned)(millis()-nowUp), (int)_frametime);
+  if ((_targetFps != FPS_UNLIMITED) && (millis() - nowUp > _governedFrametime)) DEBUG_PRINTF_P(PSTR("Slow effects %u/%d.\n"), (unsigned)(millis()-nowUp), (int)_governedFrametime);
   #endif
+  if (doShow) {
+    const uint32_t fxTime = micros() - startFx;
+    updateStageTime(_stageTimes.effects, fxTime);
+    _frameProfile.effects = profileTime(fxTime);
+  }
+  if (Bus::getGlobalDithering() && _brightness) doShow = true; // temporal dithering needs output at full frame rate even if no segment was due
   if (doShow && !_suspend) {
     yield();
     Segment::handleRandomPalette(); // slowly transition random palette; move it into for loop when each segment has individual random palette
     _lastServiceShow = nowUp; // update timestamp, for precise FPS control
     show();
+    governFrameRate();
   }
   #ifdef WLED_DEBUG
-  if ((_targetFps != FPS_UNLIMITED) && (millis() - nowUp > _frametime)) DEBUG_PRINTF_P(PSTR("Slow strip %u/%d.\n"), (unsigned)(millis()-nowUp), (int)_frametime);
+  if ((_targetFps != FPS_UNLIMITED) && (millis() - nowUp > _governedFrametime)) DEBUG_PRINTF_P(PSTR("Slow strip %u/%d.\n"), (unsigned)(millis()-nowUp), (int)_governedFrametime);
   #endif
 
   _triggered = false;
@@ -1328,6 +1719,40 @@ static uint8_t _softlight (uint8_t a, uint8_t b) { return (b * b * (255 - 2 * a)
 static uint8_t _dodge     (uint8_t a, uint8_t b) { return _divide(~a,b); }
 static uint8_t _burn      (uint8_t a, uint8_t b) { return ~_divide(a,~b); }
 
+// per pixel blend operator for blend mode OP (top layer a, bottom layer b), inlined into span kernels below
+// simple modes use packed versions that process all 4 channels at once (see color_kernels.h)
+template<uint8_t (*OP)(uint8_t, uint8_t)> struct BlendOp {
+  static inline uint32_t apply(uint32_t a, uint32_t b) { return RGBW32(OP(R(a),R(b)), OP(G(a),G(b)), OP(B(a),B(b)), OP(W(a),W(b))); }
+};
+template<> struct BlendOp<_add>      { static inline uint32_t apply(uint32_t a, uint32_t b) { return packed_add(a, b); } };
+template<> struct BlendOp<_subtract> { static inline uint32_t apply(uint32_t a, uint32_t b) { return packed_sub(b, a); } };
+template<> struct BlendOp<_average>  { static inline uint32_t apply(uint32_t a, uint32_t b) { return packed_average(a, b); } };
+
+// blends n pixels of segment buffer (src, advancing by step) into frame buffer (dst) using blend mode OP and opacity
+// with WLED_PIXEL16 opacity is applied with 16 bit precision, blend modes other than top operate on 8 bit colors
+typedef void (*BlendSpanFunc)(pixel_t *dst, const uint32_t *src, int step, unsigned n, uint8_t opacity);
+template<uint8_t (*OP)(uint8_t, uint8_t)>
+static void blendSpan(pixel_t *dst, const uint32_t *src, int step, unsigned n, uint8_t opacity) {
+  if (opacity == 255) for (unsigned i = 0; i < n; i++, src += step) dst[i] = toPixel(BlendOp<OP>::apply(*src, fromPixel(dst[i])));
+  else                for (unsigned i = 0; i < n; i++, src += step) dst[i] = pixel_blend(dst[i], toPixel(BlendOp<OP>::apply(*src, fromPixel(dst[i]))), opacity);
+}
+template<>
+void blendSpan<_top>(pixel_t *dst, const uint32_t *src, int step, unsigned n, uint8_t opacity) {
+  if (opacity == 255 && step == 1 && sizeof(pixel_t) == sizeof(uint32_t)) memcpy(dst, src, n * sizeof(uint32_t));
+  else if (opacity == 255)         for (unsigned i = 0; i < n; i++, src += step) dst[i] = toPixel(*src);
+  else                             for (unsigned i = 0; i < n; i++, src += step) dst[i] = pixel_blend(dst[i], toPixel(*src), opacity);
+}
+#ifndef WLED_PIXEL16
+template<>
+void blendSpan<_add>(pixel_t *dst, const uint32_t *src, int step, unsigned n, uint8_t opacity) {
+  if (opacity == 255 && step == 1) add_span(dst, src, n);
+  else if (opacity == 255)         for (unsigned i = 0; i < n; i++, src += step) dst[i] = packed_add(*src, dst[i]);
+  else                             for (unsigned i = 0; i < n; i++, src += step) dst[i] = packed_blend(dst[i], packed_add(*src, dst[i]), opacity);
+}
+#endif
+template<>
+void blendSpan<_bottom>(pixel_t *dst, const uint32_t *src, int step, unsigned n, uint8_t opacity) {} // bottom layer is kept as is
+
 void WS2812FX::blendSegment(const Segment &topSegment) const {
 
   typedef uint8_t(*FuncType)(uint8_t, uint8_t);
@@ -1340,7 +1765,8 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
 
   const size_t blendMode = topSegment.blendMode < (sizeof(funcs) / sizeof(FuncType)) ? topSegment.blendMode : 0;
   const auto func  = funcs[blendMode]; // blendMode % (sizeof(funcs) / sizeof(FuncType))
-  const auto blend = [&](uint32_t top, uint32_t bottom){ return RGBW32(func(R(top),R(bottom)), func(G(top),G(bottom)), func(B(top),B(bottom)), func(W(top),W(bottom))); };
+  const auto blend8 = [&](uint32_t top, uint32_t bottom){ return RGBW32(func(R(top),R(bottom)), func(G(top),G(bottom)), func(B(top),B(bottom)), func(W(top),W(bottom))); };
+  const auto blend  = [&](pixel_t top, pixel_t bottom){ return func == _top ? top : toPixel(blend8(fromPixel(top), fromPixel(bottom))); };
 
   const int     length     = topSegment.length();     // physical segment length (counts all pixels in 2D segment)
   const int     width      = topSegment.width();
@@ -1356,6 +1782,47 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
 
   Segment::setClippingRect(0, 0);             // disable clipping by default
 
+  // fast path for the common case: segment not in transition and mapped 1:1 onto frame buffer (no grouping, mirroring
+  // or transposing); blend kernel is selected once per segment instead of calling blend function per channel per pixel
+  if (!topSegment.getOldSegment() && (blendingStyle == BLEND_STYLE_FADE || bri == briT || width*height == 1)
+      && topSegment.groupLength() == 1 && !topSegment.mirror) {
+    static const BlendSpanFunc spanFuncs[] = {
+      blendSpan<_top>, blendSpan<_bottom>,
+      blendSpan<_add>, blendSpan<_subtract>, blendSpan<_difference>, blendSpan<_average>,
+      blendSpan<_multiply>, blendSpan<_divide>, blendSpan<_lighten>, blendSpan<_darken>, blendSpan<_screen>, blendSpan<_overlay>,
+      blendSpan<_hardlight>, blendSpan<_softlight>, blendSpan<_dodge>, blendSpan<_burn>
+    };
+    const BlendSpanFunc blendSpanFunc = spanFuncs[blendMode];
+    const uint32_t *src = topSegment.getPixelsRaw();
+    if (isMatrix && stopIndx <= matrixSize) {
+#ifndef WLED_DISABLE_2D
+      if (!topSegment.mirror_y && !topSegment.transpose) {
+        for (int r = 0; r < height; r++) {
+          const size_t indx = XY(topSegment.start, topSegment.startY + (topSegment.reverse_y ? height - r - 1 : r));
+          const uint32_t *row = src + r * width;
+          if (topSegment.reverse) blendSpanFunc(&_pixels[indx], row + width - 1, -1, width, opacity);
+          else                    blendSpanFunc(&_pixels[indx], row, 1, width, opacity);
+          if (_pixelCCT) memset(&_pixelCCT[indx], cct, width);
+        }
+        return;
+      }
+#endif
+    } else if (topSegment.virtualLength() == length && topSegment.offset < length) {
+      // offset rotates segment within its bounds: [start+offset,stop) and [start,start+offset)
+      const int offset = topSegment.offset;
+      pixel_t *dst = &_pixels[topSegment.start];
+      if (topSegment.reverse) {
+        blendSpanFunc(dst + offset, src + length - 1, -1, length - offset, opacity);
+        if (offset) blendSpanFunc(dst, src + offset - 1, -1, offset, opacity);
+      } else {
+        blendSpanFunc(dst + offset, src, 1, length - offset, opacity);
+        if (offset) blendSpanFunc(dst, src + length - offset, 1, offset, opacity);
+      }
+      if (_pixelCCT) memset(&_pixelCCT[topSegment.start], cct, length);
+      return;
+    }
+  }
+
   const unsigned dw = (blendingStyle==BLEND_STYLE_OUTSIDE_IN ? progInv : progress) * width / 0xFFFFU + 1;
   const unsigned dh = (blendingStyle==BLEND_STYLE_OUTSIDE_IN ? progInv : progress) * height / 0xFFFFU + 1;
   const unsigned orgBS = blendingStyle;
@@ -1420,11 +1887,11 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
     const int oCols = segO ? segO->virtualWidth() : nCols;
     const int oRows = segO ? segO->virtualHeight() : nRows;
 
-    const auto setMirroredPixel = [&](int x, int y, uint32_t c, uint8_t o) {
+    const auto setMirroredPixel = [&](int x, int y, pixel_t c, uint8_t o) {
       const int baseX = topSegment.start  + x;
       const int baseY = topSegment.startY + y;
       size_t indx = XY(baseX, baseY); // absolute address on strip
-      _pixels[indx] = color_blend(_pixels[indx], blend(c, _pixels[indx]), o);
+      _pixels[indx] = pixel_blend(_pixels[indx], blend(c, _pixels[indx]), o);
       if (_pixelCCT) _pixelCCT[indx] = cct;
       // Apply mirroring
       if (topSegment.mirror || topSegment.mirror_y) {
@@ -1433,9 +1900,9 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
         const size_t idxMX = XY(topSegment.transpose ? baseX : mirrorX, topSegment.transpose ? mirrorY : baseY);
         const size_t idxMY = XY(topSegment.transpose ? mirrorX : baseX, topSegment.transpose ? baseY : mirrorY);
         const size_t idxMM = XY(mirrorX, mirrorY);
-        if (topSegment.mirror)                        _pixels[idxMX] = color_blend(_pixels[idxMX], blend(c, _pixels[idxMX]), o);
-        if (topSegment.mirror_y)                      _pixels[idxMY] = color_blend(_pixels[idxMY], blend(c, _pixels[idxMY]), o);
-        if (topSegment.mirror && topSegment.mirror_y) _pixels[idxMM] = color_blend(_pixels[idxMM], blend(c, _pixels[idxMM]), o);
+        if (topSegment.mirror)                        _pixels[idxMX] = pixel_blend(_pixels[idxMX], blend(c, _pixels[idxMX]), o);
+        if (topSegment.mirror_y)                      _pixels[idxMY] = pixel_blend(_pixels[idxMY], blend(c, _pixels[idxMY]), o);
+        if (topSegment.mirror && topSegment.mirror_y) _pixels[idxMM] = pixel_blend(_pixels[idxMM], blend(c, _pixels[idxMM]), o);
         if (_pixelCCT) {
           if (topSegment.mirror)                        _pixelCCT[idxMX] = cct;
           if (topSegment.mirror_y)                      _pixelCCT[idxMY] = cct;
@@ -1464,13 +1931,13 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
         case BLEND_STYLE_PUSH_DOWN:  y = (y + offsetY) % nRows;         break;
         case BLEND_STYLE_PUSH_UP:    y = (y - offsetY + nRows) % nRows; break;
       }
-      uint32_t c_a = BLACK;
-      if (x < vCols && y < vRows) c_a = seg->getPixelColorRaw(x + y*vCols); // will get clipped pixel from old segment or unclipped pixel from new segment
+      pixel_t c_a = BLACK;
+      if (x < vCols && y < vRows) c_a = toPixel(seg->getPixelColorRaw(x + y*vCols)); // will get clipped pixel from old segment or unclipped pixel from new segment
       if (segO && blendingStyle == BLEND_STYLE_FADE
         && (topSegment.mode != segO->mode || (segO->name != topSegment.name && segO->name && topSegment.name && strncmp(segO->name, topSegment.name, WLED_MAX_SEGNAME_LEN) != 0))
         && x < oCols && y < oRows) {
         // we need to blend old segment using fade as pixels are not clipped
-        c_a = color_blend16(c_a, segO->getPixelColorRaw(x + y*oCols), progInv);
+        c_a = pixel_blend16(c_a, toPixel(segO->getPixelColorRaw(x + y*oCols)), progInv);
       } else if (blendingStyle != BLEND_STYLE_FADE) {
         // workaround for On/Off transition
         // (bri != briT) && !bri => from On to Off
@@ -1506,19 +1973,19 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
     const Segment *segO = topSegment.getOldSegment();
     const int oLen = segO ? segO->virtualLength() : nLen;
 
-    const auto setMirroredPixel = [&](int i, uint32_t c, uint8_t o) {
+    const auto setMirroredPixel = [&](int i, pixel_t c, uint8_t o) {
       int indx = topSegment.start + i;
       // Apply mirroring
       if (topSegment.mirror) {
         unsigned indxM = topSegment.stop - i - 1;
         indxM += topSegment.offset; // offset/phase
         if (indxM >= topSegment.stop) indxM -= length; // wrap
-        _pixels[indxM] = color_blend(_pixels[indxM], blend(c, _pixels[indxM]), o);
+        _pixels[indxM] = pixel_blend(_pixels[indxM], blend(c, _pixels[indxM]), o);
         if (_pixelCCT) _pixelCCT[indxM] = cct;
       }
       indx += topSegment.offset; // offset/phase
       if (indx >= topSegment.stop) indx -= length; // wrap
-      _pixels[indx] = color_blend(_pixels[indx], blend(c, _pixels[indx]), o);
+      _pixels[indx] = pixel_blend(_pixels[indx], blend(c, _pixels[indx]), o);
       if (_pixelCCT) _pixelCCT[indx] = cct;
     };
 
@@ -1536,11 +2003,11 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
         case BLEND_STYLE_PUSH_RIGHT: i = (i + offsetI) % nLen;        break;
         case BLEND_STYLE_PUSH_LEFT:  i = (i - offsetI + nLen) % nLen; break;
       }
-      uint32_t c_a = BLACK;
-      if (i < vLen) c_a = seg->getPixelColorRaw(i); // will get clipped pixel from old segment or unclipped pixel from new segment
+      pixel_t c_a = BLACK;
+      if (i < vLen) c_a = toPixel(seg->getPixelColorRaw(i)); // will get clipped pixel from old segment or unclipped pixel from new segment
       if (segO && blendingStyle == BLEND_STYLE_FADE && topSegment.mode != segO->mode && i < oLen) {
         // we need to blend old segment using fade as pixels are not clipped
-        c_a = color_blend16(c_a, segO->getPixelColorRaw(i), progInv);
+        c_a = pixel_blend16(c_a, toPixel(segO->getPixelColorRaw(i)), progInv);
       } else if (blendingStyle != BLEND_STYLE_FADE) {
         // workaround for On/Off transition
         // (bri != briT) && !bri => from On to Off
@@ -1562,6 +2029,73 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
   Segment::setClippingRect(0, 0);             // disable clipping for overlays
 }
 
+// Blends segments into frame buffer.
+// Frame buffer is kept from previous frame: only segments whose pixels or blending parameters changed are re-blended,
+// together with all segments overlapping them (their footprints are cleared first so blend order is preserved).
+// If any segment appeared, disappeared or moved (or frame buffer was painted directly) the whole frame is recomposed.
+void WS2812FX::compositeSegments() {
+  static_assert(MAX_NUM_SEGMENTS <= 64, "Segment mask is 64 bit.");
+  const size_t   totalLen   = getLengthTotal();
+  const size_t   matrixSize = Segment::maxWidth * Segment::maxHeight;
+  const unsigned nSegments  = _segments.size();
+
+  // does segment use 2D blending (see blendSegment()), if not it occupies indices [start,stop) in frame buffer
+  const auto isXY = [&](const Segment &seg) {
+    return isMatrix && size_t(seg.startY * Segment::maxWidth + seg.start + seg.length()) <= matrixSize;
+  };
+  const auto overlaps = [&](const Segment &a, const Segment &b) {
+    if (isXY(a) && isXY(b)) return a.start < b.stop && b.start < a.stop && a.startY < b.stopY && b.startY < a.stopY;
+    // compare frame buffer index ranges (conservative for 2D blended segments)
+    const auto first = [&](const Segment &s) { return isXY(s) ? s.start + s.startY * Segment::maxWidth : s.start; };
+    const auto last  = [&](const Segment &s) { return isXY(s) ? s.stop  + (s.stopY - 1) * Segment::maxWidth : s.stop; };
+    return first(a) < last(b) && first(b) < last(a);
+  };
+
+  bool fullRedraw = !_frameValid || _pixelCCT || nSegments != _compositedSegments; // CCT buffer is rebuilt every frame
+  for (const Segment &seg : _segments) if (fullRedraw || seg.footprintChanged()) { fullRedraw = true; break; }
+
+  uint64_t redraw = 0; // segments to (re)blend
+  for (unsigned i = 0; i < nSegments; i++) if (_segments[i].isVisible() && (fullRedraw || _segments[i].needsBlend())) redraw |= 1ULL << i;
+  // add segments overlapping any of the changed ones until no more are found
+  for (bool added = redraw != 0 && !fullRedraw; added; ) {
+    added = false;
+    for (unsigned i = 0; i < nSegments; i++) {
+      if ((redraw >> i) & 1 || !_segments[i].isVisible()) continue;
+      for (unsigned j = 0; j < nSegments; j++) if ((redraw >> j) & 1 && overlaps(_segments[i], _segments[j])) {
+        redraw |= 1ULL << i;
+        added = true;
+        break;
+      }
+    }
+  }
+
+  // clear footprints of segments that are going to be blended
+  if (fullRedraw) {
+    for (size_t i = 0; i < totalLen; i++) _pixels[i] = BLACK; // memset(_pixels, 0, sizeof(uint32_t) * getLengthTotal());
+  } else for (unsigned n = 0; n < nSegments; n++) if ((redraw >> n) & 1) {
+    const Segment &seg = _segments[n];
+    if (isXY(seg)) {
+      for (unsigned y = seg.startY; y < seg.stopY; y++)
+        for (unsigned x = seg.start; x < seg.stop; x++) _pixels[x + y * Segment::maxWidth] = BLACK;
+    } else {
+      for (unsigned i = seg.start; i < seg.stop && i < totalLen; i++) _pixels[i] = BLACK;
+    }
+  }
+
+  // blend segments (in order) into frame buffer
+  _compositedPixels = 0;
+  for (unsigned n = 0; n < nSegments; n++) {
+    const Segment &seg = _segments[n];
+    if ((redraw >> n) & 1) {
+      blendSegment(seg);
+      _compositedPixels += seg.length();
+    }
+    seg.setBlended();
+  }
+  _compositedSegments = nSegments;
+  _frameValid = true;
+}
+
 void WS2812FX::show() {
   if (!_pixels) {
     DEBUGFX_PRINTLN(F("Error: no _pixels!"));
@@ -1576,56 +2110,178 @@ void WS2812FX::show() {
   // WARNING: as WLED doesn't handle CCT on pixel level but on Segment level instead
   // we need to keep track of each pixel's CCT when blending segments (if CCT is present)
   // and then set appropriate CCT from that pixel during paint (see below).
-  if ((hasCCTBus() || correctWB) && !cctFromRgb)
-    _pixelCCT = static_cast<uint8_t*>(allocate_buffer(totalLen * sizeof(uint8_t), BFRALLOC_PREFER_PSRAM)); // allocate CCT buffer if necessary, prefer PSRAM
+  // CCT buffer is kept between frames (freed in finalizeInit() or when no longer needed), prefer PSRAM
+  if ((hasCCTBus() || correctWB) && !cctFromRgb) {
+    if (!_pixelCCT) _pixelCCT = static_cast<uint8_t*>(allocate_buffer(totalLen * sizeof(uint8_t), BFRALLOC_PREFER_PSRAM));
+  } else if (_pixelCCT) {
+    p_free(_pixelCCT);
+    _pixelCCT = nullptr;
+  }
   if (_pixelCCT) memset(_pixelCCT, 127, totalLen); // set neutral (50:50) CCT
 
+  unsigned long startComposite = micros();
   if (realtimeMode == REALTIME_MODE_INACTIVE || useMainSegmentOnly || realtimeOverride > REALTIME_OVERRIDE_NONE) {
-    // clear frame buffer
-    for (size_t i = 0; i < totalLen; i++) _pixels[i] = BLACK; // memset(_pixels, 0, sizeof(uint32_t) * getLengthTotal());
-    // blend all segments into (cleared) buffer
-    for (Segment &seg : _segments) if (seg.isActive() && (seg.on || seg.isInTransition())) {
-      blendSegment(seg);              // blend segment's buffer into frame buffer
-    }
+    compositeSegments();              // blend (changed) segments into frame buffer
+  } else {
+    _frameValid = false;              // frame buffer belongs to realtime data
+    _compositedPixels = 0;
   }
 
   // avoid race condition, capture _callback value
   show_callback callback = _callback;
   if (callback) callback(); // will call setPixelColor or setRealtimePixelColor
+  const uint32_t compositeTime = micros() - startComposite;
+  updateStageTime(_stageTimes.composite, compositeTime);
+  _frameProfile.composite = profileTime(compositeTime);
+  _frameProfile.wait      = 0;
+
+  const bool gamma = !(realtimeMode && arlsDisableGammaCorrection);
+#ifdef WLED_PIPELINED_OUTPUT
+  if (isPipelined()) {
+    // hand frame over to output task, frame buffer is kept as segments are only re-blended if they changed
+    unsigned long startWait = micros();
+    xSemaphoreTake(_outputIdle, portMAX_DELAY); // back-pressure: previous frame must be sent first
+    const uint32_t waitTime = micros() - startWait;
+    updateStageTime(_stageTimes.wait, waitTime);
+    _frameProfile.wait = profileTime(waitTime);
+    for (size_t i = 0; i < totalLen; i++) _outPixels[i] = _pixels[i]; // no byte access allowed on ESP32 (no memcpy())
+    std::swap(_outCCT, _pixelCCT);              // CCT buffer is rebuilt every frame, swapped instead of reallocated
+    _outGamma = gamma;
+    _outProfile = _frameProfile;
+    xTaskNotifyGive(_outputTask);
+  } else
+#endif
+  {
+    outputFrame(_pixels, _pixelCCT, gamma, _frameProfile);
+  }
+  _frameProfile.effects  = 0; // show() may be called without running effects (realtime)
+  _frameProfile.segments = 0;
+
+  if (diff > 0) { // skip calculation if no time has passed
+    size_t fpsCurr = (1000 << FPS_CALC_SHIFT) / diff; // fixed point math
+    _cumulativeFps = (FPS_CALC_AVG * _cumulativeFps + fpsCurr + FPS_CALC_AVG / 2) / (FPS_CALC_AVG + 1);   // "+FPS_CALC_AVG/2" for proper rounding
+    _lastShow = showNow;
+  }
+}
+
+// applies gamma, ledmap and CCT to frame and sends it to buses (called from show() or output task)
+void WS2812FX::outputFrame(const pixel_t *frame, const uint8_t *cct, bool gamma, FrameProfile &profile) {
+  unsigned long startOutput = micros();
+  size_t totalLen = getLengthTotal();
+  const bool useLedmap = customMappingSize && (realtimeMode == REALTIME_MODE_INACTIVE || realtimeRespectLedMaps);
+  // estimate current from the frame and set brightness limit before painting, buses apply it while encoding
+  if (BusManager::_useABL) {
+    if (!useLedmap) BusManager::sumColors(0, frame, totalLen, gamma);
+    else if (_ledmapRuns) outputLedmapRuns(frame, totalLen, gamma, BusManager::sumColors);
+    else for (size_t i = 0; i < totalLen; i++) BusManager::sumColors(getMappedPixelIndex(i), &frame[i], 1, gamma);
+  }
+  BusManager::applyABL(); // apply brightness limit, updates _gMilliAmpsUsed
 
+  unsigned long startPaint = micros();
   // paint actual pixels
   int oldCCT = Bus::getCCT(); // store original CCT value (since it is global)
   // when cctFromRgb is true we implicitly calculate WW and CW from RGB values (cct==-1)
   if (cctFromRgb) BusManager::setSegmentCCT(-1);
-  for (size_t i = 0; i < totalLen; i++) {
+  // without per-pixel CCT each bus gets its part of the frame in one span (fused output stage) or one span per ledmap run
+  if (!cct && !useLedmap) BusManager::setPixels(0, frame, totalLen, gamma);
+  else if (!cct && _ledmapRuns) outputLedmapRuns(frame, totalLen, gamma, BusManager::setPixels);
+  else for (size_t i = 0; i < totalLen; i++) {
     // when correctWB is true setSegmentCCT() will convert CCT into K with which we can then
     // correct/adjust RGB value according to desired CCT value, it will still affect actual WW/CW ratio
-    if (_pixelCCT) { // cctFromRgb already exluded at allocation
-      if (i == 0 || _pixelCCT[i-1] != _pixelCCT[i]) BusManager::setSegmentCCT(_pixelCCT[i], correctWB);
+    if (cct) { // cctFromRgb already exluded at allocation
+      if (i == 0 || cct[i-1] != cct[i]) BusManager::setSegmentCCT(cct[i], correctWB);
     }
 
-    uint32_t c = _pixels[i]; // need a copy, do not modify _pixels directly (no byte access allowed on ESP32)
-    if(c > 0 && !(realtimeMode && arlsDisableGammaCorrection))
-        c = gamma32(c); // apply gamma correction if enabled note: applying gamma after brightness has too much color loss
+    uint32_t c = fromPixel(frame[i]); // need a copy, do not modify frame buffer directly (no byte access allowed on ESP32)
+    if (c > 0 && gamma) c = gamma32(c); // apply gamma correction if enabled note: applying gamma after brightness has too much color loss
     BusManager::setPixelColor(getMappedPixelIndex(i), c);
   }
-  Bus::setCCT(oldCCT);  // restore old CCT for ABL adjustments
-
-  p_free(_pixelCCT);
-  _pixelCCT = nullptr;
+  Bus::setCCT(oldCCT);  // restore old CCT
 
+  unsigned long startTransmit = micros();
   // some buses send asynchronously and this method will return before
   // all of the data has been sent.
   // See https://github.com/Makuna/NeoPixelBus/wiki/ESP32-NeoMethods#neoesp32rmt-methods
-  BusManager::show();
+  BusManager::showBusses();
+  unsigned long endOutput = micros();
+  updateStageTime(_stageTimes.output, endOutput - startOutput);
+  profile.abl      = profileTime(startPaint - startOutput);
+  profile.remap    = profileTime(startTransmit - startPaint);
+  profile.transmit = profileTime(endOutput - startTransmit);
+  commitFrameProfile(profile);
+}
+
+// hands frame to buses along compiled ledmap runs: consecutive physical pixels are handed over as one span,
+// reversed runs (serpentine layouts) via a small reordering buffer, other strides pixel by pixel
+// pixels beyond the ledmap are not remapped (same as getMappedPixelIndex())
+void WS2812FX::outputLedmapRuns(const pixel_t *frame, size_t len, bool gamma, void (*spanFn)(unsigned, const pixel_t*, size_t, bool)) const {
+  for (unsigned r = 0; r < _ledmapRunCount; r++) {
+    const LedmapRun &run = _ledmapRuns[r];
+    if (run.start >= len) break;
+    if (run.target == 0xFFFF && run.stride == 0) continue; // unmapped pixels
+    const pixel_t *colors = frame + run.start;
+    const unsigned  runLen = std::min((unsigned)run.length, unsigned(len - run.start));
+    if (run.stride == 1) {
+      spanFn(run.target, colors, runLen, gamma);
+    } else if (run.stride == -1) {
+      pixel_t buffer[32];
+      const unsigned first = run.target - (runLen - 1); // lowest physical pixel
+      for (unsigned done = 0; done < runLen; done += sizeof(buffer)/sizeof(pixel_t)) {
+        unsigned n = std::min(runLen - done, unsigned(sizeof(buffer)/sizeof(pixel_t)));
+        for (unsigned i = 0; i < n; i++) buffer[i] = colors[runLen - 1 - done - i];
+        spanFn(first + done, buffer, n, gamma);
+      }
+    } else {
+      for (unsigned i = 0; i < runLen; i++) spanFn(uint16_t(run.target + i * run.stride), colors + i, 1, gamma);
+    }
+  }
+  if (len > customMappingSize) spanFn(customMappingSize, frame + customMappingSize, len - customMappingSize, gamma);
+}
 
-  if (diff > 0) { // skip calculation if no time has passed
-    size_t fpsCurr = (1000 << FPS_CALC_SHIFT) / diff; // fixed point math
-    _cumulativeFps = (FPS_CALC_AVG * _cumulativeFps + fpsCurr + FPS_CALC_AVG / 2) / (FPS_CALC_AVG + 1);   // "+FPS_CALC_AVG/2" for proper rounding
-    _lastShow = showNow;
+// starts frames deferred by buses that were still sending when they were shown (see BusDigital::show())
+void WS2812FX::pollOutput() const {
+#ifdef WLED_PIPELINED_OUTPUT
+  if (_outputTask) {
+    if (xSemaphoreTake(_outputIdle, 0) != pdTRUE) return; // buses belong to output task while it sends a frame
+    BusManager::pollBusses();
+    xSemaphoreGive(_outputIdle);
+    return;
+  }
+#endif
+  BusManager::pollBusses();
+}
+
+// moves buffers in arenas together so that space freed by segment reconfiguration can be reused as one block
+// must only be called while no effect is running (buffers and their owners are moved)
+void WS2812FX::compactBuffers() {
+#ifdef WLED_PIPELINED_OUTPUT
+  if (_outputTask && xSemaphoreTake(_outputIdle, 0) != pdTRUE) return; // output task reads frame buffer from arena, try again next frame
+#endif
+  if (Segment::_pixelArena.isFragmented()) Segment::_pixelArena.compact();
+  if (Segment::_dataArena.isFragmented())  Segment::_dataArena.compact();
+#ifdef WLED_PIPELINED_OUTPUT
+  if (_outputTask) xSemaphoreGive(_outputIdle);
+#endif
+}
+
+#ifdef WLED_PIPELINED_OUTPUT
+// output task: sends frames handed over by show() while the next frame is being rendered on the other core
+void WS2812FX::outputTask(void *arg) {
+  WS2812FX *instance = static_cast<WS2812FX*>(arg);
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // wait for show()
+    instance->outputFrame(instance->_outPixels, instance->_outCCT, instance->_outGamma, instance->_outProfile);
+    xSemaphoreGive(instance->_outputIdle);
   }
 }
 
+void WS2812FX::waitForOutput() const {
+  if (!_outputTask) return;
+  xSemaphoreTake(_outputIdle, portMAX_DELAY);
+  xSemaphoreGive(_outputIdle);
+}
+#endif
+
 void WS2812FX::setRealtimePixelColor(unsigned i, uint32_t c) {
   if (useMainSegmentOnly) {
     const Segment &seg = getMainSegment();
@@ -1635,6 +2291,64 @@ void WS2812FX::setRealtimePixelColor(unsigned i, uint32_t c) {
   }
 }
 
+// copies packed realtime data into pixel buffer (dst is already offset and clamped)
+template<typename T>
+static void ingestRun(T *dst, const uint8_t *src, size_t count, unsigned stride, bool white) {
+  if (white) for (size_t i = 0; i < count; i++, src += stride) dst[i] = T(RGBW32(src[0], src[1], src[2], src[3]));
+  else       for (size_t i = 0; i < count; i++, src += stride) dst[i] = T(RGBW32(src[0], src[1], src[2], 0));
+}
+
+#ifdef WLED_PIXEL16
+static void ingestRun(pixel_t *dst, const uint8_t *src, size_t count, unsigned stride, bool white) {
+  if (white) for (size_t i = 0; i < count; i++, src += stride) dst[i] = toPixel(RGBW32(src[0], src[1], src[2], src[3]));
+  else       for (size_t i = 0; i < count; i++, src += stride) dst[i] = toPixel(RGBW32(src[0], src[1], src[2], 0));
+}
+#endif
+
+// same as calling setRealtimePixelColor() for count pixels starting at start (may be negative), each stride bytes apart in data (0: same color for all)
+// range is clamped once and pixels are written straight into frame buffer (or main segment buffer)
+void WS2812FX::ingestPixels(int start, const uint8_t *data, size_t count, unsigned stride, bool white) {
+  if (!data || !count) return;
+  if (start < 0) {
+    if ((size_t)-start >= count) return;
+    data  += -start * stride;
+    count -= -start;
+    start  = 0;
+  }
+  if (useMainSegmentOnly) {
+    const Segment &seg = getMainSegment();
+    if (!seg.isActive() || !seg.pixels || unsigned(start) >= seg.length()) return;
+    ingestRun(seg.getPixels() + start, data, std::min(count, size_t(seg.length() - start)), stride, white); // getPixels() marks segment dirty
+  } else {
+    if (!_pixels || unsigned(start) >= getLengthTotal()) return;
+    ingestRun(_pixels + start, data, std::min(count, size_t(getLengthTotal() - start)), stride, white);
+    _frameValid = false;
+  }
+}
+
+// same as ingestPixels() with pixel offset counted within the physical footprint of seg (row by row, grouping,
+// spacing, mirroring and transpose are not applied); in main segment mode only the main segment is live
+void WS2812FX::ingestSegmentPixels(const Segment &seg, unsigned offset, const uint8_t *data, size_t count, unsigned stride, bool white) {
+  if (!seg.isActive() || !data) return;
+  if (useMainSegmentOnly) {
+    if (&seg == &getMainSegment()) ingestPixels(offset, data, count, stride, white);
+    return;
+  }
+  const unsigned width = seg.width();
+  const size_t   area  = width * seg.height();
+  if (offset >= area) return;
+  count = std::min(count, area - offset);
+  while (count) {
+    const unsigned x = offset % width;
+    const unsigned y = offset / width;
+    const size_t   n = std::min(count, size_t(width - x));
+    ingestPixels((seg.startY + y) * Segment::maxWidth + seg.start + x, data, n, stride, white); // 1D: startY = 0, height 1
+    data   += n * stride;
+    offset += n;
+    count  -= n;
+  }
+}
+
 // reset all segments
 void WS2812FX::restartRuntime() {
   suspend();
@@ -1658,12 +2372,14 @@ void WS2812FX::waitForIt() {
   #ifdef WLED_DEBUG
   if (millis() >= maxWait) DEBUG_PRINTLN(F("Waited for strip to finish servicing."));
   #endif
+  waitForOutput(); // ledmap or buses may be modified by caller
 };
 
 void WS2812FX::setTargetFps(unsigned fps) {
   if (fps <= 250) _targetFps = fps;
   if (_targetFps > 0) _frametime = 1000 / _targetFps;
   else _frametime = MIN_FRAME_DELAY;     // unlimited mode
+  _governedFrametime = _frametime;       // governor starts over
 }
 
 void WS2812FX::setCCT(uint16_t k) {
@@ -1683,6 +2399,7 @@ void WS2812FX::setBrightness(uint8_t b, bool direct) {
   if (_brightness == 0) { //unfreeze all segments on power off
     for (const Segment &seg : _segments) seg.freeze = false; // freeze is mutable
   }
+  waitForOutput(); // do not change brightness while a frame is being sent
   BusManager::setBrightness(scaledBri(b));
   if (!direct) {
     unsigned long t = millis();
@@ -1962,6 +2679,8 @@ bool WS2812FX::deserializeMap(unsigned n) {
   }
 
   d_free(customMappingTable);
+  d_free(_ledmapRuns);
+  _ledmapRuns = nullptr;
   customMappingTable = static_cast<uint16_t*>(d_malloc(sizeof(uint16_t)*getLengthTotal())); // prefer DRAM for speed
 
   if (customMappingTable) {
@@ -1984,7 +2703,7 @@ bool WS2812FX::deserializeMap(unsigned n) {
         int index = atoi(number);
         if (index < 0 || index > 16384) index = 0xFFFF;
         customMappingTable[customMappingSize++] = index;
-        if (customMappingSize > getLengthTotal()) break;
+        if (customMappingSize >= getLengthTotal()) break;
       } else break; // there was nothing to read, stop
     }
     currentLedmap = n;
@@ -1998,6 +2717,7 @@ bool WS2812FX::deserializeMap(unsigned n) {
     }
     DEBUG_PRINTLN();
     #endif
+    compileLedmap();
 /*
     JsonArray map = root[F("map")];
     if (!map.isNull() && map.size()) {  // not an empty map
@@ -2017,6 +2737,61 @@ bool WS2812FX::deserializeMap(unsigned n) {
 }
 
 
+// compiles customMappingTable into runs where logical pixels map to physical pixels with constant stride
+// (rows, reversed/serpentine rows, columns of vertical panels, unmapped gaps) and replaces the table if runs use less RAM
+// must be called with strip suspended
+void WS2812FX::compileLedmap() {
+  d_free(_ledmapRuns);
+  _ledmapRuns = nullptr;
+  _ledmapRunCount = 0;
+  if (!customMappingTable || customMappingSize == 0) return;
+
+  // returns end of run starting at i and its stride
+  auto runEnd = [this](unsigned i, int &stride) -> unsigned {
+    const uint16_t *map = customMappingTable;
+    stride = 1;
+    if (map[i] == 0xFFFF) { // unmapped pixels
+      stride = 0;
+      while (++i < customMappingSize && map[i] == 0xFFFF);
+      return i;
+    }
+    if (i + 1 < customMappingSize && map[i+1] != 0xFFFF) stride = int(map[i+1]) - int(map[i]);
+    if (stride < INT16_MIN || stride > INT16_MAX) return i + 1;
+    while (++i < customMappingSize && map[i] != 0xFFFF && int(map[i]) - int(map[i-1]) == stride);
+    return i;
+  };
+
+  unsigned runs = 0;
+  int stride;
+  for (unsigned i = 0; i < customMappingSize; i = runEnd(i, stride)) runs++;
+  if (runs * sizeof(LedmapRun) >= customMappingSize * sizeof(uint16_t)) return; // irregular map, keep table
+
+  _ledmapRuns = static_cast<LedmapRun*>(d_malloc(runs * sizeof(LedmapRun))); // prefer DRAM for speed
+  if (!_ledmapRuns) return; // keep table
+  for (unsigned i = 0; i < customMappingSize; ) {
+    unsigned end = runEnd(i, stride);
+    _ledmapRuns[_ledmapRunCount++] = {uint16_t(i), uint16_t(end - i), customMappingTable[i], int16_t(stride)};
+    i = end;
+  }
+  DEBUG_PRINTF_P(PSTR("Ledmap compiled into %u runs (%uB instead of %uB).\n"), runs, runs * sizeof(LedmapRun), customMappingSize * sizeof(uint16_t));
+  d_free(customMappingTable);
+  customMappingTable = nullptr;
+}
+
+// physical pixel of logical pixel index (index < customMappingSize) using compiled ledmap
+uint16_t IRAM_ATTR WS2812FX::getLedmapRunIndex(uint16_t index) const {
+  unsigned lo = 0, hi = _ledmapRunCount; // binary search for last run starting at or before index
+  while (lo < hi) {
+    unsigned mid = (lo + hi) / 2;
+    if (_ledmapRuns[mid].start <= index) lo = mid + 1;
+    else hi = mid;
+  }
+  if (lo == 0) return index; // not reached, first run starts at 0
+  const LedmapRun &run = _ledmapRuns[lo-1];
+  return run.target + (index - run.start) * run.stride; // stride of unmapped run is 0
+}
+
+
 const char JSON_mode_names[] PROGMEM = R"=====(["FX names moved"])=====";
 const char JSON_palette_names[] PROGMEM = R"=====([
 "Default","* Random Cycle","* Color 1","* Colors 1&2","* Color Gradient","* Colors Only","Party","Cloud","Lava","Ocean",
@@ -25,10 +25,17 @@
 #include "colors.h"
 #include "pin_manager.h"
 #include "bus_manager.h"
+#ifndef WLED_HOST_BUILD
 #include "bus_wrapper.h"
+#include "src/dependencies/e131/ESPAsyncE131.h" // network output ports and protocol definitions
+#else
+#include "host_polybus.h" // RAM backed PolyBus for the host-native ABL check (tools/bench), protocol definitions are in wled_host.h
+#endif
 #include <bits/unique_ptr.h>
 
 extern char cmDNS[];
+extern char serverDescription[];
+extern String escapedMac;
 extern bool cctICused;
 extern bool useParallelI2S;
 
@@ -66,7 +73,7 @@ void setBitArray(uint8_t* byteArray, size_t numBits, bool value) {  // set all b
 uint32_t colorBalanceFromKelvin(uint16_t kelvin, uint32_t rgb);
 
 //udp.cpp
-uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const byte *buffer, uint8_t bri=255, bool isRGBW=false);
+bool realtimeSendPacket(IPAddress client, uint16_t port, const uint8_t *packet, size_t len);
 
 //util.cpp
 // memory allocation wrappers
@@ -100,9 +107,23 @@ extern "C" {
 #define B(c) (byte(c))
 #define W(c) (byte((c) >> 24))
 
+// FNV-1a over 32 bit words, used to detect unchanged frames (a single changed pixel always changes the hash)
+#define FRAME_HASH_SEED  2166136261U
+#define FRAME_HASH(h, v) (((h) ^ (v)) * 16777619U)
+
 
 static ColorOrderMap _colorOrderMap = {};
 
+// flat pixel -> bus lookup used by BusManager::setPixelColor()/getPixelColor(), rebuilt when buses are added or removed
+struct BusRange {
+  unsigned start;
+  unsigned end;
+  Bus     *bus;
+};
+static std::vector<BusRange> _busRanges; // sorted by start
+static bool     _busesOverlap = false;   // overlapping buses are searched in bus order instead
+static unsigned _lastRange = 0;          // consecutive pixels usually belong to the same bus
+
 bool ColorOrderMap::add(uint16_t start, uint16_t len, uint8_t colorOrder) {
   if (count() >= WLED_MAX_COLOR_ORDER_MAPPINGS || len == 0 || (colorOrder & 0x0F) > COL_ORDER_MAX) return false; // upper nibble contains W swap information
   _mappings.push_back({start,len,colorOrder});
@@ -119,6 +140,17 @@ uint8_t IRAM_ATTR ColorOrderMap::getPixelColorOrder(uint16_t pix, uint8_t defaul
   return defaultColorOrder;
 }
 
+uint8_t IRAM_ATTR ColorOrderMap::getPixelColorOrder(uint16_t pix, uint8_t defaultColorOrder, unsigned &runEnd) const {
+  // color order can only change at the start or end of a mapping
+  runEnd = UINT16_MAX + 1U;
+  for (const auto& map : _mappings) {
+    unsigned mapEnd = map.start + map.len;
+    if (map.start > pix && map.start < runEnd) runEnd = map.start;
+    if (mapEnd    > pix && mapEnd    < runEnd) runEnd = mapEnd;
+  }
+  return getPixelColorOrder(pix, defaultColorOrder);
+}
+
 
 void Bus::calculateCCT(uint32_t c, uint8_t &ww, uint8_t &cw) {
   unsigned cct = 0; //0 - full warm white, 255 - full cold white
@@ -141,6 +173,30 @@ void Bus::calculateCCT(uint32_t c, uint8_t &ww, uint8_t &cw) {
   cw = (w * cw) / 255;
 }
 
+// same split for a 16 bit white channel (RGB of c is used if CCT is approximated from RGB)
+void Bus::calculateCCT(uint32_t c, uint16_t w, uint16_t &ww, uint16_t &cw) {
+  uint8_t wwShare, cwShare;
+  calculateCCT(c | 0xFF000000, wwShare, cwShare); // full white yields the shares
+  ww = (w * wwShare) / 255;
+  cw = (w * cwShare) / 255;
+}
+
+void Bus::setPixels(unsigned pix, const uint32_t *colors, size_t len, bool gamma) {
+  for (size_t i = 0; i < len; i++) setPixelColor(pix + i, gamma ? gamma32(colors[i]) : colors[i]);
+}
+
+#ifdef WLED_PIXEL16
+// buses without 16 bit output get the frame as 8 bit colors, converted in small chunks
+void Bus::setPixels64(unsigned pix, const uint64_t *colors, size_t len, bool gamma) {
+  uint32_t buffer[32];
+  for (size_t done = 0; done < len; done += sizeof(buffer)/sizeof(uint32_t)) {
+    const size_t n = std::min(len - done, sizeof(buffer)/sizeof(uint32_t));
+    for (size_t i = 0; i < n; i++) buffer[i] = fromPixel(colors[done + i]);
+    setPixels(pix + done, buffer, n, gamma);
+  }
+}
+#endif
+
 uint32_t Bus::autoWhiteCalc(uint32_t c) const {
   unsigned aWM = _autoWhiteMode;
   if (_gAWM < AW_GLOBAL_DISABLED) aWM = _gAWM;
@@ -164,12 +220,21 @@ BusDigital::BusDigital(const BusConfig &bc, uint8_t nr)
 , _colorOrder(bc.colorOrder)
 , _milliAmpsPerLed(bc.milliAmpsPerLed)
 , _milliAmpsMax(bc.milliAmpsMax)
+, _ditherError(nullptr)
 {
   DEBUGBUS_PRINTLN(F("Bus: Creating digital bus."));
   if (!isDigital(bc.type) || !bc.count) { DEBUGBUS_PRINTLN(F("Not digial or empty bus!")); return; }
   if (!PinManager::allocatePin(bc.pins[0], true, PinOwner::BusDigital)) { DEBUGBUS_PRINTLN(F("Pin 0 allocated!")); return; }
   _frequencykHz = 0U;
   _colorSum = 0;
+  _ablBri = 255;
+  _frameHash = FRAME_HASH_SEED;
+  _shownHash = 0;
+  _lastTransmit = 0;
+  _resend = true;
+  _pending = false;
+  _txStart = 0;
+  _wireTime = 0;
   _pins[0] = bc.pins[0];
   if (is2Pin(bc.type)) {
     if (!PinManager::allocatePin(bc.pins[1], true, PinOwner::BusDigital)) {
@@ -214,11 +279,31 @@ BusDigital::BusDigital(const BusConfig &bc, uint8_t nr)
 
 // note on ABL implementation:
 // ABL is set up in finalizeInit()
-// scaled color channels are summed in BusDigital::setPixelColor()
-// the used current is estimated and limited in BusManager::show()
+// color channels of the frame are summed in BusDigital::sumColors() before the frame is painted
+// the used current is estimated and limited in BusManager::applyABL(), also before painting
+// the limited brightness is applied while encoding pixels (no repaint of the bus buffer is needed)
 // if limit is set too low, brightness is limited to 1 to at least show some light
 // to disable brightness limiter for a bus, set LED current to 0
 
+// sums color channels of (unencoded) frame colors the same way they will be encoded (without brightness limit)
+void IRAM_ATTR BusDigital::sumColors(const uint32_t *colors, size_t len, bool gamma) {
+  uint32_t sum = 0;
+  for (size_t i = 0; i < len; i++) {
+    uint32_t c = colors[i];
+    if (c == 0) continue;
+    if (gamma) c = gamma32(c);
+    if (hasWhite()) c = autoWhiteCalc(c);
+    c = color_fade(c, _bri, true); // apply brightness
+    uint8_t r = R(c), g = G(c), b = B(c);
+    if (_milliAmpsPerLed < 255) { // normal ABL
+      sum += r + g + b + W(c);
+    } else { // wacky WS2815 power model, ignore white channel, use max of RGB (issue #549)
+      sum += ((r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b));
+    }
+  }
+  _colorSum += sum;
+}
+
 void BusDigital::estimateCurrent() {
   uint32_t actualMilliampsPerLed = _milliAmpsPerLed;
   if (_milliAmpsPerLed == 255) {
@@ -229,45 +314,66 @@ void BusDigital::estimateCurrent() {
   // _colorSum has all the values of color channels summed, max would be getLength()*(3*255 + (255 if hasWhite()): convert to milliAmps
   uint32_t clrUnitsPerChannel = hasWhite() ? 4*255 : 3*255;
   _milliAmpsTotal = ((uint64_t)_colorSum * actualMilliampsPerLed) / clrUnitsPerChannel + getLength(); // add 1mA standby current per LED to total (WS2812: ~0.7mA, WS2815: ~2mA)
+  _colorSum = 0; // reset for next frame
 }
 
 void BusDigital::applyBriLimit(uint8_t newBri) {
   // a newBri of 0 means calculate per-bus brightness limit
   if (newBri == 0) {
-    if (_milliAmpsLimit == 0 || _milliAmpsTotal == 0) return; // ABL not used for this bus
     newBri = 255;
-
-    if (_milliAmpsLimit > getLength()) { // each LED uses about 1mA in standby
-      if (_milliAmpsTotal > _milliAmpsLimit) {
-        // scale brightness down to stay in current limit
-        newBri = ((uint32_t)_milliAmpsLimit * 255) / _milliAmpsTotal + 1; // +1 to avoid 0 brightness
-        _milliAmpsTotal = _milliAmpsLimit;
+    if (_milliAmpsLimit > 0 && _milliAmpsTotal > 0) { // ABL used for this bus
+      if (_milliAmpsLimit > getLength()) { // each LED uses about 1mA in standby
+        if (_milliAmpsTotal > _milliAmpsLimit) {
+          // scale brightness down to stay in current limit
+          newBri = ((uint32_t)_milliAmpsLimit * 255) / _milliAmpsTotal + 1; // +1 to avoid 0 brightness
+          _milliAmpsTotal = _milliAmpsLimit;
+        }
+      } else {
+        newBri = 1; // limit too low, set brightness to 1, this will dim down all colors to minimum since we use video scaling
+        _milliAmpsTotal = getLength(); // estimate bus current as minimum
       }
-    } else {
-      newBri = 1; // limit too low, set brightness to 1, this will dim down all colors to minimum since we use video scaling
-      _milliAmpsTotal = getLength(); // estimate bus current as minimum
-    }
-  }
-
-  if (newBri < 255) {
-    uint8_t cctWW = 0, cctCW = 0;
-    unsigned hwLen = _len;
-    if (_type == TYPE_WS2812_1CH_X3) hwLen = NUM_ICS_WS2812_1CH_3X(_len); // only needs a third of "RGB" LEDs for NeoPixelBus
-    for (unsigned i = 0; i < hwLen; i++) {
-      uint8_t co = _colorOrderMap.getPixelColorOrder(i+_start, _colorOrder); // need to revert color order for correct color scaling and CCT calc in case white is swapped
-      uint32_t c = PolyBus::getPixelColor(_busPtr, _iType, i, co);
-      c = color_fade(c, newBri, true); // apply additional dimming  note: using inline version is a bit faster but overhead of getPixelColor() dominates the speed impact by far
-      if (hasCCT()) Bus::calculateCCT(c, cctWW, cctCW);
-      PolyBus::setPixelColor(_busPtr, _iType, i, c, co, (cctCW<<8) | cctWW); // repaint all pixels with new brightness
     }
   }
-
-  _colorSum = 0; // reset for next frame
+  _ablBri = newBri; // applied in setPixelColor()/setPixels() when the frame is painted
 }
 
 void BusDigital::show() {
   if (!_valid) return;
+  // skip transmission if no pixel changed since last frame (frees RMT/I2S and CPU time for other buses)
+  const unsigned long now = millis();
+  const unsigned long refreshInterval = _needsRefresh ? BUS_REFRESH_INTERVAL : BUS_IDLE_REFRESH_INTERVAL;
+  const uint32_t hash = _frameHash;
+  _frameHash = FRAME_HASH_SEED; // start hashing next frame
+  if (!_resend && hash == _shownHash && now - _lastTransmit < refreshInterval) return;
+  _shownHash = hash;
+  _lastTransmit = now;
+  _resend = false;
+  // never wait for the previous frame to leave the wire (NeoPixelBus would block until it has): the frame is deferred
+  // and started by poll() as soon as the wire is free, so other buses start back-to-back and rendering continues
+  // if the next frame is painted before that, the bus sends the newer one (RMT/I2S/DMA methods are double buffered)
+  if (wireIdle()) transmit();
+  else            _pending = true;
+}
+
+bool BusDigital::poll() {
+  if (!_valid || (!_pending && !_txStart)) return false;
+  if (wireIdle() && _pending) transmit();
+  return _pending || _txStart;
+}
+
+// returns true if the previous frame has been sent, completion is detected by polling (NeoPixelBus offers no
+// completion callback and the RMT HI driver owns the interrupt) so measured wire time is rounded up to the poll interval
+bool BusDigital::wireIdle() {
+  if (!PolyBus::canShow(_busPtr, _iType)) return false;
+  if (_txStart) _wireTime = micros() - _txStart;
+  _txStart = 0;
+  return true;
+}
+
+void BusDigital::transmit() {
   PolyBus::show(_busPtr, _iType, _skip); // faster if buffer consistency is not important (no skipped LEDs)
+  _txStart = micros() | 1; // 0 is reserved for "not sending"
+  _pending = false;
 }
 
 bool BusDigital::canShow() const {
@@ -289,16 +395,7 @@ void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
   if (hasWhite()) c = autoWhiteCalc(c);
   if (Bus::_cct >= 1900) c = colorBalanceFromKelvin(Bus::_cct, c); //color correction from CCT
   c = color_fade(c, _bri, true); // apply brightness
-
-  if (BusManager::_useABL) {
-    // if using ABL, sum all color channels to estimate current and limit brightness in show()
-    uint8_t r = R(c), g = G(c), b = B(c);
-    if (_milliAmpsPerLed < 255) { // normal ABL
-      _colorSum += r + g + b + W(c);
-    } else { // wacky WS2815 power model, ignore white channel, use max of RGB (issue #549)
-      _colorSum += ((r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b));
-    }
-  }
+  c = color_fade(c, _ablBri, true); // apply brightness limit (ABL)
 
   if (_reversed) pix = _len - pix -1;
   pix += _skip;
@@ -320,9 +417,149 @@ void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
     wwcw = (cctCW<<8) | cctWW;
     if (_type == TYPE_WS2812_WWA) c = RGBW32(cctWW, cctCW, 0, W(c));
   }
+  _frameHash = FRAME_HASH(FRAME_HASH(_frameHash, c), pix | (wwcw << 16));
   PolyBus::setPixelColor(_busPtr, _iType, pix, c, co, wwcw);
 }
 
+// temporal dithering: gamma and brightness are applied with 16 bit (8.8 fixed point) precision and the fraction that
+// does not fit into 8 bits is carried over to the next frame, so levels in between 8 bit steps average out over time
+// scale is the combined brightness (0-65536), err holds the carried fraction of each channel (in B,G,R,W order)
+static inline uint32_t ditherColor(uint32_t c, uint8_t *err, unsigned channels, bool gamma, uint32_t scale) {
+  uint32_t out = 0;
+  for (unsigned i = 0; i < channels; i++) {
+    const unsigned v = (c >> (8*i)) & 0xFF;
+    uint32_t v16 = gamma ? gamma16(v) : v << 8;
+    v16 = ((v16 * scale) >> 16) + err[i]; // max 0xFF00 + 0xFF, cannot overflow 8 bits
+    err[i] = v16;
+    out |= (v16 >> 8) << (8*i);
+  }
+  return out;
+}
+
+// fused output of a span of pixels: gamma, auto white, brightness, brightness limit and color order
+// are applied in a single pass writing directly into the NeoPixelBus buffer (8 bit GRB/GRBW buses only)
+void IRAM_ATTR BusDigital::setPixels(unsigned pix, const uint32_t *colors, size_t len, bool gamma) {
+  // byte shifts to extract each buffer byte (sent in G,R,B,W order) from a WRGB color, indexed by color order
+  static const uint8_t orderShifts[6][3] = { {8,16,0}, {16,8,0}, {0,16,8}, {16,0,8}, {0,8,16}, {8,0,16} };
+  unsigned channels = 3;
+  uint8_t *buffer = nullptr;
+  // CCT (except 16 bit buses), white balance correction and 1CH-X3 buses need per-pixel handling
+  if (_valid && (!hasCCT() || is16bit()) && _type != TYPE_WS2812_1CH_X3 && Bus::_cct < 1900) {
+    if (_gDither && is16bit()) {
+      setPixels16(pix, colors, len, gamma);
+      return;
+    }
+    buffer = PolyBus::getPixelBuffer(_busPtr, _iType, channels);
+  }
+  if (!buffer) {
+    Bus::setPixels(pix, colors, len, gamma);
+    return;
+  }
+  if (pix >= _len) return;
+  if (len > _len - pix) len = _len - pix;
+  if (_gDither && !_ditherError) {
+    _ditherError = static_cast<uint8_t*>(d_malloc(_len * channels)); // prefers DRAM, uses PSRAM if needed
+    // random start values let pixels of the same level toggle at different times, which hides dithering flicker
+    uint32_t seed = 0x2545F491;
+    if (_ditherError) for (size_t i = 0; i < _len * channels; i++) { seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5; _ditherError[i] = seed; }
+  } else if (!_gDither && _ditherError) {
+    d_free(_ditherError);
+    _ditherError = nullptr;
+  }
+  // pixels are written in ascending physical order so color order runs can be reused, reversed buses read colors back to front
+  const unsigned first = (_reversed ? _len - pix - len : pix) + _skip;
+  const int step = _reversed ? -1 : 1;
+  const uint32_t *src = _reversed ? colors + len - 1 : colors;
+  uint8_t *dst = buffer + first * channels;
+  uint8_t *err = _ditherError ? _ditherError + (first - _skip) * channels : nullptr;
+  const bool gammaDither = gamma && gammaCorrectCol;
+  const uint32_t scale = _bri ? (_bri + 1) * (_ablBri + 1) : 0; // combined brightness and brightness limit for dithering
+  uint8_t shift[4] = {8,16,0,24};
+  unsigned runEnd = 0;
+  uint32_t hash = FRAME_HASH(_frameHash, first | (len << 16));
+  for (unsigned i = 0; i < len; i++, src += step, dst += channels) {
+    if (first + i + _start >= runEnd) {
+      const uint8_t co = _colorOrderMap.getPixelColorOrder(first + i + _start, _colorOrder, runEnd);
+      const uint8_t *order = orderShifts[(co & 0x0F) > 5 ? 0 : co & 0x0F];
+      shift[0] = order[0]; shift[1] = order[1]; shift[2] = order[2]; shift[3] = 24;
+      switch (co >> 4) { // upper nibble contains W swap information
+        case 1: shift[3] = shift[2]; shift[2] = 24; break; // swap W & B
+        case 2: shift[3] = shift[0]; shift[0] = 24; break; // swap W & G
+        case 3: shift[3] = shift[1]; shift[1] = 24; break; // swap W & R
+      }
+    }
+    uint32_t c = *src;
+    if (err) {
+      if (hasWhite()) c = autoWhiteCalc(c); // before gamma so that all channels get 16 bit gamma
+      c = ditherColor(c, err, channels, gammaDither, scale);
+      err += channels;
+    } else {
+      if (gamma) c = gamma32(c);
+      if (hasWhite()) c = autoWhiteCalc(c);
+      c = color_fade(c, _bri, true);    // apply brightness
+      c = color_fade(c, _ablBri, true); // apply brightness limit (ABL)
+    }
+    hash = FRAME_HASH(hash, c);
+    dst[0] = c >> shift[0];
+    dst[1] = c >> shift[1];
+    dst[2] = c >> shift[2];
+    if (channels > 3) dst[3] = c >> shift[3];
+  }
+  _frameHash = hash;
+}
+
+// channels as 8.8 fixed point values (0-65280) of a 32 bit color (8 bit channels) or a 64 bit frame buffer pixel (16 bit channels)
+static inline void loadChannels16(uint32_t c, uint32_t ch[4]) { for (unsigned j = 0; j < 4; j++) ch[j] = ((c >> (8*j)) & 0xFF) << 8; }
+static inline void loadChannels16(uint64_t c, uint32_t ch[4]) { for (unsigned j = 0; j < 4; j++) { const uint32_t v = (c >> (16*j)) & 0xFFFF; ch[j] = v - (v >> 8); } }
+
+// 16 bit buses get gamma and brightness with full precision instead of dithering (CCT buses split white at 16 bit)
+// colors are either 8 bit colors (dithering enabled) or 16 bit frame buffer pixels (WLED_PIXEL16)
+template<typename T>
+void BusDigital::setPixels16(unsigned pix, const T *colors, size_t len, bool gamma) {
+  if (pix >= _len) return;
+  if (len > _len - pix) len = _len - pix;
+  gamma = gamma && gammaCorrectCol;
+  const uint32_t scale = _bri ? (_bri + 1) * (_ablBri + 1) : 0;
+  const unsigned aWM = hasWhite() ? (_gAWM < AW_GLOBAL_DISABLED ? _gAWM : _autoWhiteMode) : RGBW_MODE_MANUAL_ONLY;
+  uint32_t hash = _frameHash;
+  for (size_t i = 0; i < len; i++) {
+    uint32_t v[4];
+    loadChannels16(colors[i], v);
+    // same as autoWhiteCalc() (B,G,R,W order)
+    if (aWM != RGBW_MODE_MANUAL_ONLY && !(v[3] && aWM == RGBW_MODE_DUAL)) {
+      if (aWM == RGBW_MODE_MAX) v[3] = std::max(v[0], std::max(v[1], v[2]));
+      else {
+        v[3] = std::min(v[0], std::min(v[1], v[2]));
+        if (aWM == RGBW_MODE_AUTO_ACCURATE) { v[0] -= v[3]; v[1] -= v[3]; v[2] -= v[3]; }
+      }
+    }
+    uint16_t ch[4];
+    for (unsigned j = 0; j < 4; j++) {
+      uint32_t v16 = gamma ? NeoGammaWLEDMethod::Correct16(v[j]) : v[j];
+      v16 = (v16 * scale) >> 16;
+      ch[j] = v16 + (v16 >> 8); // 0xFF00 -> 0xFFFF
+    }
+    uint16_t ww = 0, cw = 0;
+    if (hasCCT()) {
+      calculateCCT(RGBW32(ch[2] >> 8, ch[1] >> 8, ch[0] >> 8, 0), ch[3], ww, cw);
+      hash = FRAME_HASH(hash, ww | (uint32_t(cw) << 16));
+    }
+    const unsigned p = (_reversed ? _len - pix - i - 1 : pix + i) + _skip;
+    const uint8_t co = _colorOrderMap.getPixelColorOrder(p + _start, _colorOrder);
+    hash = FRAME_HASH(FRAME_HASH(hash, ch[0] | (ch[1] << 16)), ch[2] | (ch[3] << 16));
+    PolyBus::setPixelColor16(_busPtr, _iType, p, ch, co, ww, cw);
+  }
+  _frameHash = hash;
+}
+
+#ifdef WLED_PIXEL16
+// 16 bit frame buffer: 16 bit buses get all 16 bits, other buses 8 bit colors (see Bus::setPixels64())
+void IRAM_ATTR BusDigital::setPixels64(unsigned pix, const uint64_t *colors, size_t len, bool gamma) {
+  if (_valid && is16bit() && Bus::_cct < 1900) setPixels16(pix, colors, len, gamma);
+  else Bus::setPixels64(pix, colors, len, gamma);
+}
+#endif
+
 // returns lossly restored color from bus
 uint32_t IRAM_ATTR BusDigital::getPixelColor(unsigned pix) const {
   if (!_valid) return 0;
@@ -354,7 +591,7 @@ size_t BusDigital::getPins(uint8_t* pinArray) const {
 }
 
 size_t BusDigital::getBusSize() const {
-  return sizeof(BusDigital) + (isOk() ? PolyBus::getDataSize(_busPtr, _iType) : 0);
+  return sizeof(BusDigital) + (isOk() ? PolyBus::getDataSize(_busPtr, _iType) : 0) + (_ditherError ? _len * (hasWhite() + 3) : 0);
 }
 
 void BusDigital::setColorOrder(uint8_t colorOrder) {
@@ -392,11 +629,14 @@ std::vector<LEDType> BusDigital::getLEDTypes() {
 void BusDigital::begin() {
   if (!_valid) return;
   PolyBus::begin(_busPtr, _iType, _pins, _frequencykHz);
+  _resend = true; // (re)initialized driver needs a full frame
 }
 
 void BusDigital::cleanup() {
   DEBUGBUS_PRINTLN(F("Digital Cleanup."));
   PolyBus::cleanup(_busPtr, _iType);
+  d_free(_ditherError);
+  _ditherError = nullptr;
   _iType = I_NONE;
   _valid = false;
   _busPtr = nullptr;
@@ -446,7 +686,7 @@ BusPwm::BusPwm(const BusConfig &bc)
     #ifdef ESP8266
     analogWriteRange((1<<_depth)-1);
     analogWriteFreq(_frequency);
-    #else
+    #elif defined(ARDUINO_ARCH_ESP32)
     // for 2 pin PWM CCT strip pinManager will make sure both LEDC channels are in the same speed group and sharing the same timer
     _ledcStart = PinManager::allocateLedc(numPins);
     if (_ledcStart == 255) { //no more free LEDC channels
@@ -462,7 +702,7 @@ BusPwm::BusPwm(const BusConfig &bc)
       _pins[i] = bc.pins[i]; // store only after allocateMultiplePins() succeeded
       #ifdef ESP8266
       pinMode(_pins[i], OUTPUT);
-      #else
+      #elif defined(ARDUINO_ARCH_ESP32)
       unsigned channel = _ledcStart + i;
       ledcSetup(channel, _frequency, _depth - (dithering*4)); // with dithering _frequency doesn't really matter as resolution is 8 bit
       ledcAttachPin(_pins[i], channel);
@@ -585,7 +825,7 @@ void BusPwm::show() {
     #ifdef ESP8266
     //stopWaveform(_pins[i]);  // can cause the waveform to miss a cycle. instead we risk crossovers.
     startWaveformClockCycles(_pins[i], duty, analogPeriod - duty, 0, i ? _pins[0] : -1, hPoint, false);
-    #else
+    #elif defined(ARDUINO_ARCH_ESP32)
     unsigned channel = _ledcStart + i;
     unsigned gr = channel/8;  // high/low speed group
     unsigned ch = channel%8;  // group channel
@@ -628,7 +868,7 @@ void BusPwm::deallocatePins() {
     if (!PinManager::isPinOk(_pins[i])) continue;
     #ifdef ESP8266
     digitalWrite(_pins[i], LOW); //turn off PWM interrupt
-    #else
+    #elif defined(ARDUINO_ARCH_ESP32)
     if (_ledcStart < WLED_MAX_ANALOG_CHANNELS) ledcDetachPin(_pins[i]);
     #endif
   }
@@ -687,24 +927,52 @@ std::vector<LEDType> BusOnOff::getLEDTypes() {
   };
 }
 
+// network output protocols: each packet is pre-built (header + channel data) and pixels are written directly into
+// its payload, only sequence numbers change when a frame is sent
+#define NET_UDP_DDP    0
+#define NET_UDP_E131   1
+#define NET_UDP_ARTNET 2
+
+#define DDP_HEADER_LEN 10
+#define DDP_FLAGS1_VER1 0x40 // version=1
+#define DDP_FLAGS1_PUSH 0x01
+#define DDP_ID_DISPLAY 1
+#define DDP_CHANNELS_PER_PACKET 1440 // 480 RGB or 360 RGBW leds
+
+#define E131_HEADER_LEN (E131_DMP_DATA+1) // including DMX start code
+#define E131_PRIORITY 100
+#define ARTNET_HEADER_LEN 18
+#define DMX_CHANNELS_PER_PACKET 512 // 170 RGB or 128 RGBW leds
+
+static const byte ART_NET_HEADER[] PROGMEM = {0x41,0x72,0x74,0x2d,0x4e,0x65,0x74,0x00,0x00,0x50,0x00,0x0e}; // ID, OpCode (OpDmx) and protocol version
+static const byte E131_ROOT_HEADER[] PROGMEM = {0x00,0x10,0x00,0x00,0x41,0x53,0x43,0x2d,0x45,0x31,0x2e,0x31,0x37,0x00,0x00,0x00}; // preamble, postamble and ACN packet identifier
+
+static unsigned netUDPtype(uint8_t type) {
+  switch (type) {
+    case TYPE_NET_ARTNET_RGB:
+    case TYPE_NET_ARTNET_RGBW: return NET_UDP_ARTNET;
+    case TYPE_NET_E131_RGB:    return NET_UDP_E131;
+    default:                   return NET_UDP_DDP; // TYPE_NET_DDP_RGB / TYPE_NET_DDP_RGBW
+  }
+}
+
+static unsigned netHeaderLen(unsigned udpType) {
+  return udpType == NET_UDP_DDP ? DDP_HEADER_LEN : udpType == NET_UDP_E131 ? E131_HEADER_LEN : ARTNET_HEADER_LEN;
+}
+
+static unsigned netPixelsPerPacket(unsigned udpType, unsigned channels) {
+  return (udpType == NET_UDP_DDP ? DDP_CHANNELS_PER_PACKET : DMX_CHANNELS_PER_PACKET) / channels;
+}
+
+static inline void putUint16(uint8_t *p, unsigned v) { p[0] = v >> 8; p[1] = v; } // network byte order
+
 BusNetwork::BusNetwork(const BusConfig &bc)
 : Bus(bc.type, bc.start, bc.autoWhite, bc.count)
+, _sequence(0)
 , _broadcastLock(false)
+, _packets(nullptr)
 {
-  switch (bc.type) {
-    case TYPE_NET_ARTNET_RGB:
-      _UDPtype = 2;
-      break;
-    case TYPE_NET_ARTNET_RGBW:
-      _UDPtype = 2;
-      break;
-    case TYPE_NET_E131_RGB:
-      _UDPtype = 1;
-      break;
-    default: // TYPE_NET_DDP_RGB / TYPE_NET_DDP_RGBW
-      _UDPtype = 0;
-      break;
-  }
+  _UDPtype = netUDPtype(bc.type);
   _hasRgb = hasRGB(bc.type);
   _hasWhite = hasWhite(bc.type);
   _hasCCT = false;
@@ -714,32 +982,143 @@ BusNetwork::BusNetwork(const BusConfig &bc)
   _hostname = bc.text;
   resolveHostname(); // resolve hostname to IP address if needed
   #endif
-  _data = (uint8_t*)d_calloc(_len, _UDPchannels);
-  _valid = (_data != nullptr);
-  DEBUGBUS_PRINTF_P(PSTR("%successfully inited virtual strip with type %u and IP %u.%u.%u.%u\n"), _valid?"S":"Uns", bc.type, bc.pins[0], bc.pins[1], bc.pins[2], bc.pins[3]);
+  // split pixels evenly among nodes, each node gets its own set of packets starting at offset/universe 0
+  unsigned nodes   = constrain(bc.skipAmount, 1, NET_OUTPUT_MAX_NODES);
+  _pixelsPerNode   = (_len + nodes - 1) / nodes;
+  _nodes           = (_len + _pixelsPerNode - 1) / _pixelsPerNode; // drop nodes that would not get any pixels
+  _headerLen       = netHeaderLen(_UDPtype);
+  _pixelsPerPacket = netPixelsPerPacket(_UDPtype, _UDPchannels);
+  _packetsPerNode  = (_pixelsPerNode + _pixelsPerPacket - 1) / _pixelsPerPacket;
+  _packetCount     = _nodes * _packetsPerNode;
+  _packetStride    = _headerLen + _pixelsPerPacket * _UDPchannels;
+  _packets = (uint8_t*)d_calloc(_packetCount, _packetStride);
+  _valid = (_packets != nullptr);
+  if (_valid) buildHeaders();
+  DEBUGBUS_PRINTF_P(PSTR("%successfully inited virtual strip with type %u and IP %u.%u.%u.%u (%u nodes, %u packets)\n"), _valid?"S":"Uns", bc.type, bc.pins[0], bc.pins[1], bc.pins[2], bc.pins[3], _nodes, _packetCount);
+}
+
+// number of pixels in given packet of given node (last node and last packet of each node may be shorter, 0 if unused)
+unsigned BusNetwork::getPacketPixels(unsigned node, unsigned packet) const {
+  const int nodePixels = std::min((int)_pixelsPerNode, (int)_len - (int)(node * _pixelsPerNode));
+  return constrain(nodePixels - (int)(packet * _pixelsPerPacket), 0, (int)_pixelsPerPacket);
+}
+
+void BusNetwork::buildHeaders() {
+  for (unsigned n = 0; n < _nodes; n++) {
+    for (unsigned p = 0; p < _packetsPerNode; p++) {
+      uint8_t *packet = _packets + (n * _packetsPerNode + p) * _packetStride;
+      const unsigned dataLen = getPacketPixels(n, p) * _UDPchannels;
+      switch (_UDPtype) {
+        case NET_UDP_DDP: {
+          const uint32_t offset = p * _pixelsPerPacket * _UDPchannels;
+          packet[0] = DDP_FLAGS1_VER1 | (p == _packetsPerNode - 1 || getPacketPixels(n, p + 1) == 0 ? DDP_FLAGS1_PUSH : 0); // push with last packet
+          packet[2] = _hasWhite ? DDP_TYPE_RGBW32 : DDP_TYPE_RGB24;
+          packet[3] = DDP_ID_DISPLAY;
+          putUint16(packet + 4, offset >> 16); // data offset in bytes, 32-bit number
+          putUint16(packet + 6, offset);
+          putUint16(packet + 8, dataLen);
+        } break;
+        case NET_UDP_E131: {
+          const unsigned packetLen = E131_HEADER_LEN + dataLen;
+          memcpy_P(packet, E131_ROOT_HEADER, sizeof(E131_ROOT_HEADER));
+          putUint16(packet + E131_ROOT_FLENGTH, 0x7000 | (packetLen - E131_ROOT_FLENGTH));
+          packet[E131_ROOT_VECTOR + 3] = 0x04; // VECTOR_ROOT_E131_DATA
+          memcpy(packet + E131_ROOT_CID, "WLED", 4); // component identifier: "WLED" + MAC, unique for each sender
+          memcpy(packet + E131_ROOT_CID + 4, escapedMac.c_str(), std::min(escapedMac.length(), 12U));
+          putUint16(packet + E131_FRAME_FLENGTH, 0x7000 | (packetLen - E131_FRAME_FLENGTH));
+          packet[E131_FRAME_VECTOR + 3] = 0x02; // VECTOR_E131_DATA_PACKET
+          strncpy((char*)packet + E131_FRAME_SOURCE, serverDescription, E131_FRAME_PRIORITY - E131_FRAME_SOURCE - 1);
+          packet[E131_FRAME_PRIORITY] = E131_PRIORITY;
+          putUint16(packet + E131_FRAME_UNIVERSE, p + 1); // universes start at 1
+          putUint16(packet + E131_DMP_FLENGTH, 0x7000 | (packetLen - E131_DMP_FLENGTH));
+          packet[E131_DMP_VECTOR] = 0x02; // VECTOR_DMP_SET_PROPERTY
+          packet[E131_DMP_TYPE]   = 0xA1;
+          putUint16(packet + E131_DMP_ADDR_INC, 1);
+          putUint16(packet + E131_DMP_COUNT, dataLen + 1); // including start code
+        } break;
+        case NET_UDP_ARTNET: {
+          memcpy_P(packet, ART_NET_HEADER, sizeof(ART_NET_HEADER));
+          packet[14] = p;      // Universe LSB. 1 full packet == 1 full universe, so just use current packet number.
+          packet[15] = p >> 8; // Universe MSB (Net)
+          putUint16(packet + 16, dataLen); // 16-bit length of channel data
+        } break;
+      }
+    }
+  }
 }
 
-void BusNetwork::setPixelColor(unsigned pix, uint32_t c) {
-  if (!_valid || pix >= _len) return;
+uint8_t *BusNetwork::getPixelData(unsigned pix) const {
+  const unsigned node  = pix / _pixelsPerNode;
+  const unsigned local = pix - node * _pixelsPerNode;
+  const unsigned index = local % _pixelsPerPacket;
+  return _packets + (node * _packetsPerNode + local / _pixelsPerPacket) * _packetStride + _headerLen + index * _UDPchannels;
+}
+
+inline void BusNetwork::encodePixel(uint8_t *data, uint32_t c) const {
   if (_hasWhite) c = autoWhiteCalc(c);
   if (Bus::_cct >= 1900) c = colorBalanceFromKelvin(Bus::_cct, c); //color correction from CCT
-  unsigned offset = pix * _UDPchannels;
-  _data[offset]   = R(c);
-  _data[offset+1] = G(c);
-  _data[offset+2] = B(c);
-  if (_hasWhite) _data[offset+3] = W(c);
+  c = color_fade(c, _bri); // apply brightness
+  data[0] = R(c);
+  data[1] = G(c);
+  data[2] = B(c);
+  if (_hasWhite) data[3] = W(c);
+}
+
+void BusNetwork::setPixelColor(unsigned pix, uint32_t c) {
+  if (!_valid || pix >= _len) return;
+  encodePixel(getPixelData(pix), c);
+}
+
+// writes consecutive pixels packet by packet
+void BusNetwork::setPixels(unsigned pix, const uint32_t *colors, size_t len, bool gamma) {
+  if (!_valid || pix >= _len) return;
+  if (len > _len - pix) len = _len - pix;
+  unsigned node  = pix / _pixelsPerNode;
+  unsigned local = pix - node * _pixelsPerNode;
+  while (len) {
+    const unsigned index = local % _pixelsPerPacket;
+    uint8_t *data = _packets + (node * _packetsPerNode + local / _pixelsPerPacket) * _packetStride + _headerLen + index * _UDPchannels;
+    const size_t n = std::min(len, (size_t)std::min(_pixelsPerPacket - index, _pixelsPerNode - local)); // up to end of packet or node
+    for (size_t i = 0; i < n; i++, data += _UDPchannels) encodePixel(data, gamma ? gamma32(colors[i]) : colors[i]);
+    colors += n;
+    len    -= n;
+    local  += n;
+    if (local == _pixelsPerNode) { node++; local = 0; }
+  }
 }
 
 uint32_t BusNetwork::getPixelColor(unsigned pix) const {
   if (!_valid || pix >= _len) return 0;
-  unsigned offset = pix * _UDPchannels;
-  return RGBW32(_data[offset], _data[offset+1], _data[offset+2], (hasWhite() ? _data[offset+3] : 0));
+  const uint8_t *data = getPixelData(pix);
+  return RGBW32(data[0], data[1], data[2], (hasWhite() ? data[3] : 0)); // returns scaled-down colours like NeoPixelBus
 }
 
 void BusNetwork::show() {
   if (!_valid || !canShow()) return;
+  static const uint16_t ports[] = {DDP_DEFAULT_PORT, E131_DEFAULT_PORT, ARTNET_DEFAULT_PORT}; // defined in ESPAsyncE131.h
   _broadcastLock = true;
-  realtimeBroadcast(_UDPtype, _client, _len, _data, _bri, hasWhite());
+  _sequence = _sequence % 255 + 1; // 1-255, 0 means sequence not used
+  for (unsigned n = 0; n < _nodes; n++) {
+    IPAddress client = _client;
+    client[3] += n;
+    for (unsigned p = 0; p < _packetsPerNode; p++) {
+      const unsigned pixels = getPacketPixels(n, p);
+      if (pixels == 0) break;
+      uint8_t *packet = _packets + (n * _packetsPerNode + p) * _packetStride;
+      switch (_UDPtype) {
+        case NET_UDP_DDP:    packet[1] = (_sequence - 1) % 15 + 1; break; // 1-15
+        case NET_UDP_E131:   packet[E131_FRAME_SEQ] = _sequence;   break;
+        case NET_UDP_ARTNET: packet[12] = _sequence;               break;
+      }
+      if (!realtimeSendPacket(client, ports[_UDPtype], packet, _headerLen + pixels * _UDPchannels)) {
+        _broadcastLock = false;
+        return; // network not ready or send error, skip the rest of the frame
+      }
+      #if NET_OUTPUT_PACING > 0
+      delayMicroseconds(NET_OUTPUT_PACING);
+      #endif
+    }
+  }
   _broadcastLock = false;
 }
 
@@ -761,10 +1140,21 @@ void BusNetwork::resolveHostname() {
 }
 #endif
 
+size_t BusNetwork::memUsage(const BusConfig &bc) {
+  const unsigned udpType   = netUDPtype(bc.type);
+  const unsigned channels  = Bus::getNumberOfChannels(bc.type);
+  const unsigned perPacket = netPixelsPerPacket(udpType, channels);
+  const unsigned nodes     = constrain(bc.skipAmount, 1, NET_OUTPUT_MAX_NODES);
+  const unsigned perNode   = (bc.count + nodes - 1) / nodes;
+  const unsigned packets   = ((bc.count + perNode - 1) / perNode) * ((perNode + perPacket - 1) / perPacket);
+  return sizeof(BusNetwork) + packets * (netHeaderLen(udpType) + perPacket * channels);
+}
+
 // credit @willmmiles & @netmindz https://github.com/wled/WLED/pull/4056
 std::vector<LEDType> BusNetwork::getLEDTypes() {
   return {
     {TYPE_NET_DDP_RGB,     "N",     PSTR("DDP RGB (network)")},      // should be "NNNN" to determine 4 "pin" fields
+    {TYPE_NET_E131_RGB,    "N",     PSTR("E1.31 RGB (network)")},
     {TYPE_NET_ARTNET_RGB,  "N",     PSTR("Art-Net RGB (network)")},
     {TYPE_NET_DDP_RGBW,    "N",     PSTR("DDP RGBW (network)")},
     {TYPE_NET_ARTNET_RGBW, "N",     PSTR("Art-Net RGBW (network)")},
@@ -778,8 +1168,8 @@ std::vector<LEDType> BusNetwork::getLEDTypes() {
 
 void BusNetwork::cleanup() {
   DEBUGBUS_PRINTLN(F("Virtual Cleanup."));
-  d_free(_data);
-  _data = nullptr;
+  d_free(_packets);
+  _packets = nullptr;
   _type = I_NONE;
   _valid = false;
 }
@@ -1134,7 +1524,7 @@ size_t BusHub75Matrix::getPins(uint8_t* pinArray) const {
 //utility to get the approx. memory usage of a given BusConfig
 size_t BusConfig::memUsage(unsigned nr) const {
   if (Bus::isVirtual(type)) {
-    return sizeof(BusNetwork) + (count * Bus::getNumberOfChannels(type));
+    return BusNetwork::memUsage(*this);
   } else if (Bus::isDigital(type)) {
     return sizeof(BusDigital) + PolyBus::memUsage(count + skipAmount, PolyBus::getI(type, pins, nr)) /*+ doubleBuffer * (count + skipAmount) * Bus::getNumberOfChannels(type)*/;
   } else if (Bus::isOnOff(type)) {
@@ -1197,9 +1587,47 @@ int BusManager::add(const BusConfig &bc) {
   } else {
     busses.push_back(make_unique<BusPwm>(bc));
   }
+  updateBusRanges();
   return busses.size();
 }
 
+void BusManager::updateBusRanges() {
+  _busRanges.clear();
+  _busRanges.reserve(busses.size());
+  for (const auto &bus : busses) {
+    if (!bus->isOk()) continue; // invalid buses ignore pixels anyway
+    _busRanges.push_back({bus->getStart(), bus->getStart() + bus->getLength(), bus.get()});
+  }
+  std::sort(_busRanges.begin(), _busRanges.end(), [](const BusRange &a, const BusRange &b) { return a.start < b.start; });
+  _busesOverlap = false;
+  for (size_t i = 1; i < _busRanges.size(); i++) if (_busRanges[i].start < _busRanges[i-1].end) _busesOverlap = true;
+  _lastRange = 0;
+  DEBUGBUS_PRINTF_P(PSTR("Bus: %u ranges%s\n"), (unsigned)_busRanges.size(), _busesOverlap ? " (overlapping)" : "");
+}
+
+// returns bus range containing pix (nullptr if none), only valid if buses do not overlap
+static inline const BusRange *findBusRange(unsigned pix) {
+  const size_t n = _busRanges.size();
+  if (_lastRange < n) {
+    const BusRange &last = _busRanges[_lastRange];
+    if (pix >= last.start && pix < last.end) return &last;
+    if (pix >= last.end && _lastRange + 1 < n) { // next bus (pixels are mostly set in order)
+      const BusRange &next = _busRanges[_lastRange + 1];
+      if (pix >= next.start && pix < next.end) { _lastRange++; return &next; }
+    }
+  }
+  // binary search for last range starting at or before pix
+  size_t lo = 0, hi = n;
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (_busRanges[mid].start <= pix) lo = mid + 1;
+    else hi = mid;
+  }
+  if (lo == 0 || pix >= _busRanges[lo-1].end) return nullptr;
+  _lastRange = lo - 1;
+  return &_busRanges[_lastRange];
+}
+
 // credit @willmmiles
 static String LEDTypesToJson(const std::vector<LEDType>& types) {
   String json;
@@ -1244,6 +1672,7 @@ void BusManager::removeAll() {
   //prevents crashes due to deleting busses while in use.
   while (!canAllShow()) yield();
   busses.clear();
+  updateBusRanges();
   PolyBus::setParallelI2S1Output(false);
 }
 
@@ -1300,7 +1729,7 @@ void BusManager::on() {
       }
     }
   }
-  #else
+  #elif defined(ARDUINO_ARCH_ESP32)
   for (auto &bus : busses) if (bus->isVirtual()) {
     // virtual/network bus should check for IP change if hostname is specified
     // otherwise there are no endpoints to force DNS resolution
@@ -1329,20 +1758,78 @@ void BusManager::off() {
   _gMilliAmpsUsed = 0; // reset, assume no LED idle current if relay is off
 }
 
+bool BusManager::pollBusses() {
+  bool sending = false;
+  for (auto &bus : busses) if (bus->isDigital() && bus->isOk()) sending |= static_cast<BusDigital&>(*bus).poll();
+  return sending;
+}
+
 void BusManager::show() {
-  applyABL(); // apply brightness limit, updates _gMilliAmpsUsed
-  for (auto &bus : busses) {
-    bus->show();
-  }
+  showBusses(); // brightness limit is applied when painting, see applyABL()
 }
 
 void IRAM_ATTR BusManager::setPixelColor(unsigned pix, uint32_t c) {
+  if (!_busesOverlap) {
+    const BusRange *range = findBusRange(pix);
+    if (range) range->bus->setPixelColor(pix - range->start, c);
+    return;
+  }
   for (auto &bus : busses) {
     if (!bus->containsPixel(pix)) continue;
     bus->setPixelColor(pix - bus->getStart(), c);
   }
 }
 
+void IRAM_ATTR BusManager::setPixels(unsigned start, const uint32_t *colors, size_t len, bool gamma) {
+  const unsigned end = start + len;
+  for (auto &bus : busses) {
+    unsigned busStart = bus->getStart();
+    unsigned busEnd   = busStart + bus->getLength();
+    unsigned first    = std::max(start, busStart);
+    unsigned last     = std::min(end, busEnd);
+    if (first >= last) continue;
+    bus->setPixels(first - busStart, colors + (first - start), last - first, gamma);
+  }
+}
+
+void IRAM_ATTR BusManager::sumColors(unsigned start, const uint32_t *colors, size_t len, bool gamma) {
+  if (!_useABL) return;
+  const unsigned end = start + len;
+  for (auto &bus : busses) {
+    if (!bus->isDigital() || !bus->isOk()) continue;
+    unsigned busStart = bus->getStart();
+    unsigned first    = std::max(start, busStart);
+    unsigned last     = std::min(end, busStart + bus->getLength());
+    if (first >= last) continue;
+    static_cast<BusDigital&>(*bus).sumColors(colors + (first - start), last - first, gamma);
+  }
+}
+
+#ifdef WLED_PIXEL16
+void IRAM_ATTR BusManager::setPixels(unsigned start, const uint64_t *colors, size_t len, bool gamma) {
+  const unsigned end = start + len;
+  for (auto &bus : busses) {
+    unsigned busStart = bus->getStart();
+    unsigned busEnd   = busStart + bus->getLength();
+    unsigned first    = std::max(start, busStart);
+    unsigned last     = std::min(end, busEnd);
+    if (first >= last) continue;
+    bus->setPixels64(first - busStart, colors + (first - start), last - first, gamma);
+  }
+}
+
+// current estimate does not need 16 bit precision, frame is summed as 8 bit colors
+void BusManager::sumColors(unsigned start, const uint64_t *colors, size_t len, bool gamma) {
+  if (!_useABL) return;
+  uint32_t buffer[32];
+  for (size_t done = 0; done < len; done += sizeof(buffer)/sizeof(uint32_t)) {
+    const size_t n = std::min(len - done, sizeof(buffer)/sizeof(uint32_t));
+    for (size_t i = 0; i < n; i++) buffer[i] = fromPixel(colors[done + i]);
+    sumColors(start + done, buffer, n, gamma);
+  }
+}
+#endif
+
 void BusManager::setSegmentCCT(int16_t cct, bool allowWBCorrection) {
   if (cct > 255) cct = 255;
   if (cct >= 0) {
@@ -1353,6 +1840,10 @@ void BusManager::setSegmentCCT(int16_t cct, bool allowWBCorrection) {
 }
 
 uint32_t BusManager::getPixelColor(unsigned pix) {
+  if (!_busesOverlap) {
+    const BusRange *range = findBusRange(pix);
+    return range ? range->bus->getPixelColor(pix - range->start) : 0;
+  }
   for (auto &bus : busses) {
     if (!bus->containsPixel(pix)) continue;
     return bus->getPixelColor(pix - bus->getStart());
@@ -1367,6 +1858,7 @@ bool BusManager::canAllShow() {
 
 void BusManager::initializeABL() {
   _useABL = false; // reset
+  for (auto &bus : busses) if (bus->isDigital() && bus->isOk()) static_cast<BusDigital&>(*bus).applyBriLimit(255); // remove previous limit
   if (_gMilliAmpsMax > 0) {
     // check global brightness limit
     for (auto &bus : busses) {
@@ -1429,12 +1921,11 @@ void BusManager::applyABL() {
         milliAmpsSum = totalLEDs; // estimate total used current as minimum
       }
 
-      // apply brightness limit to each bus, if its 255 it will only reset _colorSum
+      // set brightness limit of each bus, buses with LED current set to 0 are not limited
       for (auto &bus : busses) {
         if (bus->isDigital() && bus->isOk()) {
           BusDigital &busd = static_cast<BusDigital&>(*bus);
-          if (busd.getLEDCurrent() > 0)  // skip buses with LED current set to 0
-            busd.applyBriLimit(newBri);
+          busd.applyBriLimit(busd.getLEDCurrent() > 0 ? newBri : 255);
         }
       }
     }
@@ -1453,6 +1944,7 @@ bool PolyBus::_useParallelI2S = false;
 int16_t Bus::_cct = -1;
 uint8_t Bus::_cctBlend = 0; // 0 - 127
 uint8_t Bus::_gAWM = 255;
+bool Bus::_gDither = false;
 
 uint16_t BusDigital::_milliAmpsTotal = 0;
 
@@ -93,6 +93,8 @@ struct ColorOrderMap {
     }
 
     [[gnu::hot]] uint8_t getPixelColorOrder(uint16_t pix, uint8_t defaultColorOrder) const;
+    // same as above but also returns the first pixel after pix with a (possibly) different color order
+    [[gnu::hot]] uint8_t getPixelColorOrder(uint16_t pix, uint8_t defaultColorOrder, unsigned &runEnd) const;
 
   private:
     std::vector<ColorOrderMapEntry> _mappings;
@@ -128,6 +130,10 @@ class Bus {
     virtual bool     canShow() const                            { return true; }
     virtual void     setStatusPixel(uint32_t c)                 {}
     virtual void     setPixelColor(unsigned pix, uint32_t c)    = 0;
+    virtual void     setPixels(unsigned pix, const uint32_t *colors, size_t len, bool gamma); // sets len consecutive pixels, optionally gamma corrected
+  #ifdef WLED_PIXEL16
+    virtual void     setPixels64(unsigned pix, const uint64_t *colors, size_t len, bool gamma); // same for 16 bit per channel frame buffer pixels
+  #endif
     virtual void     setBrightness(uint8_t b)                   { _bri = b; };
     virtual void     setColorOrder(uint8_t co)                  {}
     virtual uint32_t getPixelColor(unsigned pix) const          { return 0; }
@@ -139,6 +145,7 @@ class Bus {
     virtual uint16_t getLEDCurrent() const                      { return 0; }
     virtual uint16_t getUsedCurrent() const                     { return 0; }
     virtual uint16_t getMaxCurrent() const                      { return 0; }
+    virtual uint32_t getWireTime() const                        { return 0; } // time last frame took to send (us)
     virtual size_t   getBusSize() const                         { return sizeof(Bus); }
     virtual const String getCustomText() const                  { return String(); }
 
@@ -197,6 +204,8 @@ class Bus {
     static inline int16_t  getCCT()                   { return _cct; }
     static inline void     setGlobalAWMode(uint8_t m) { if (m < 5) _gAWM = m; else _gAWM = AW_GLOBAL_DISABLED; }
     static inline uint8_t  getGlobalAWMode()          { return _gAWM; }
+    static inline void     setGlobalDithering(bool d) { _gDither = d; }
+    static inline bool     getGlobalDithering()       { return _gDither; }
     static inline void     setCCT(int16_t cct)        { _cct = cct; }
     static inline uint8_t  getCCTBlend()              { return (_cctBlend * 100 + 64) / 127; } // returns 0-100, 100% = 127. +64 for rounding
     static inline void     setCCTBlend(uint8_t b) {        // input is 0-100
@@ -207,6 +216,7 @@ class Bus {
       #endif
     }
     static void calculateCCT(uint32_t c, uint8_t &ww, uint8_t &cw);
+    static void calculateCCT(uint32_t c, uint16_t w, uint16_t &ww, uint16_t &cw); // splits 16 bit white channel w
 
   protected:
     uint8_t  _type;
@@ -224,6 +234,8 @@ class Bus {
     uint8_t  _autoWhiteMode;
     // global Auto White Calculation override
     static uint8_t _gAWM;
+    // temporal dithering of 8 bit digital buses (gamma & brightness applied with 16 bit precision)
+    static bool    _gDither;
     // _cct has the following meanings (see calculateCCT() & BusManager::setSegmentCCT()):
     //    -1 means to extract approximate CCT value in K from RGB (in calcualteCCT())
     //    [0,255] is the exact CCT value where 0 means warm and 255 cold
@@ -248,6 +260,10 @@ class BusDigital : public Bus {
     bool canShow() const override;
     void setStatusPixel(uint32_t c) override;
     [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override;
+    [[gnu::hot]] void setPixels(unsigned pix, const uint32_t *colors, size_t len, bool gamma) override;
+  #ifdef WLED_PIXEL16
+    [[gnu::hot]] void setPixels64(unsigned pix, const uint64_t *colors, size_t len, bool gamma) override;
+  #endif
     void setColorOrder(uint8_t colorOrder) override;
     [[gnu::hot]] uint32_t getPixelColor(unsigned pix) const override;
     uint8_t  getColorOrder() const override  { return _colorOrder; }
@@ -257,9 +273,13 @@ class BusDigital : public Bus {
     uint16_t getLEDCurrent() const override  { return _milliAmpsPerLed; }
     uint16_t getUsedCurrent() const override { return _milliAmpsTotal; }
     uint16_t getMaxCurrent() const override  { return _milliAmpsMax; }
+    uint32_t getWireTime() const override    { return _wireTime; }
+    bool     poll(); // starts deferred frame once the wire is free, returns true while a frame is deferred or being sent
     void     setCurrentLimit(uint16_t milliAmps) { _milliAmpsLimit = milliAmps; }
+    [[gnu::hot]] void sumColors(const uint32_t *colors, size_t len, bool gamma); // sums (unencoded) frame colors for current estimate
     void     estimateCurrent(); // estimate used current from summed colors
-    void     applyBriLimit(uint8_t newBri);
+    void     applyBriLimit(uint8_t newBri); // sets brightness limit for the next encoded frame (0 = use per-bus limit)
+    uint8_t  getBriLimit() const { return _ablBri; }
     size_t   getBusSize() const override;
     void begin() override;
     void cleanup();
@@ -275,11 +295,24 @@ class BusDigital : public Bus {
     uint16_t _milliAmpsMax;
     uint8_t  _milliAmpsPerLed;
     uint16_t _milliAmpsLimit;
-    uint32_t _colorSum; // total color value for the bus, updated in setPixelColor(), used to estimate current
+    uint8_t  _ablBri;   // brightness limit applied on top of _bri when encoding pixels, set in applyBriLimit()
+    uint32_t _colorSum; // total color value for the bus, updated in sumColors(), used to estimate current
+    uint32_t _frameHash; // hash of pixels painted since last show()
+    uint32_t _shownHash; // hash of last transmitted frame
+    unsigned long _lastTransmit;
+    bool     _resend;    // transmit next frame even if unchanged
+    bool     _pending;   // frame is waiting for previous one to leave the wire (see show())
+    unsigned long _txStart; // micros() when current frame was started, 0 if none is being sent
+    uint32_t _wireTime;  // time last frame took to send (us), measured by polling
     void    *_busPtr;
+    uint8_t *_ditherError; // fraction of each channel carried over to the next frame (temporal dithering)
 
     static uint16_t _milliAmpsTotal; // is overwitten/recalculated on each show()
 
+    bool wireIdle();
+    void transmit();
+    template<typename T> void setPixels16(unsigned pix, const T *colors, size_t len, bool gamma); // 8 bit colors or 16 bit frame buffer pixels
+
     inline uint32_t restoreColorLossy(uint32_t c, uint8_t restoreBri) const {
       if (restoreBri < 255) {
         uint8_t* chan = (uint8_t*) &c;
@@ -348,9 +381,11 @@ class BusNetwork : public Bus {
 
     bool canShow() const override  { return !_broadcastLock; } // this should be a return value from UDP routine if it is still sending data out
     [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override;
+    [[gnu::hot]] void setPixels(unsigned pix, const uint32_t *colors, size_t len, bool gamma) override;
     [[gnu::hot]] uint32_t getPixelColor(unsigned pix) const override;
     size_t getPins(uint8_t* pinArray = nullptr) const override;
-    size_t getBusSize() const override  { return sizeof(BusNetwork) + (isOk() ? _len * _UDPchannels : 0); }
+    unsigned skippedLeds() const override { return _nodes > 1 ? _nodes : 0; } // skip field holds the number of destination nodes
+    size_t getBusSize() const override  { return sizeof(BusNetwork) + (isOk() ? _packetCount * _packetStride : 0); }
     void   show() override;
     void   cleanup();
     #ifdef ARDUINO_ARCH_ESP32
@@ -358,17 +393,31 @@ class BusNetwork : public Bus {
     const String getCustomText() const override { return _hostname; }
     #endif
 
+    static size_t memUsage(const BusConfig &bc);
     static std::vector<LEDType> getLEDTypes();
 
   private:
-    IPAddress _client;
+    IPAddress _client;          // first destination node, other nodes use consecutive addresses
     uint8_t   _UDPtype;
     uint8_t   _UDPchannels;
+    uint8_t   _nodes;           // number of destination nodes, pixels are split evenly among them
+    uint8_t   _sequence;
     bool      _broadcastLock;
-    uint8_t   *_data;
+    uint16_t  _headerLen;       // protocol header length of each packet
+    uint16_t  _pixelsPerPacket;
+    uint16_t  _pixelsPerNode;
+    uint16_t  _packetsPerNode;
+    uint16_t  _packetCount;
+    uint16_t  _packetStride;    // distance between consecutive packets in _packets
+    uint8_t   *_packets;        // pre-built packets (header + channel data), pixels are written directly into their payload
     #ifdef ARDUINO_ARCH_ESP32
     String    _hostname;
     #endif
+
+    uint8_t *getPixelData(unsigned pix) const; // returns pointer to channel data of pixel within its packet
+    unsigned getPacketPixels(unsigned node, unsigned packet) const;
+    void     buildHeaders();
+    void     encodePixel(uint8_t *data, uint32_t c) const; // writes color channels into packet payload
 };
 
 #ifdef WLED_ENABLE_HUB75MATRIX
@@ -463,6 +512,22 @@ struct BusConfig {
 };
 
 
+// unchanged frames are not sent to digital buses but repeated at least every BUS_*_REFRESH_INTERVAL ms
+#ifndef BUS_REFRESH_INTERVAL
+  #define BUS_REFRESH_INTERVAL         0 // buses requiring refresh (TM1814 or "off refresh" set), 0 = send every frame
+#endif
+#ifndef BUS_IDLE_REFRESH_INTERVAL
+  #define BUS_IDLE_REFRESH_INTERVAL 1000 // other buses (recovers LEDs from glitches on the data line)
+#endif
+
+// network output
+#ifndef NET_OUTPUT_MAX_NODES
+  #define NET_OUTPUT_MAX_NODES 16  // max destination nodes per network bus
+#endif
+#ifndef NET_OUTPUT_PACING
+  #define NET_OUTPUT_PACING     0  // delay in us between consecutive packets (for receivers with small UDP buffers), 0 = no pacing
+#endif
+
 // milliamps used by ESP (for power estimation)
 // you can set it to 0 if the ESP is powered by USB and the LEDs by external
 #ifndef MA_FOR_ESP
@@ -496,7 +561,12 @@ namespace BusManager {
   inline uint16_t ablMilliampsMax()             { return _gMilliAmpsMax; }  // used for compatibility reasons (and enabling virtual global ABL)
   inline void     setMilliampsMax(uint16_t max) { _gMilliAmpsMax = max;}
   void            initializeABL();              // setup automatic brightness limiter parameters, call once after buses are initialized
-  void            applyABL();                   // apply automatic brightness limiter, global or per bus
+  void            sumColors(unsigned start, const uint32_t *colors, size_t len, bool gamma); // sum frame colors per bus for current estimate (call before painting)
+#ifdef WLED_PIXEL16
+  void            sumColors(unsigned start, const uint64_t *colors, size_t len, bool gamma); // same for 16 bit per channel frame
+#endif
+  void            applyABL();                   // apply automatic brightness limiter, global or per bus (call before painting)
+  bool            pollBusses();                 // starts deferred frames of buses whose wire became free, returns true while any bus is sending
 
   void useParallelOutput(); // workaround for inaccessible PolyBus
   bool hasParallelOutput(); // workaround for inaccessible PolyBus
@@ -504,13 +574,19 @@ namespace BusManager {
   //do not call this method from system context (network callback)
   void removeAll();
   int  add(const BusConfig &bc);
+  void updateBusRanges(); // rebuilds pixel to bus lookup, called when buses are added or removed
 
   void on();
   void off();
 
   [[gnu::hot]] void     setPixelColor(unsigned pix, uint32_t c);
+  [[gnu::hot]] void     setPixels(unsigned start, const uint32_t *colors, size_t len, bool gamma); // sets len pixels starting at start on all buses they span
+#ifdef WLED_PIXEL16
+  [[gnu::hot]] void     setPixels(unsigned start, const uint64_t *colors, size_t len, bool gamma); // same for 16 bit per channel frame (16 bit buses get full precision)
+#endif
   [[gnu::hot]] uint32_t getPixelColor(unsigned pix);
-  void        show();
+  void        show();                            // sends data of all buses
+  inline void showBusses()               { for (auto &bus : busses) bus->show(); } // sends data of all buses (without ABL)
   bool        canAllShow();
   inline void setStatusPixel(uint32_t c) { for (auto &bus : busses) bus->setStatusPixel(c);}
   inline void setBrightness(uint8_t b)   { for (auto &bus : busses) bus->setBrightness(b); }
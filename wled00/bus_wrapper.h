@@ -904,6 +904,102 @@ class PolyBus {
     }
   }
 
+  // sets pixel of 16 bit RGB/RGBW/RGBCW buses (UCS8903/UCS8904/SM16825) with full precision, c holds 16 bit B, G, R, W channels (in that order)
+  [[gnu::hot]] static void setPixelColor16(void* busPtr, uint8_t busType, uint16_t pix, const uint16_t c[4], uint8_t co, uint16_t cctWW = 0, uint16_t cctCW = 0) {
+    const uint16_t r = c[2], g = c[1], b = c[0], w = c[3];
+    Rgbw64Color col;
+
+    // reorder channels to selected order
+    switch (co & 0x0F) {
+      default: col.G = g; col.R = r; col.B = b; break; //0 = GRB, default
+      case  1: col.G = r; col.R = g; col.B = b; break; //1 = RGB, common for WS2811
+      case  2: col.G = b; col.R = r; col.B = g; break; //2 = BRG
+      case  3: col.G = r; col.R = b; col.B = g; break; //3 = RBG
+      case  4: col.G = b; col.R = g; col.B = r; break; //4 = BGR
+      case  5: col.G = g; col.R = b; col.B = r; break; //5 = GBR
+    }
+    // upper nibble contains W swap information
+    switch (co >> 4) {
+      default: col.W = w;                break; // no swapping
+      case  1: col.W = col.B; col.B = w; break; // swap W & B
+      case  2: col.W = col.G; col.G = w; break; // swap W & G
+      case  3: col.W = col.R; col.R = w; break; // swap W & R
+      case  4: std::swap(cctWW, cctCW);  break; // swap WW & CW
+    }
+    switch (busType) {
+    #ifdef ESP8266
+      case I_8266_U0_UCS_3: (static_cast<B_8266_U0_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); break;
+      case I_8266_U1_UCS_3: (static_cast<B_8266_U1_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); break;
+      case I_8266_DM_UCS_3: (static_cast<B_8266_DM_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); break;
+      case I_8266_BB_UCS_3: (static_cast<B_8266_BB_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); break;
+      case I_8266_U0_UCS_4: (static_cast<B_8266_U0_UCS_4*>(busPtr))->SetPixelColor(pix, col); break;
+      case I_8266_U1_UCS_4: (static_cast<B_8266_U1_UCS_4*>(busPtr))->SetPixelColor(pix, col); break;
+      case I_8266_DM_UCS_4: (static_cast<B_8266_DM_UCS_4*>(busPtr))->SetPixelColor(pix, col); break;
+      case I_8266_BB_UCS_4: (static_cast<B_8266_BB_UCS_4*>(busPtr))->SetPixelColor(pix, col); break;
+      case I_8266_U0_SM16825_5: (static_cast<B_8266_U0_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, cctWW, cctCW)); break;
+      case I_8266_U1_SM16825_5: (static_cast<B_8266_U1_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, cctWW, cctCW)); break;
+      case I_8266_DM_SM16825_5: (static_cast<B_8266_DM_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, cctWW, cctCW)); break;
+      case I_8266_BB_SM16825_5: (static_cast<B_8266_BB_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, cctWW, cctCW)); break;
+    #endif
+    #ifdef ARDUINO_ARCH_ESP32
+      case I_32_RN_UCS_3: (static_cast<B_32_RN_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); break;
+      case I_32_RN_UCS_4: (static_cast<B_32_RN_UCS_4*>(busPtr))->SetPixelColor(pix, col); break;
+      case I_32_RN_SM16825_5: (static_cast<B_32_RN_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, cctWW, cctCW)); break;
+      #ifndef CONFIG_IDF_TARGET_ESP32C3
+      case I_32_I2_UCS_3: if (_useParallelI2S) (static_cast<B_32_IP_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); else (static_cast<B_32_I2_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); break;
+      case I_32_I2_UCS_4: if (_useParallelI2S) (static_cast<B_32_IP_UCS_4*>(busPtr))->SetPixelColor(pix, col); else (static_cast<B_32_I2_UCS_4*>(busPtr))->SetPixelColor(pix, col); break;
+      case I_32_I2_SM16825_5: if (_useParallelI2S) (static_cast<B_32_IP_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, cctWW, cctCW)); else (static_cast<B_32_I2_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, cctWW, cctCW)); break;
+      #endif
+    #endif
+    }
+  }
+
+  // returns pixel buffer of 8 bit GRB and GRBW buses for direct writing (bytes are sent in G,R,B,(W) order) and marks it dirty
+  // returns nullptr if bus uses a different layout (use setPixelColor() instead)
+  static uint8_t* getPixelBuffer(void* busPtr, uint8_t busType, unsigned &channels) {
+    uint8_t *pixels = nullptr;
+    channels = 3;
+    switch (busType) {
+    #ifdef ESP8266
+      case I_8266_U0_NEO_3: (static_cast<B_8266_U0_NEO_3*>(busPtr))->Dirty(); pixels = (static_cast<B_8266_U0_NEO_3*>(busPtr))->Pixels(); break;
+      case I_8266_U1_NEO_3: (static_cast<B_8266_U1_NEO_3*>(busPtr))->Dirty(); pixels = (static_cast<B_8266_U1_NEO_3*>(busPtr))->Pixels(); break;
+      case I_8266_DM_NEO_3: (static_cast<B_8266_DM_NEO_3*>(busPtr))->Dirty(); pixels = (static_cast<B_8266_DM_NEO_3*>(busPtr))->Pixels(); break;
+      case I_8266_BB_NEO_3: (static_cast<B_8266_BB_NEO_3*>(busPtr))->Dirty(); pixels = (static_cast<B_8266_BB_NEO_3*>(busPtr))->Pixels(); break;
+      case I_8266_U0_NEO_4: (static_cast<B_8266_U0_NEO_4*>(busPtr))->Dirty(); pixels = (static_cast<B_8266_U0_NEO_4*>(busPtr))->Pixels(); channels = 4; break;
+      case I_8266_U1_NEO_4: (static_cast<B_8266_U1_NEO_4*>(busPtr))->Dirty(); pixels = (static_cast<B_8266_U1_NEO_4*>(busPtr))->Pixels(); channels = 4; break;
+      case I_8266_DM_NEO_4: (static_cast<B_8266_DM_NEO_4*>(busPtr))->Dirty(); pixels = (static_cast<B_8266_DM_NEO_4*>(busPtr))->Pixels(); channels = 4; break;
+      case I_8266_BB_NEO_4: (static_cast<B_8266_BB_NEO_4*>(busPtr))->Dirty(); pixels = (static_cast<B_8266_BB_NEO_4*>(busPtr))->Pixels(); channels = 4; break;
+      case I_8266_U0_400_3: (static_cast<B_8266_U0_400_3*>(busPtr))->Dirty(); pixels = (static_cast<B_8266_U0_400_3*>(busPtr))->Pixels(); break;
+      case I_8266_U1_400_3: (static_cast<B_8266_U1_400_3*>(busPtr))->Dirty(); pixels = (static_cast<B_8266_U1_400_3*>(busPtr))->Pixels(); break;
+      case I_8266_DM_400_3: (static_cast<B_8266_DM_400_3*>(busPtr))->Dirty(); pixels = (static_cast<B_8266_DM_400_3*>(busPtr))->Pixels(); break;
+      case I_8266_BB_400_3: (static_cast<B_8266_BB_400_3*>(busPtr))->Dirty(); pixels = (static_cast<B_8266_BB_400_3*>(busPtr))->Pixels(); break;
+    #endif
+    #ifdef ARDUINO_ARCH_ESP32
+      // RMT buses
+      case I_32_RN_NEO_3: (static_cast<B_32_RN_NEO_3*>(busPtr))->Dirty(); pixels = (static_cast<B_32_RN_NEO_3*>(busPtr))->Pixels(); break;
+      case I_32_RN_NEO_4: (static_cast<B_32_RN_NEO_4*>(busPtr))->Dirty(); pixels = (static_cast<B_32_RN_NEO_4*>(busPtr))->Pixels(); channels = 4; break;
+      case I_32_RN_400_3: (static_cast<B_32_RN_400_3*>(busPtr))->Dirty(); pixels = (static_cast<B_32_RN_400_3*>(busPtr))->Pixels(); break;
+      // I2S1 bus or paralell buses
+      #ifndef CONFIG_IDF_TARGET_ESP32C3
+      case I_32_I2_NEO_3:
+        if (_useParallelI2S) { (static_cast<B_32_IP_NEO_3*>(busPtr))->Dirty(); pixels = (static_cast<B_32_IP_NEO_3*>(busPtr))->Pixels(); }
+        else                 { (static_cast<B_32_I2_NEO_3*>(busPtr))->Dirty(); pixels = (static_cast<B_32_I2_NEO_3*>(busPtr))->Pixels(); }
+        break;
+      case I_32_I2_NEO_4:
+        if (_useParallelI2S) { (static_cast<B_32_IP_NEO_4*>(busPtr))->Dirty(); pixels = (static_cast<B_32_IP_NEO_4*>(busPtr))->Pixels(); }
+        else                 { (static_cast<B_32_I2_NEO_4*>(busPtr))->Dirty(); pixels = (static_cast<B_32_I2_NEO_4*>(busPtr))->Pixels(); }
+        channels = 4;
+        break;
+      case I_32_I2_400_3:
+        if (_useParallelI2S) { (static_cast<B_32_IP_400_3*>(busPtr))->Dirty(); pixels = (static_cast<B_32_IP_400_3*>(busPtr))->Pixels(); }
+        else                 { (static_cast<B_32_I2_400_3*>(busPtr))->Dirty(); pixels = (static_cast<B_32_I2_400_3*>(busPtr))->Pixels(); }
+        break;
+      #endif
+    #endif
+    }
+    return pixels;
+  }
+
   [[gnu::hot]] static uint32_t getPixelColor(void* busPtr, uint8_t busType, uint16_t pix, uint8_t co) {
     RgbwColor col(0,0,0,0);
     switch (busType) {
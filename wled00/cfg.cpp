@@ -165,6 +165,8 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   uint8_t cctBlending = hw_led[F("cb")] | Bus::getCCTBlend();
   Bus::setCCTBlend(cctBlending);
   strip.setTargetFps(hw_led["fps"]); //NOP if 0, default 42 FPS
+  CJSON(strip.fpsGovernor, hw_led[F("fgov")]);
+  Bus::setGlobalDithering(hw_led[F("dith")] | Bus::getGlobalDithering());
   #if defined(ARDUINO_ARCH_ESP32) && !defined(CONFIG_IDF_TARGET_ESP32C3)
   CJSON(useParallelI2S, hw_led[F("prl")]);
   #endif
@@ -600,6 +602,9 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   JsonObject if_live_dmx = if_live["dmx"];
   CJSON(e131Universe, if_live_dmx[F("uni")]);
   CJSON(e131SkipOutOfSequence, if_live_dmx[F("seqskip")]);
+  CJSON(e131FrameSync, if_live_dmx[F("fsync")]);
+  CJSON(e131JitterMs, if_live_dmx[F("jitter")]);
+  if (e131JitterMs > 100) e131JitterMs = 100;
   CJSON(DMXAddress, if_live_dmx[F("addr")]);
   if (!DMXAddress || DMXAddress > 510) DMXAddress = 1;
   CJSON(DMXSegmentSpacing, if_live_dmx[F("dss")]);
@@ -943,6 +948,8 @@ void serializeConfig(JsonObject root) {
   hw_led[F("ic")] = cctICused;
   hw_led[F("cb")] = Bus::getCCTBlend();
   hw_led["fps"] = strip.getTargetFps();
+  hw_led[F("fgov")] = strip.fpsGovernor;
+  hw_led[F("dith")] = Bus::getGlobalDithering();
   hw_led[F("rgbwm")] = Bus::getGlobalAWMode(); // global auto white mode override
   #if defined(ARDUINO_ARCH_ESP32) && !defined(CONFIG_IDF_TARGET_ESP32C3)
   hw_led[F("prl")] = BusManager::hasParallelOutput();
@@ -1129,6 +1136,8 @@ void serializeConfig(JsonObject root) {
   JsonObject if_live_dmx = if_live.createNestedObject("dmx");
   if_live_dmx[F("uni")] = e131Universe;
   if_live_dmx[F("seqskip")] = e131SkipOutOfSequence;
+  if_live_dmx[F("fsync")] = e131FrameSync;
+  if_live_dmx[F("jitter")] = e131JitterMs;
   if_live_dmx[F("e131prio")] = e131Priority;
   if_live_dmx[F("addr")] = DMXAddress;
   if_live_dmx[F("dss")] = DMXSegmentSpacing;
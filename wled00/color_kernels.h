@@ -0,0 +1,130 @@
+#pragma once
+#ifndef WLED_COLOR_KERNELS_H
+#define WLED_COLOR_KERNELS_H
+
+/*
+ * Packed color kernels ("poor man's SIMD")
+ * 32bit WRGB colors are processed two channels at a time in 16bit lanes (R&B and W&G using 0x00FF00FF mask)
+ * or, where no carry can cross a channel boundary, all four channels at once.
+ * Single color versions are inlined into the span versions, which work directly on pixel buffers.
+ * Span versions that modify pixels in place return true if any pixel changed.
+ */
+#include <stdint.h>
+#include <stddef.h>
+
+#define PACKED_LANE_MASK 0x00FF00FFU
+
+// scales each channel by scale/256 (scale 0-256), same as color_fade(c, scale-1) (non-video)
+inline uint32_t packed_scale(uint32_t c, unsigned scale) {
+  const uint32_t rb = (((c & PACKED_LANE_MASK) * scale) >> 8) &  PACKED_LANE_MASK;
+  const uint32_t wg = (((c >> 8) & PACKED_LANE_MASK) * scale) & ~PACKED_LANE_MASK;
+  return rb | wg;
+}
+
+// blends c1 towards c2 by blend/255, see color_blend()
+inline uint32_t packed_blend(uint32_t c1, uint32_t c2, uint8_t blend) {
+  const uint32_t rb1 =  c1       & PACKED_LANE_MASK;
+  const uint32_t wg1 = (c1 >> 8) & PACKED_LANE_MASK;
+  const uint32_t rb2 =  c2       & PACKED_LANE_MASK;
+  const uint32_t wg2 = (c2 >> 8) & PACKED_LANE_MASK;
+  const uint32_t rb3 = ((((rb1 << 8) | rb2) + (rb2 * blend) - (rb1 * blend)) >> 8) &  PACKED_LANE_MASK;
+  const uint32_t wg3 = ((((wg1 << 8) | wg2) + (wg2 * blend) - (wg1 * blend)))      & ~PACKED_LANE_MASK;
+  return rb3 | wg3;
+}
+
+// saturating add of each channel (all four at once)
+inline uint32_t packed_add(uint32_t a, uint32_t b) {
+  const uint32_t t = (a & 0x7F7F7F7FU) + (b & 0x7F7F7F7FU);   // add lower 7 bits of each channel
+  const uint32_t s = t ^ ((a ^ b) & 0x80808080U);             // add MSBs
+  const uint32_t c = ((a & b) | ((a | b) & t)) & 0x80808080U; // carry out of each channel
+  return s | ((c >> 7) * 0xFFU);                              // saturate channels that overflowed
+}
+
+// saturating subtract a - b of each channel (all four at once)
+inline uint32_t packed_sub(uint32_t a, uint32_t b) {
+  const uint32_t d = ((a | 0x80808080U) - (b & 0x7F7F7F7FU)) ^ ((a ^ ~b) & 0x80808080U); // wrapping difference
+  const uint32_t c = ((~a & b) | (~(a ^ b) & d)) & 0x80808080U;                        // borrow out of each channel
+  return d & ~((c >> 7) * 0xFFU);                                                      // clamp channels that underflowed
+}
+
+// (a + b) / 2 of each channel (all four at once)
+inline uint32_t packed_average(uint32_t a, uint32_t b) {
+  return (a & b) + (((a ^ b) & 0xFEFEFEFEU) >> 1);
+}
+
+// moves each channel of c1 towards c2 by (c2-c1)*rate/256 (rounded towards 0) but by at least 1, rate 1-256
+inline uint32_t packed_fade_toward(uint32_t c1, uint32_t c2, unsigned rate) {
+  const auto lanes = [rate](uint32_t a, uint32_t b) -> uint32_t {     // two channels in 16bit lanes
+    const auto subSat  = [](uint32_t x, uint32_t y) -> uint32_t {     // max(x-y,0) per lane
+      const uint32_t t = (x | 0x01000100U) - y;                       // 256+x-y, cannot borrow from next lane
+      return t & ((t >> 8) & 0x00010001U) * 0xFFU;                    // keep lanes where x >= y
+    };
+    const auto nonZero = [](uint32_t x) -> uint32_t { return ((x + PACKED_LANE_MASK) >> 8) & 0x00010001U; };
+    const uint32_t up   = subSat(b, a);
+    const uint32_t down = subSat(a, b);
+    uint32_t dUp   = ((up   * rate) >> 8) & PACKED_LANE_MASK;
+    uint32_t dDown = ((down * rate) >> 8) & PACKED_LANE_MASK;
+    dUp   += nonZero(up)   & ~nonZero(dUp);   // make sure we move by at least 1
+    dDown += nonZero(down) & ~nonZero(dDown);
+    return a + dUp - dDown;                   // stays within [0,255] as delta never overshoots b
+  };
+  return lanes(c1 & PACKED_LANE_MASK, c2 & PACKED_LANE_MASK) | (lanes((c1 >> 8) & PACKED_LANE_MASK, (c2 >> 8) & PACKED_LANE_MASK) << 8);
+}
+
+// scales n pixels by scale/256 (see packed_scale())
+inline bool fade_span(uint32_t *px, size_t n, unsigned scale) {
+  uint32_t diff = 0;
+  for (size_t i = 0; i < n; i++) {
+    const uint32_t c = px[i];
+    if (c == 0) continue; // most faded pixels end up black
+    px[i] = packed_scale(c, scale);
+    diff |= c ^ px[i];
+  }
+  return diff;
+}
+
+// blends n pixels towards color c by blend/255 (see packed_blend())
+inline bool blend_span(uint32_t *px, size_t n, uint32_t c, uint8_t blend) {
+  uint32_t diff = 0;
+  for (size_t i = 0; i < n; i++) {
+    const uint32_t old = px[i];
+    px[i] = packed_blend(old, c, blend);
+    diff |= old ^ px[i];
+  }
+  return diff;
+}
+
+// moves n pixels towards color c (see packed_fade_toward())
+inline bool fade_toward_span(uint32_t *px, size_t n, uint32_t c, unsigned rate) {
+  uint32_t diff = 0;
+  for (size_t i = 0; i < n; i++) {
+    const uint32_t old = px[i];
+    if (old == c) continue; // already at target color
+    px[i] = packed_fade_toward(old, c, rate);
+    diff |= old ^ px[i];
+  }
+  return diff;
+}
+
+// saturating add of n pixels of src to dst
+inline void add_span(uint32_t *dst, const uint32_t *src, size_t n) {
+  for (size_t i = 0; i < n; i++) dst[i] = packed_add(dst[i], src[i]);
+}
+
+// blurs n pixels that are stride apart: each pixel keeps keep/256 of itself and gets seep/256 of both neighbours
+// (keep & seep 1-256, source: FastLED blur1d())
+inline void blur_span(uint32_t *px, size_t n, size_t stride, unsigned keep, unsigned seep) {
+  if (n == 0) return;
+  uint32_t carryover = 0;
+  uint32_t last = 0;
+  for (size_t i = 0; i < n; i++) {
+    const uint32_t cur  = px[i * stride];
+    const uint32_t part = packed_scale(cur, seep);
+    if (i > 0) px[(i - 1) * stride] = packed_add(last, part);
+    last      = packed_add(packed_scale(cur, keep), carryover);
+    carryover = part;
+  }
+  px[(n - 1) * stride] = last;
+}
+
+#endif
@@ -10,14 +10,7 @@
  */
 uint32_t IRAM_ATTR color_blend(uint32_t color1, uint32_t color2, uint8_t blend) {
   // min / max blend checking is omitted: calls with 0 or 255 are rare, checking lowers overall performance
-  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;     // mask for R and B channels or W and G if negated (poorman's SIMD; https://github.com/wled/WLED/pull/4568#discussion_r1986587221)
-  uint32_t rb1 =  color1       & TWO_CHANNEL_MASK;  // extract R & B channels from color1
-  uint32_t wg1 = (color1 >> 8) & TWO_CHANNEL_MASK;  // extract W & G channels from color1 (shifted for multiplication later)
-  uint32_t rb2 =  color2       & TWO_CHANNEL_MASK;  // extract R & B channels from color2
-  uint32_t wg2 = (color2 >> 8) & TWO_CHANNEL_MASK;  // extract W & G channels from color2 (shifted for multiplication later)
-  uint32_t rb3 = ((((rb1 << 8) | rb2) + (rb2 * blend) - (rb1 * blend)) >> 8) &  TWO_CHANNEL_MASK; // blend red and blue
-  uint32_t wg3 = ((((wg1 << 8) | wg2) + (wg2 * blend) - (wg1 * blend)))      & ~TWO_CHANNEL_MASK; // negated mask for white and green
-  return rb3 | wg3;
+  return packed_blend(color1, color2, blend); // two channels at a time (see color_kernels.h)
 }
 
 /*
@@ -29,6 +22,7 @@ uint32_t color_add(uint32_t c1, uint32_t c2, bool preserveCR)
 {
   if (c1 == BLACK) return c2;
   if (c2 == BLACK) return c1;
+  if (!preserveCR) return packed_add(c1, c2); // saturate each channel (all four at once)
   const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF; // mask for R and B channels or W and G if negated
   uint32_t rb = ( c1     & TWO_CHANNEL_MASK) + ( c2     & TWO_CHANNEL_MASK); // mask and add two colors at once
   uint32_t wg = ((c1>>8) & TWO_CHANNEL_MASK) + ((c2>>8) & TWO_CHANNEL_MASK);
@@ -37,27 +31,20 @@ uint32_t color_add(uint32_t c1, uint32_t c2, bool preserveCR)
   uint32_t w = wg >> 16;
   uint32_t g = wg & 0xFFFF;
 
-  if (preserveCR) { // preserve color ratios
-    uint32_t max = std::max(r,g); // check for overflow note
-    max = std::max(max,b);
-    max = std::max(max,w);
-    //unsigned max = r; // check for overflow note
-    //max = g > max ? g : max;
-    //max = b > max ? b : max;
-    //max = w > max ? w : max;
-    if (max > 255) {
-      const uint32_t scale = (uint32_t(255)<<8) / max; // division of two 8bit (shifted) values does not work -> use bit shifts and multiplaction instead
-      rb = ((rb * scale) >> 8) &  TWO_CHANNEL_MASK;
-      wg =  (wg * scale)       & ~TWO_CHANNEL_MASK;
-    } else wg <<= 8; //shift white and green back to correct position
-    return rb | wg;
-  } else {
-    r = r > 255 ? 255 : r;
-    g = g > 255 ? 255 : g;
-    b = b > 255 ? 255 : b;
-    w = w > 255 ? 255 : w;
-    return RGBW32(r,g,b,w);
-  }
+  // preserve color ratios
+  uint32_t max = std::max(r,g); // check for overflow note
+  max = std::max(max,b);
+  max = std::max(max,w);
+  //unsigned max = r; // check for overflow note
+  //max = g > max ? g : max;
+  //max = b > max ? b : max;
+  //max = w > max ? w : max;
+  if (max > 255) {
+    const uint32_t scale = (uint32_t(255)<<8) / max; // division of two 8bit (shifted) values does not work -> use bit shifts and multiplaction instead
+    rb = ((rb * scale) >> 8) &  TWO_CHANNEL_MASK;
+    wg =  (wg * scale)       & ~TWO_CHANNEL_MASK;
+  } else wg <<= 8; //shift white and green back to correct position
+  return rb | wg;
 }
 
 /*
@@ -80,10 +67,7 @@ uint32_t IRAM_ATTR color_fade(uint32_t c1, uint8_t amount, bool video) {
     addRemains |= b && b > quarterMax ? 0x00000001 : 0;
     addRemains |= w ? 0x01000000 : 0;
   }
-  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
-  uint32_t rb = (((c1 & TWO_CHANNEL_MASK) * amount) >> 8) &  TWO_CHANNEL_MASK; // scale red and blue
-  uint32_t wg = (((c1 >> 8) & TWO_CHANNEL_MASK) * amount) & ~TWO_CHANNEL_MASK; // scale white and green
-  return (rb | wg) + addRemains;
+  return packed_scale(c1, amount) + addRemains; // scale two channels at a time
 }
 
 /*
@@ -583,6 +567,7 @@ uint16_t approximateKelvinFromRGB(uint32_t rgb) {
 // gamma lookup tables used for color correction (filled on 1st use (cfg.cpp & set.cpp))
 uint8_t NeoGammaWLEDMethod::gammaT[256];
 uint8_t NeoGammaWLEDMethod::gammaT_inv[256];
+uint16_t NeoGammaWLEDMethod::gammaT16[256];
 
 // re-calculates & fills gamma tables
 void NeoGammaWLEDMethod::calcGammaTable(float gamma)
@@ -591,10 +576,12 @@ void NeoGammaWLEDMethod::calcGammaTable(float gamma)
   for (size_t i = 1; i < 256; i++) {
     gammaT[i] = (int)(powf((float)i / 255.0f, gamma) * 255.0f + 0.5f);
     gammaT_inv[i] = (int)(powf(((float)i - 0.5f) / 255.0f, gamma_inv) * 255.0f + 0.5f);
+    gammaT16[i] = (int)(powf((float)i / 255.0f, gamma) * 65280.0f + 0.5f); // 8.8 fixed point, 255.0 max
     //DEBUG_PRINTF_P(PSTR("gammaT[%d] = %d gammaT_inv[%d] = %d\n"), i, gammaT[i], i, gammaT_inv[i]);
   }
   gammaT[0] = 0;
   gammaT_inv[0] = 0;
+  gammaT16[0] = 0;
 }
 
 uint8_t IRAM_ATTR_YN NeoGammaWLEDMethod::Correct(uint8_t value)
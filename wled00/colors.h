@@ -7,6 +7,7 @@
  */
 #include <vector>
 #include "FastLED.h"
+#include "color_kernels.h"
 
 #define ColorFromPalette ColorFromPaletteWLED // override fastled version
 
@@ -100,6 +101,11 @@ class NeoGammaWLEDMethod {
     static void calcGammaTable(float gamma);                        // re-calculates & fills gamma tables
     static inline uint8_t rawGamma8(uint8_t val) { return gammaT[val]; }  // get value from Gamma table (WLED specific, not used by NPB)
     static inline uint8_t rawInverseGamma8(uint8_t val) { return gammaT_inv[val]; }  // get value from inverse Gamma table (WLED specific, not used by NPB)
+    static inline uint16_t rawGamma16(uint8_t val) { return gammaT16[val]; }  // get 8.8 fixed point value from Gamma table (used for dithering and 16 bit output)
+    static inline uint16_t Correct16(uint16_t val) { // apply Gamma to 8.8 fixed point value (0-65280), interpolates between table entries
+      const unsigned i = val >> 8, f = val & 0xFF;
+      return (f && i < 255) ? gammaT16[i] + (((gammaT16[i+1] - gammaT16[i]) * f) >> 8) : gammaT16[i];
+    }
     static inline uint32_t Correct32(uint32_t color) { // apply Gamma to RGBW32 color (WLED specific, not used by NPB)
       if (!gammaCorrectCol) return color; // no gamma correction
       uint8_t  w = byte(color>>24), r = byte(color>>16), g = byte(color>>8), b = byte(color); // extract r, g, b, w channels
@@ -109,13 +115,43 @@ class NeoGammaWLEDMethod {
   private:
     static uint8_t gammaT[];
     static uint8_t gammaT_inv[];
+    static uint16_t gammaT16[];
 };
 #define gamma32(c) NeoGammaWLEDMethod::Correct32(c)
 #define gamma8(c)  NeoGammaWLEDMethod::rawGamma8(c)
 #define gamma32inv(c) NeoGammaWLEDMethod::inverseGamma32(c)
 #define gamma8inv(c)  NeoGammaWLEDMethod::rawInverseGamma8(c)
+#define gamma16(c)    NeoGammaWLEDMethod::rawGamma16(c)
 [[gnu::hot, gnu::pure]] uint32_t color_blend(uint32_t c1, uint32_t c2 , uint8_t blend);
 inline uint32_t color_blend16(uint32_t c1, uint32_t c2, uint16_t b) { return color_blend(c1, c2, b >> 8); };
+
+// frame buffer pixel: 32 bit WRGB or, if WLED_PIXEL16 is defined, 64 bit WRGB with 16 bits per channel (for 16 bit buses)
+// effects and segments always use 32 bit colors, toPixel() and fromPixel() convert them to and from frame buffer pixels
+#ifdef WLED_PIXEL16
+typedef uint64_t pixel_t;
+inline pixel_t toPixel(uint32_t c) { // 0xFF -> 0xFFFF
+  const uint64_t p = (uint64_t(c & 0xFF000000U) << 24) | (uint64_t(c & 0x00FF0000U) << 16) | ((c & 0x0000FF00U) << 8) | (c & 0xFFU);
+  return p | (p << 8);
+}
+inline uint32_t fromPixel(pixel_t p) { // (v - v/256 + 128) / 256 rounds each channel (all four at once), 0xFFFF -> 0xFF
+  const uint64_t lanes = ((p - ((p >> 8) & 0x00FF00FF00FF00FFULL) + 0x0080008000800080ULL) >> 8) & 0x00FF00FF00FF00FFULL;
+  const uint64_t pairs = lanes | (lanes >> 8);
+  return uint32_t(pairs & 0xFFFF) | uint32_t((pairs >> 16) & 0xFFFF0000U);
+}
+inline pixel_t pixel_blend16(pixel_t p1, pixel_t p2, uint16_t blend) { // blends p1 towards p2 by blend/65535
+  const uint32_t w = blend + (blend >> 15); // 0-65536, so 0xFFFF returns p2
+  pixel_t p = 0;
+  for (unsigned i = 0; i < 64; i += 16) p |= pixel_t((uint32_t((p1 >> i) & 0xFFFF) * (65536 - w) + uint32_t((p2 >> i) & 0xFFFF) * w) >> 16) << i;
+  return p;
+}
+inline pixel_t pixel_blend(pixel_t p1, pixel_t p2, uint8_t blend) { return pixel_blend16(p1, p2, blend * 257); }
+#else
+typedef uint32_t pixel_t;
+inline pixel_t  toPixel(uint32_t c)   { return c; }
+inline uint32_t fromPixel(pixel_t p)  { return p; }
+inline pixel_t  pixel_blend16(pixel_t p1, pixel_t p2, uint16_t blend) { return color_blend16(p1, p2, blend); }
+inline pixel_t  pixel_blend(pixel_t p1, pixel_t p2, uint8_t blend)    { return color_blend(p1, p2, blend); }
+#endif
 [[gnu::hot, gnu::pure]] uint32_t color_add(uint32_t, uint32_t, bool preserveCR = false);
 [[gnu::hot, gnu::pure]] uint32_t adjust_color(uint32_t rgb, uint32_t hueShift, uint32_t lighten, uint32_t brighten);
 [[gnu::hot, gnu::pure]] uint32_t ColorFromPaletteWLED(const CRGBPalette16 &pal, unsigned index, uint8_t brightness = (uint8_t)255U, TBlendType blendType = LINEARBLEND);
@@ -1,17 +1,242 @@
 #include "wled.h"
+#include <atomic>
 
 #define MAX_3_CH_LEDS_PER_UNIVERSE 170
 #define MAX_4_CH_LEDS_PER_UNIVERSE 128
 #define MAX_CHANNELS_PER_UNIVERSE 512
+#define DMX_STAGED_UNIVERSE_SIZE (MAX_CHANNELS_PER_UNIVERSE+1) // E1.31 data includes the start code
+#define ARTNET_SYNC_TIMEOUT 4000 // Art-Net 4: receivers revert to unsynchronized output 4s after the last ArtSync
+#define DMX_SENDER_UNIVERSE_FRAMES 8 // a universe missing from this many frames in a row is no longer waited for
 
 /*
  * E1.31 handler
  */
 
+/*
+ * DDP frame reassembler.
+ * Packets are staged per sequence number into one of DDP_FRAME_SLOTS frame slots. A frame is complete once its push
+ * packet and all data up to it have arrived; it is then handed to the loop (handleDDPFrames()), which shows it at its
+ * timecode (if any, relative to NTP time) or right away. Packets of frames already shown are late and dropped,
+ * incomplete frames are dropped once a newer frame completes.
+ * Senders that number packets rather than frames (older WLED, "assuming 4 packets max. before push") are detected by a
+ * push packet arriving alone while the packet numbered before it still waits for its push; their frames are then
+ * delimited by the push packet only, like those of senders that do not number anything.
+ * Slot ownership: FREE/RECEIVING slots belong to the packet callback, READY slots to the loop.
+ */
+#define DDP_FRAME_SLOTS 3
+#define DDP_MAX_CHUNKS 64             // packets per frame (64 x 1440 bytes is more than any supported LED count)
+#define DDP_FRAME_TIMEOUT 1000        // receiving frames older than this are stale
+#define DDP_MAX_TIMECODE_DELAY 1000   // frames timed further ahead are shown right away (bogus or unsynced sender clock)
+
+enum : uint8_t { DDP_SLOT_FREE, DDP_SLOT_RECEIVING, DDP_SLOT_READY };
+
+typedef struct DDPChunk {
+  uint32_t offset;
+  uint16_t length;
+} ddp_chunk_t;
+
+typedef struct DDPFrameSlot {
+  std::atomic<uint8_t> state;
+  uint8_t       seq;            // sequence number (0 = sender does not number frames)
+  uint8_t       channelsPerLed;
+  bool          pushed;         // push packet received
+  bool          timecoded;      // a packet carried a timecode
+  uint8_t       chunks;
+  uint32_t      timecode;       // NTP time, 16 bit seconds and 16 bit fraction
+  uint32_t      minOffset;      // lowest channel offset received
+  uint32_t      end;            // channel offset past the push packet's data
+  uint32_t      bytes;          // unique bytes received
+  unsigned long started;        // millis() of the first packet
+  unsigned long due;            // loop: millis() the frame is shown at
+  bool          scheduled;      // loop: due has been computed
+  ddp_chunk_t   chunk[DDP_MAX_CHUNKS];
+} ddp_frame_slot_t;
+
+static ddp_frame_slot_t ddpSlots[DDP_FRAME_SLOTS];
+static uint8_t         *ddpStaging = nullptr;
+static size_t           ddpSlotSize = 0; // bytes per slot (0 = not allocated)
+static uint8_t          ddpLastSeq = 0;  // sequence number of the last frame handed to the loop
+static uint32_t         ddpFrameStart = UINT32_MAX; // lowest channel offset seen since the sender started (frames cover it onwards)
+static bool             ddpSeqPerPacket = false;    // sender numbers packets, not frames
+static DDPFrameStats    ddpFrameStats;
+
+const DDPFrameStats& getDDPFrameStats() {
+  return ddpFrameStats;
+}
+
+// true if sequence number a (1-15) is not newer than b
+static inline bool ddpSeqNotNewer(unsigned a, unsigned b) {
+  return (b + 15 - a) % 15 < 8;
+}
+
+static inline uint8_t *ddpSlotData(const ddp_frame_slot_t &slot) {
+  return ddpStaging + (&slot - ddpSlots) * ddpSlotSize;
+}
+
+static void dropDDPFrame(ddp_frame_slot_t &slot) {
+  ddpFrameStats.dropped++;
+  slot.state = DDP_SLOT_FREE;
+}
+
+// true if the packet numbered before seq was staged and still waits for a push (sequence numbers run 1-15)
+static bool ddpPrecedingPacketWaits(unsigned seq) {
+  const unsigned prev = seq == 1 ? 15 : seq - 1;
+  for (const auto &s : ddpSlots) if (s.state == DDP_SLOT_RECEIVING && s.seq == prev && !s.pushed) return true;
+  return false;
+}
+
+static ddp_frame_slot_t *getDDPFrameSlot(unsigned seq, unsigned channelsPerLed) {
+  ddp_frame_slot_t *slot = nullptr;
+  for (auto &s : ddpSlots) if (s.state == DDP_SLOT_RECEIVING && s.seq == seq) return &s;
+  if (seq && ddpLastSeq && ddpSeqNotNewer(seq, ddpLastSeq)) {
+    ddpFrameStats.late++; // frame was shown or superseded already
+    return nullptr;
+  }
+  for (auto &s : ddpSlots) {
+    if (s.state == DDP_SLOT_RECEIVING && millis() - s.started > DDP_FRAME_TIMEOUT) dropDDPFrame(s);
+    if (s.state == DDP_SLOT_FREE) { slot = &s; break; }
+    if (s.state == DDP_SLOT_RECEIVING && (!slot || (long)(slot->started - s.started) > 0)) slot = &s;
+  }
+  if (!slot) {
+    ddpFrameStats.dropped++; // all slots wait for the loop
+    return nullptr;
+  }
+  if (slot->state == DDP_SLOT_RECEIVING) dropDDPFrame(*slot); // oldest incomplete frame makes room
+  slot->seq = seq;
+  slot->channelsPerLed = channelsPerLed;
+  slot->pushed = slot->timecoded = false;
+  slot->chunks = 0;
+  slot->minOffset = UINT32_MAX;
+  slot->end = slot->bytes = 0;
+  slot->started = millis();
+  slot->state = DDP_SLOT_RECEIVING;
+  return slot;
+}
+
+// returns false if the packet has to be applied immediately (reassembler unavailable)
+static bool stageDDPPacket(e131_packet_t* p, unsigned channelsPerLed) {
+  const size_t slotSize = strip.getLengthTotal() * 4;
+  if (slotSize != ddpSlotSize || !ddpStaging) {
+    for (const auto &s : ddpSlots) if (s.state == DDP_SLOT_READY) return true; // loop still reads the buffer, drop packet
+    d_free(ddpStaging);
+    ddpStaging = static_cast<uint8_t*>(allocate_buffer(DDP_FRAME_SLOTS * slotSize, BFRALLOC_PREFER_PSRAM));
+    ddpSlotSize = ddpStaging ? slotSize : 0;
+    for (auto &s : ddpSlots) s.state = DDP_SLOT_FREE;
+  }
+  if (!ddpStaging) return false;
+
+  const unsigned seq = ddpSeqPerPacket ? 0 : p->sequenceNum & 0xF;
+  ddp_frame_slot_t *slot = getDDPFrameSlot(seq, channelsPerLed);
+  if (!slot) return true;
+
+  const uint32_t offset = htonl(p->channelOffset);
+  uint32_t length = htons(p->dataLen);
+  const uint8_t *data = p->data;
+  if (p->flags & DDP_TIMECODE_FLAG) {
+    slot->timecode = (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16) | (uint32_t(data[2]) << 8) | data[3];
+    slot->timecoded = true;
+    data += 4;
+  }
+  for (unsigned i = 0; i < slot->chunks; i++) {
+    if (slot->chunk[i].offset == offset) {
+      ddpFrameStats.dup++;
+      return true;
+    }
+  }
+  if (slot->chunks < DDP_MAX_CHUNKS && offset < ddpSlotSize) {
+    if (length > ddpSlotSize - offset) length = ddpSlotSize - offset;
+    memcpy(ddpSlotData(*slot) + offset, data, length);
+    slot->chunk[slot->chunks++] = {offset, (uint16_t)length};
+  }
+  if (offset < slot->minOffset) slot->minOffset = offset;
+  if (offset < ddpFrameStart)    ddpFrameStart = offset;
+  slot->bytes += htons(p->dataLen);
+  if (p->flags & DDP_PUSH_FLAG) {
+    slot->pushed = true;
+    slot->end = offset + htons(p->dataLen);
+  }
+  // a frame whose first packets are missing must not pass for complete, hence the start learned from earlier frames
+  if (!slot->pushed || slot->bytes < slot->end - std::min(slot->minOffset, ddpFrameStart)) {
+    if (slot->pushed && seq && slot->chunks == 1 && ddpPrecedingPacketWaits(seq)) {
+      ddpSeqPerPacket = true; // packets of this frame are spread over several slots, start over with the next frame
+      for (auto &s : ddpSlots) if (s.state == DDP_SLOT_RECEIVING) dropDDPFrame(s);
+    } else if (slot->pushed && !seq) {
+      dropDDPFrame(*slot); // unnumbered frames end with their push, packets after it belong to the next frame
+    }
+    return true;
+  }
+
+  // complete: older frames still receiving are superseded
+  for (auto &s : ddpSlots) {
+    if (&s != slot && s.state == DDP_SLOT_RECEIVING && (!seq || !s.seq || ddpSeqNotNewer(s.seq, seq))) dropDDPFrame(s);
+  }
+  ddpFrameStats.complete++;
+  if (seq) ddpLastSeq = seq;
+  slot->scheduled = false;
+  slot->state = DDP_SLOT_READY;
+  return true;
+}
+
+// millis() a frame with the given timecode is due at
+static unsigned long getDDPFrameDue(uint32_t timecode) {
+  if (toki.getTimeSource() < TOKI_TS_MS) return millis(); // no millisecond accurate time to relate to
+  const Toki::Time now = toki.getTime();
+  const int16_t secs = (timecode >> 16) - ((now.sec + YEARS_70) & 0xFFFF);
+  const int32_t delay = secs * 1000 + int32_t(((timecode & 0xFFFF) * 1000) >> 16) - now.ms;
+  if (delay <= 0 || delay > DDP_MAX_TIMECODE_DELAY) return millis();
+  ddpFrameStats.timed++;
+  return millis() + delay;
+}
+
+// loop: show reassembled DDP frames once due, returns true if the strip needs to be shown now
+bool handleDDPFrames() {
+  bool shown = false;
+  for (;;) {
+    ddp_frame_slot_t *next = nullptr;
+    for (auto &s : ddpSlots) {
+      if (s.state != DDP_SLOT_READY) continue;
+      if (!s.scheduled) {
+        s.due = s.timecoded ? getDDPFrameDue(s.timecode) : millis();
+        s.scheduled = true;
+      }
+      if ((long)(millis() - s.due) >= 0 && (!next || (long)(next->due - s.due) > 0)) next = &s;
+    }
+    if (!next) break;
+    if (!realtimeOverride) {
+      const uint8_t *data = ddpSlotData(*next);
+      const unsigned ch = next->channelsPerLed;
+      for (unsigned i = 0; i < next->chunks; i++) {
+        const ddp_chunk_t &c = next->chunk[i];
+        setRealtimePixels(c.offset / ch + DMXAddress / ch, data + c.offset, c.length / ch, ch, ch > 3);
+      }
+    }
+    ddpFrameStats.shown++;
+    next->state = DDP_SLOT_FREE;
+    shown = true;
+  }
+  return shown;
+}
+
 //DDP protocol support, called by handleE131Packet
 //handles RGB data only
 void handleDDPPacket(e131_packet_t* p) {
   static bool ddpSeenPush = false;  // have we seen a push yet?
+
+  unsigned ddpChannelsPerLed = ((p->dataType & 0b00111000)>>3 == 0b011) ? 4 : 3; // data type 0x1B (formerly 0x1A) is RGBW (type 3, 8 bit/channel)
+
+  if (realtimeMode != REALTIME_MODE_DDP) { // just starting, no push yet
+    ddpSeenPush = false;
+    ddpLastSeq = 0;
+    ddpFrameStart = UINT32_MAX;
+    ddpSeqPerPacket = false;
+  }
+  realtimeLock(realtimeTimeoutMs, REALTIME_MODE_DDP);
+
+  bool push = p->flags & DDP_PUSH_FLAG;
+  ddpSeenPush |= push;
+  // senders that push get their frames reassembled, others are shown packet by packet
+  if (ddpSeenPush && stageDDPPacket(p, ddpChannelsPerLed)) return;
+
   int lastPushSeq = e131LastSequenceNumber[0];
 
   //reject late packets belonging to previous frame (assuming 4 packets max. before push)
@@ -26,26 +251,15 @@ void handleDDPPacket(e131_packet_t* p) {
     }
   }
 
-  unsigned ddpChannelsPerLed = ((p->dataType & 0b00111000)>>3 == 0b011) ? 4 : 3; // data type 0x1B (formerly 0x1A) is RGBW (type 3, 8 bit/channel)
-
   uint32_t start =  htonl(p->channelOffset) / ddpChannelsPerLed;
   start += DMXAddress / ddpChannelsPerLed;
   unsigned stop = start + htons(p->dataLen) / ddpChannelsPerLed;
   uint8_t* data = p->data;
   unsigned c = 0;
-  if (p->flags & DDP_TIMECODE_FLAG) c = 4; //packet has timecode flag, we do not support it, but data starts 4 bytes later
+  if (p->flags & DDP_TIMECODE_FLAG) c = 4; //packet has timecode flag, data starts 4 bytes later
 
-  if (realtimeMode != REALTIME_MODE_DDP) ddpSeenPush = false; // just starting, no push yet
-  realtimeLock(realtimeTimeoutMs, REALTIME_MODE_DDP);
+  if (!realtimeOverride) setRealtimePixels(start, data + c, stop - start, ddpChannelsPerLed, ddpChannelsPerLed > 3);
 
-  if (!realtimeOverride) {
-    for (unsigned i = start; i < stop; i++, c += ddpChannelsPerLed) {
-      setRealtimePixel(i, data[c], data[c+1], data[c+2], ddpChannelsPerLed >3 ? data[c+3] : 0);
-    }
-  }
-
-  bool push = p->flags & DDP_PUSH_FLAG;
-  ddpSeenPush |= push;
   if (!ddpSeenPush || push) { // if we've never seen a push, or this is one, render display
     e131NewData = true;
     int sn = p->sequenceNum & 0xF;
@@ -53,12 +267,168 @@ void handleDDPPacket(e131_packet_t* p) {
   }
 }
 
+// number of consecutive universes needed for the configured LED count (DMX_MODE_MULTIPLE_* only span more than one)
+static unsigned getDMXUniverseCount() {
+  if (DMXMode != DMX_MODE_MULTIPLE_RGB && DMXMode != DMX_MODE_MULTIPLE_RGBW && DMXMode != DMX_MODE_MULTIPLE_DRGB) return 1;
+  const bool is4Chan = (DMXMode == DMX_MODE_MULTIPLE_RGBW);
+  const unsigned dmxChannelsPerLed = is4Chan ? 4 : 3;
+  const unsigned dimmerOffset = (DMXMode == DMX_MODE_MULTIPLE_DRGB) ? 1 : 0;
+  const unsigned dmxLenOffset = (DMXAddress == 0) ? 0 : 1; // For legacy DMX start address 0
+  const unsigned ledsInFirstUniverse = (((MAX_CHANNELS_PER_UNIVERSE - DMXAddress) + dmxLenOffset) - dimmerOffset) / dmxChannelsPerLed;
+  const unsigned totalLen = strip.getLengthTotal();
+  if (totalLen <= ledsInFirstUniverse) return 1;
+  const unsigned ledsPerUniverse = is4Chan ? MAX_4_CH_LEDS_PER_UNIVERSE : MAX_3_CH_LEDS_PER_UNIVERSE;
+  const unsigned universes = 1 + (totalLen - ledsInFirstUniverse + ledsPerUniverse - 1) / ledsPerUniverse;
+  return universes > E131_MAX_UNIVERSE_COUNT ? E131_MAX_UNIVERSE_COUNT : universes;
+}
+
+/*
+ * Frame assembler for DMX modes spanning multiple universes.
+ * Universes are staged into one of two frame slots (the frame being received and the one after it) and are handed
+ * to handleDMXData() together once the frame is complete, once the sender's sync packet (E1.31 universe sync or
+ * ArtSync) arrives, or once late universes did not show up within e131JitterMs after the next frame started.
+ * A frame is complete once the universes the sender actually uses have arrived: universes missing from the last
+ * DMX_SENDER_UNIVERSE_FRAMES frames (sender covering fewer LEDs than configured) are not waited for.
+ * Everything here runs in the packet callback context only.
+ */
+typedef struct DMXFrameSlot {
+  uint32_t      received;   // bitmask of staged universes (relative to e131Universe)
+  unsigned long started;    // millis() when the first universe of the frame arrived
+  uint8_t       mode;       // REALTIME_MODE_E131 or REALTIME_MODE_ARTNET
+  uint16_t      channels[E131_MAX_UNIVERSE_COUNT];
+  uint8_t      *data;       // DMX_STAGED_UNIVERSE_SIZE bytes per universe
+} dmx_frame_slot_t;
+
+static dmx_frame_slot_t dmxSlots[2];
+static uint8_t         *dmxStaging = nullptr;
+static unsigned         dmxStagedUniverses = 0; // universes per slot (0 = not allocated)
+static uint16_t         dmxSyncAddress = 0;     // E1.31 synchronization universe of the last data packet (0 = unsynchronized)
+static unsigned long    dmxArtSyncTime = 0;     // millis() of the last ArtSync
+static bool             dmxSyncMissed = false;  // last frame was shown without waiting for its (late) sync packet
+static uint32_t         dmxSenderMask = 0;      // universes the sender used recently (0 = not known yet)
+static uint8_t          dmxUniverseAge[E131_MAX_UNIVERSE_COUNT]; // frames since each universe was last received
+static uint8_t          dmxUniverseSeq[E131_MAX_UNIVERSE_COUNT]; // sequence number of the last staged packet of each universe
+static DMXFrameStats    dmxFrameStats;
+
+const DMXFrameStats& getDMXFrameStats() {
+  return dmxFrameStats;
+}
+
+static inline uint32_t dmxFrameMask() {
+  return (1UL << dmxStagedUniverses) - 1;
+}
+
+// universes a frame is complete with
+static inline uint32_t dmxExpectedMask() {
+  return dmxSenderMask ? dmxSenderMask : dmxFrameMask();
+}
+
+static inline bool dmxFrameComplete(const dmx_frame_slot_t &slot) {
+  const uint32_t expected = dmxExpectedMask();
+  return (slot.received & expected) == expected;
+}
+
+static inline bool dmxWaitForSync() {
+  return dmxSyncAddress || (dmxArtSyncTime && millis() - dmxArtSyncTime < ARTNET_SYNC_TIMEOUT);
+}
+
+// hand the oldest staged frame to handleDMXData() and make the next one the oldest
+static void presentDMXFrame(bool synced) {
+  dmx_frame_slot_t &frame = dmxSlots[0];
+  const uint32_t missing = dmxExpectedMask() & ~frame.received;
+  dmxFrameStats.frames++;
+  if (synced)  dmxFrameStats.synced++;
+  if (missing) dmxFrameStats.partial++;
+  dmxSenderMask = 0;
+  for (unsigned i = 0; i < dmxStagedUniverses; i++) {
+    if (frame.received & (1UL << i)) {
+      handleDMXData(e131Universe + i, frame.channels[i], frame.data + i * DMX_STAGED_UNIVERSE_SIZE, frame.mode, i);
+      dmxUniverseAge[i] = 0;
+    } else {
+      if (missing & (1UL << i)) dmxFrameStats.lost[i]++; // universes missing from a partial frame keep their previous data
+      if (dmxUniverseAge[i] < 255) dmxUniverseAge[i]++;
+    }
+    if (dmxUniverseAge[i] < DMX_SENDER_UNIVERSE_FRAMES) dmxSenderMask |= 1UL << i;
+  }
+  frame.received = 0;
+  std::swap(dmxSlots[0], dmxSlots[1]);
+}
+
+// true if the sequence number shows that the universe skipped a frame, i.e. it was lost from the oldest staged frame
+// and belongs to the next one (rather than being a late packet of the oldest frame)
+static bool dmxSkippedFrame(unsigned index, uint8_t seq, uint8_t mde) {
+  if (!seq || dmxUniverseAge[index] == 255) return false; // Art-Net without sequence numbers or universe not seen yet
+  unsigned step = uint8_t(seq - dmxUniverseSeq[index]);
+  if (mde == REALTIME_MODE_ARTNET && seq < dmxUniverseSeq[index]) step--; // Art-Net sequence wraps from 255 to 1
+  return step > 1;
+}
+
+// returns false if the universe has to be applied immediately (assembler unavailable)
+static bool stageDMXUniverse(unsigned index, uint16_t dmxChannels, const uint8_t *data, uint8_t mde, uint16_t syncAddress, uint8_t seq) {
+  const unsigned universes = getDMXUniverseCount();
+  if (universes != dmxStagedUniverses || !dmxStaging) {
+    d_free(dmxStaging);
+    dmxStaging = static_cast<uint8_t*>(allocate_buffer(2 * universes * DMX_STAGED_UNIVERSE_SIZE, BFRALLOC_PREFER_PSRAM));
+    dmxStagedUniverses = dmxStaging ? universes : 0;
+    for (unsigned s = 0; s < 2; s++) {
+      dmxSlots[s].received = 0;
+      dmxSlots[s].data = dmxStaging ? dmxStaging + s * universes * DMX_STAGED_UNIVERSE_SIZE : nullptr;
+    }
+    memset(&dmxFrameStats, 0, sizeof(dmxFrameStats));
+    dmxFrameStats.universes = dmxStagedUniverses;
+    memset(dmxUniverseAge, 255, sizeof(dmxUniverseAge));
+    dmxSenderMask = 0;
+  }
+  if (!dmxStaging) return false;
+  if (index >= dmxStagedUniverses) return true; // carries no LEDs
+
+  dmxSyncAddress = syncAddress;
+  if (syncAddress && e131Multicast) e131SyncUniverse = syncAddress;
+
+  const uint32_t bit = 1UL << index;
+  dmx_frame_slot_t *slot = &dmxSlots[0];
+  if ((slot->received & bit) || (dmxSlots[1].received && dmxSkippedFrame(index, seq, mde))) {
+    if (dmxSlots[1].received & bit) presentDMXFrame(false); // sender is two frames ahead, stop waiting for the oldest one
+    slot = &dmxSlots[1];
+  }
+  if (!slot->received) {
+    slot->started = millis();
+    slot->mode = mde;
+  }
+  if (dmxChannels > MAX_CHANNELS_PER_UNIVERSE) dmxChannels = MAX_CHANNELS_PER_UNIVERSE;
+  memcpy(slot->data + index * DMX_STAGED_UNIVERSE_SIZE, data, dmxChannels + (mde == REALTIME_MODE_E131)); // E1.31 data starts with the start code
+  slot->channels[index] = dmxChannels;
+  slot->received |= bit;
+  dmxUniverseSeq[index] = seq;
+
+  const bool waitSync = dmxWaitForSync();
+  for (;;) {
+    if (!waitSync && dmxFrameComplete(dmxSlots[0])) {
+      presentDMXFrame(false);
+    } else if (dmxSlots[1].received && (dmxFrameComplete(dmxSlots[1]) || millis() - dmxSlots[1].started >= e131JitterMs)) {
+      dmxSyncMissed = waitSync;
+      presentDMXFrame(false); // give up on late universes (or a late sync packet)
+    } else break;
+  }
+  return true;
+}
+
+// E1.31 universe sync or ArtSync: show the staged frame
+static void handleDMXSync() {
+  if (!dmxStagedUniverses || !dmxSlots[0].received) return;
+  // a sync packet arriving after its frame was already shown must not show the partially received next frame
+  const bool late = dmxSyncMissed && !dmxFrameComplete(dmxSlots[0]) && !dmxSlots[1].received;
+  dmxSyncMissed = false;
+  if (!late) presentDMXFrame(true);
+}
+
 //E1.31 and Art-Net protocol support
 void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
 
   int uni = 0, dmxChannels = 0;
   uint8_t* e131_data = nullptr;
   int seq = 0, mde = REALTIME_MODE_E131;
+  uint16_t syncAddress = 0;
 
   if (protocol == P_ARTNET)
   {
@@ -66,12 +436,25 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
       handleArtnetPollReply(clientIP);
       return;
     }
+    if (p->art_opcode == ARTNET_OPCODE_OPSYNC) {
+      // Art-Net 4: ArtSync from a controller other than the one sending ArtDmx is ignored
+      if (clientIP != realtimeIP) return;
+      dmxArtSyncTime = millis();
+      if (!dmxArtSyncTime) dmxArtSyncTime = 1;
+      handleDMXSync();
+      return;
+    }
     uni = p->art_universe;
     dmxChannels = htons(p->art_length);
     e131_data = p->art_data;
     seq = p->art_sequence_number;
     mde = REALTIME_MODE_ARTNET;
   } else if (protocol == P_E131) {
+    if (htonl(p->root_vector) == E131_VECTOR_ROOT_EXTENDED) {
+      // universe synchronization packet (E1.31: 6.3), only the sync universe announced in data packets counts
+      if (dmxSyncAddress && htons(p->sync_universe) == dmxSyncAddress) handleDMXSync();
+      return;
+    }
     // Ignore PREVIEW data (E1.31: 6.2.6)
     if ((p->options & 0x80) != 0) return;
     dmxChannels = htons(p->property_value_count) - 1;
@@ -80,6 +463,7 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
     uni = htons(p->universe);
     e131_data = p->property_values;
     seq = p->sequence_number;
+    syncAddress = htons(p->sync_address);
     if (e131Priority != 0) {
       if (p->priority < e131Priority ) return;
       // track highest priority & skip all lower priorities
@@ -116,11 +500,11 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
   // update status info
   realtimeIP = clientIP;
 
+  if (e131FrameSync && stageDMXUniverse(previousUniverses, dmxChannels, e131_data, mde, syncAddress, seq)) return;
   handleDMXData(uni, dmxChannels, e131_data, mde, previousUniverses);
 }
 
 void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8_t mde, uint8_t previousUniverses) {
-  byte wChannel = 0;
   unsigned totalLen = strip.getLengthTotal();
   unsigned availDMXLen = 0;
   unsigned dataOffset = DMXAddress;
@@ -151,9 +535,7 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
 
       if (realtimeOverride) return;
 
-      wChannel = (availDMXLen > 3) ? e131_data[dataOffset+3] : 0;
-      for (unsigned i = 0; i < totalLen; i++)
-        setRealtimePixel(i, e131_data[dataOffset+0], e131_data[dataOffset+1], e131_data[dataOffset+2], wChannel);
+      setRealtimePixels(0, &e131_data[dataOffset], totalLen, 0, availDMXLen > 3); // stride 0: same color for all LEDs
       break;
 
     case DMX_MODE_SINGLE_DRGB:  // 4 channel: [Dimmer,R,G,B]
@@ -162,15 +544,13 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
 
       realtimeLock(realtimeTimeoutMs, mde);
       if (realtimeOverride) return;
-      wChannel = (availDMXLen > 4) ? e131_data[dataOffset+4] : 0;
 
       if (bri != e131_data[dataOffset+0]) {
         bri = e131_data[dataOffset+0];
         strip.setBrightness(bri, true);
       }
 
-      for (unsigned i = 0; i < totalLen; i++)
-        setRealtimePixel(i, e131_data[dataOffset+1], e131_data[dataOffset+2], e131_data[dataOffset+3], wChannel);
+      setRealtimePixels(0, &e131_data[dataOffset+1], totalLen, 0, availDMXLen > 4);
       break;
 
     case DMX_MODE_PRESET:       // 2 channel: [Dimmer,Preset]
@@ -313,10 +693,7 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
           }
         }
 
-        for (unsigned i = previousLeds; i < ledsTotal; i++) {
-          setRealtimePixel(i, e131_data[dmxOffset], e131_data[dmxOffset+1], e131_data[dmxOffset+2], is4Chan ? e131_data[dmxOffset+3] : 0);
-          dmxOffset += dmxChannelsPerLed;
-        }
+        if (ledsTotal > previousLeds) setRealtimePixels(previousLeds, &e131_data[dmxOffset], ledsTotal - previousLeds, dmxChannelsPerLed, is4Chan);
         break;
       }
     default:
@@ -351,30 +728,8 @@ void handleArtnetPollReply(IPAddress ipAddress) {
     case DMX_MODE_MULTIPLE_DRGB:
     case DMX_MODE_MULTIPLE_RGB:
     case DMX_MODE_MULTIPLE_RGBW:
-      {
-        bool is4Chan = (DMXMode == DMX_MODE_MULTIPLE_RGBW);
-        const unsigned dmxChannelsPerLed = is4Chan ? 4 : 3;
-        const unsigned dimmerOffset = (DMXMode == DMX_MODE_MULTIPLE_DRGB) ? 1 : 0;
-        const unsigned dmxLenOffset = (DMXAddress == 0) ? 0 : 1; // For legacy DMX start address 0
-        const unsigned ledsInFirstUniverse = (((MAX_CHANNELS_PER_UNIVERSE - DMXAddress) + dmxLenOffset) - dimmerOffset) / dmxChannelsPerLed;
-        const unsigned totalLen = strip.getLengthTotal();
-
-        if (totalLen > ledsInFirstUniverse) {
-          const unsigned ledsPerUniverse = is4Chan ? MAX_4_CH_LEDS_PER_UNIVERSE : MAX_3_CH_LEDS_PER_UNIVERSE;
-          const unsigned remainLED = totalLen - ledsInFirstUniverse;
-
-          endUniverse += (remainLED / ledsPerUniverse);
-
-          if ((remainLED % ledsPerUniverse) > 0) {
-            endUniverse++;
-          }
-
-          if ((endUniverse - startUniverse) > E131_MAX_UNIVERSE_COUNT) {
-            endUniverse = startUniverse + E131_MAX_UNIVERSE_COUNT - 1;
-          }
-        }
-        break;
-      }
+      endUniverse += getDMXUniverseCount() - 1;
+      break;
     default:
       DEBUG_PRINTLN(F("unknown E1.31 DMX mode"));
       return;  // nothing to do
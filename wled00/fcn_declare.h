@@ -82,6 +82,24 @@ void initDMXInput();
 void handleDMXInput();
 
 //e131.cpp
+typedef struct DMXFrameStats {
+  uint32_t frames;   // frames handed to the strip
+  uint32_t partial;  // frames shown with universes missing
+  uint32_t synced;   // frames shown on an E1.31 universe sync or ArtSync packet
+  uint16_t universes;// universes per frame (0 = frame assembler inactive)
+  uint16_t lost[E131_MAX_UNIVERSE_COUNT]; // per universe: frames it was missing from
+} dmx_frame_stats_t;
+const DMXFrameStats& getDMXFrameStats();
+typedef struct DDPFrameStats {
+  uint32_t complete; // frames fully received
+  uint32_t shown;    // frames shown
+  uint32_t timed;    // frames held back until their timecode
+  uint32_t dropped;  // frames discarded incomplete or for lack of a free slot
+  uint32_t late;     // packets of frames already shown or superseded
+  uint32_t dup;      // duplicate packets
+} ddp_frame_stats_t;
+const DDPFrameStats& getDDPFrameStats();
+bool handleDDPFrames();
 void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol);
 void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8_t mde, uint8_t previousUniverses);
 void handleArtnetPollReply(IPAddress ipAddress);
@@ -158,6 +176,7 @@ void serializeState(JsonObject root, bool forPreset = false, bool includeBri = t
 void serializeInfo(JsonObject root);
 void serializeModeNames(JsonArray arr);
 void serializeModeData(JsonArray fxdata);
+uint32_t serializePerf(JsonObject root, uint32_t since = 0);
 void serveJson(AsyncWebServerRequest* request);
 #ifdef WLED_ENABLE_JSONLIVE
 bool serveLiveLeds(AsyncWebServerRequest* request, uint32_t wsClient = 0);
@@ -239,11 +258,12 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply=tru
 
 //udp.cpp
 void notify(byte callMode, bool followUp=false);
-uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t* buffer, uint8_t bri=255, bool isRGBW=false);
+bool realtimeSendPacket(IPAddress client, uint16_t port, const uint8_t *packet, size_t len);
 void realtimeLock(uint32_t timeoutMs, byte md = REALTIME_MODE_GENERIC);
 void exitRealtime();
 void handleNotifications();
 void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w);
+void setRealtimePixels(unsigned i, const uint8_t *data, size_t count, unsigned stride, bool white);
 void refreshNodeList();
 void sendSysInfoUDP();
 #ifndef WLED_DISABLE_ESPNOW
@@ -473,6 +493,44 @@ inline size_t getContiguousFreeHeap() { return ESP.getMaxFreeBlockSize(); } // r
 #define BFRALLOC_CLEAR           (1 << 5) // clear allocated buffer after allocation
 void *allocate_buffer(size_t size, uint32_t type);
 
+// buffer arena: long lived buffers are sub-allocated from one heap block so that reconfiguration does not fragment the heap (util.cpp)
+// each buffer knows its owner (the pointer variable holding it) which is updated when compact() moves the buffer
+// buffers that do not fit are allocated from heap (same type), release() frees either kind; not thread safe
+class BufferArena {
+  public:
+    struct Stats {
+      uint32_t size;        // arena size
+      uint32_t used;        // bytes used by buffers (including headers)
+      uint32_t largestFree; // largest free block
+      uint16_t buffers;     // buffers in arena
+      uint16_t heapBuffers; // buffers that did not fit and were allocated from heap
+      uint32_t compactions;
+    };
+
+    static constexpr size_t ALIGNMENT      = 8;                                          // frame buffer may hold 64 bit pixels
+    static constexpr size_t HEADER_SIZE    = (sizeof(uint32_t) + sizeof(void*) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    static constexpr size_t BLOCK_OVERHEAD = HEADER_SIZE + ALIGNMENT - 1;                // worst case per buffer, used for sizing arenas
+
+    constexpr BufferArena(uint32_t type) : _base(nullptr), _size(0), _type(type), _heapBuffers(0), _compactions(0), _fragmented(false) {}
+
+    bool  resize(size_t size);                                // (re)allocates arena, live buffers are moved (fails if they do not fit)
+    void *allocate(size_t size, void **owner, bool clear = false);
+    void  release(void *ptr);                                 // frees buffer from arena or heap
+    void  rebind(void *ptr, void **owner);                    // buffer is now held by a different pointer variable (owner was moved)
+    void  compact();                                          // moves buffers to start of arena, must not be called while buffers are in use
+    inline bool owns(const void *ptr) const { return (uintptr_t)ptr >= (uintptr_t)_base && (uintptr_t)ptr < (uintptr_t)_base + _size; }
+    inline bool isFragmented() const        { return _fragmented; } // a buffer below other buffers was freed or allocation spilled to heap
+    Stats getStats() const;
+
+  private:
+    uint8_t *_base;
+    size_t   _size;
+    uint32_t _type;         // BFRALLOC_* flags for arena and heap fallback
+    uint16_t _heapBuffers;
+    uint32_t _compactions;
+    bool     _fragmented;
+};
+
 void handleBootLoop();   // detect and handle bootloops
 #ifndef ESP8266
 void bootloopCheckOTA(); // swap boot image if bootloop is detected instead of restoring config
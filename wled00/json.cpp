@@ -689,6 +689,18 @@ void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segme
   }
 }
 
+// arena usage: size, used, largest free block (bytes), buffers in arena, buffers spilled to heap, compactions
+static void serializeArena(JsonObject &root, const __FlashStringHelper *key, const BufferArena::Stats &stats)
+{
+  JsonArray arena = root.createNestedArray(key);
+  arena.add(stats.size);
+  arena.add(stats.used);
+  arena.add(stats.largestFree);
+  arena.add(stats.buffers);
+  arena.add(stats.heapBuffers);
+  arena.add(stats.compactions);
+}
+
 void serializeInfo(JsonObject root)
 {
   root[F("ver")] = versionString;
@@ -701,6 +713,20 @@ void serializeInfo(JsonObject root)
   leds[F("count")] = strip.getLengthTotal();
   leds[F("pwr")] = BusManager::currentMilliamps();
   leds["fps"] = strip.getFps();
+  if (strip.isThrottled()) leds[F("gfps")] = 1000 / strip.getGovernedFrameTime(); // refresh rate lowered by governor
+  leds[F("cpx")] = strip.getCompositedPixels(); // segment pixels blended into the frame buffer by the last show()
+  JsonObject stage = leds.createNestedObject(F("stage")); // time spent in each frame stage (us)
+  stage["fx"]      = strip.getStageTimes().effects;
+  stage[F("comp")] = strip.getStageTimes().composite;
+  stage[F("out")]  = strip.getStageTimes().output;
+  stage[F("wait")] = strip.getStageTimes().wait;
+  leds[F("pipe")]  = strip.isPipelined(); // frames are sent by output task on second core
+  leds[F("fbuf")]  = strip.getFrameBufferSize(); // RAM used by frame buffer(s), 8 bytes per LED with WLED_PIXEL16
+  JsonArray wire = leds.createNestedArray(F("wire")); // time each bus took to send its last frame (us)
+  for (size_t i = 0; i < BusManager::getNumBusses(); i++) wire.add(BusManager::getBus(i)->getWireTime());
+  JsonObject arena = leds.createNestedObject(F("arena")); // frame/segment pixel buffers and effect data (see serializeArena())
+  serializeArena(arena, F("px"), Segment::getPixelArenaStats());
+  serializeArena(arena, F("fx"), Segment::getDataArenaStats());
   leds[F("maxpwr")] = BusManager::currentMilliamps()>0 ? BusManager::ablMilliampsMax() : 0;
   leds[F("maxseg")] = WS2812FX::getMaxSegments();
   //leds[F("actseg")] = strip.getActiveSegmentsNum();
@@ -716,9 +742,11 @@ void serializeInfo(JsonObject root)
   #endif
 
   unsigned totalLC = 0;
+  size_t geomMapSize = 0;
   JsonArray lcarr = leds.createNestedArray(F("seglc")); // deprecated, use state.seg[].lc
   size_t nSegs = strip.getSegmentsNum();
   for (size_t s = 0; s < nSegs; s++) {
+    geomMapSize += strip.getSegment(s).getGeometryMapSize();
     if (!strip.getSegment(s).isActive()) continue;
     unsigned lc = strip.getSegment(s).getLightCapabilities();
     totalLC |= lc;
@@ -726,6 +754,7 @@ void serializeInfo(JsonObject root)
   }
 
   leds["lc"] = totalLC;
+  leds[F("gmap")] = geomMapSize; // RAM used by cached 1D->2D expansion maps (see Segment::getGeometryMap())
 
   leds[F("rgbw")] = strip.hasRGBWBus(); // deprecated, use info.leds.lc
   leds[F("wv")]   = totalLC & 0x02;     // deprecated, true if white slider should be displayed for any segment
@@ -759,10 +788,33 @@ void serializeInfo(JsonObject root)
     case REALTIME_MODE_ARTNET:   root["lm"] = F("Art-Net"); break;
     case REALTIME_MODE_TPM2NET:  root["lm"] = F("tpm2.net"); break;
     case REALTIME_MODE_DDP:      root["lm"] = F("DDP"); break;
+    case REALTIME_MODE_WS:       root["lm"] = F("WebSocket"); break;
   }
 
   root[F("lip")] = realtimeIP[0] == 0 ? "" : realtimeIP.toString();
 
+  const DMXFrameStats &dmxStats = getDMXFrameStats();
+  if (dmxStats.universes) {
+    JsonObject dmx = root.createNestedObject(F("dmx")); // E1.31/Art-Net frame assembler
+    dmx[F("uni")]   = dmxStats.universes;
+    dmx[F("fr")]    = dmxStats.frames;
+    dmx[F("part")]  = dmxStats.partial;
+    dmx[F("sync")]  = dmxStats.synced;
+    JsonArray lost = dmx.createNestedArray(F("lost"));
+    for (unsigned i = 0; i < dmxStats.universes; i++) lost.add(dmxStats.lost[i]);
+  }
+
+  const DDPFrameStats &ddpStats = getDDPFrameStats();
+  if (ddpStats.complete || ddpStats.dropped) {
+    JsonObject ddp = root.createNestedObject(F("ddp")); // DDP frame reassembler
+    ddp[F("fr")]   = ddpStats.complete;
+    ddp[F("show")] = ddpStats.shown;
+    ddp[F("tc")]   = ddpStats.timed;
+    ddp[F("drop")] = ddpStats.dropped;
+    ddp[F("late")] = ddpStats.late;
+    ddp[F("dup")]  = ddpStats.dup;
+  }
+
   #ifdef WLED_ENABLE_WEBSOCKETS
   root[F("ws")] = ws.count();
   #else
@@ -1037,6 +1089,45 @@ void serializeNodes(JsonObject root)
   }
 }
 
+// frame profiler data, frames are sent oldest first as [frame, fx, comp, remap, abl, tx, wait, segs] (times in us)
+// only frames newer than "since" are included, returns number of next frame (for streaming)
+uint32_t serializePerf(JsonObject root, uint32_t since)
+{
+  const uint32_t frames = strip.getProfiledFrames();
+  unsigned count = min(frames - min(since, frames), (uint32_t)WLED_PERF_FRAMES);
+  root[F("frames")] = frames;
+  root["fps"]       = strip.getFps();
+  root[F("target")] = strip.getTargetFps();
+
+  JsonArray hist = root.createNestedArray(F("hist"));
+  while (count--) {
+    const WS2812FX::FrameProfile &fp = strip.getFrameProfile(count);
+    JsonArray frame = hist.createNestedArray();
+    frame.add(fp.frame);
+    frame.add(fp.effects);
+    frame.add(fp.composite);
+    frame.add(fp.remap);
+    frame.add(fp.abl);
+    frame.add(fp.transmit);
+    frame.add(fp.wait);
+    frame.add(fp.segments);
+  }
+
+  JsonArray seg = root.createNestedArray("seg"); // effect function time per segment (moving average)
+  for (size_t s = 0; s < strip.getSegmentsNum(); s++) seg.add(strip.getSegmentTime(s));
+
+  JsonArray fx = root.createNestedArray("fx");   // [id, runs, total us] of effects that ran since boot
+  for (size_t i = 0; i < strip.getModeCount(); i++) {
+    const WS2812FX::EffectCost *cost = strip.getEffectCost(i);
+    if (!cost || !cost->runs) continue;
+    JsonArray effect = fx.createNestedArray();
+    effect.add(i);
+    effect.add(cost->runs);
+    effect.add(cost->time);
+  }
+  return frames;
+}
+
 // deserializes mode data string into JsonArray
 void serializeModeData(JsonArray fxdata)
 {
@@ -1095,7 +1186,7 @@ class LockedJsonResponse: public AsyncJsonResponse {
 void serveJson(AsyncWebServerRequest* request)
 {
   enum class json_target {
-    all, state, info, state_info, nodes, effects, palettes, fxdata, networks, config
+    all, state, info, state_info, nodes, effects, palettes, fxdata, networks, config, perf
   };
   json_target subJson = json_target::all;
 
@@ -1109,6 +1200,7 @@ void serveJson(AsyncWebServerRequest* request)
   else if (url.indexOf(F("fxda"))  > 0) subJson = json_target::fxdata;
   else if (url.indexOf(F("net"))   > 0) subJson = json_target::networks;
   else if (url.indexOf(F("cfg"))   > 0) subJson = json_target::config;
+  else if (url.indexOf(F("perf"))  > 0) subJson = json_target::perf;
   #ifdef WLED_ENABLE_JSONLIVE
   else if (url.indexOf("live")     > 0) {
     serveLiveLeds(request);
@@ -1152,6 +1244,8 @@ void serveJson(AsyncWebServerRequest* request)
       serializeNetworks(lDoc); break;
     case json_target::config:
       serializeConfig(lDoc); break;
+    case json_target::perf:
+      serializePerf(lDoc); break;
     case json_target::state_info:
     case json_target::all:
       JsonObject state = lDoc.createNestedObject("state");
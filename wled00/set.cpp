@@ -155,6 +155,8 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     Bus::setCCTBlend(cctBlending);
     Bus::setGlobalAWMode(request->arg(F("AW")).toInt());
     strip.setTargetFps(request->arg(F("FR")).toInt());
+    strip.fpsGovernor = request->hasArg(F("FG"));
+    Bus::setGlobalDithering(request->hasArg(F("DTH")));
     #if defined(ARDUINO_ARCH_ESP32) && !defined(CONFIG_IDF_TARGET_ESP32C3)
     useParallelI2S = request->hasArg(F("PR"));
     #endif
@@ -417,6 +419,9 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     useMainSegmentOnly = request->hasArg(F("MO"));
     realtimeRespectLedMaps = request->hasArg(F("RLM"));
     e131SkipOutOfSequence = request->hasArg(F("ES"));
+    e131FrameSync = request->hasArg(F("EF"));
+    t = request->arg(F("EJ")).toInt();
+    if (t >= 0  && t <= 100) e131JitterMs = t;
     e131Multicast = request->hasArg(F("EM"));
     t = request->arg(F("EP")).toInt();
     if (t > 0) e131Port = t;
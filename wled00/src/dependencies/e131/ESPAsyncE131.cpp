@@ -86,11 +86,29 @@ bool ESPAsyncE131::initMulticast(uint16_t port, uint16_t universe, uint8_t n) {
 
     udp.onPacket(std::bind(&ESPAsyncE131::parsePacket, this, std::placeholders::_1));
 
+    _universe = universe;
+    _universes = n;
     success = true;
   }
   return success;
 }
 
+void ESPAsyncE131::joinSyncUniverse(uint16_t universe) {
+  if (!_universes || universe == _syncUniverse) return; // unicast or already joined
+  if (universe >= _universe && universe < _universe + _universes) return; // joined by begin()
+
+  ip4_addr_t ifaddr;
+  ip4_addr_t multicast_addr;
+  ifaddr.addr = static_cast<uint32_t>(Network.localIP());
+  if (_syncUniverse) {
+    multicast_addr.addr = static_cast<uint32_t>(IPAddress(239, 255, ((_syncUniverse >> 8) & 0xff), (_syncUniverse & 0xff)));
+    igmp_leavegroup(&ifaddr, &multicast_addr);
+  }
+  multicast_addr.addr = static_cast<uint32_t>(IPAddress(239, 255, ((universe >> 8) & 0xff), (universe & 0xff)));
+  igmp_joingroup(&ifaddr, &multicast_addr);
+  _syncUniverse = universe;
+}
+
 /////////////////////////////////////////////////////////
 //
 // Packet parsing - Private
@@ -110,8 +128,11 @@ void ESPAsyncE131::parsePacket(AsyncUDPPacket _packet) {
 	if (protocol == P_ARTNET) {
 		if (memcmp(sbuff->art_id, ESPAsyncE131::ART_ID, sizeof(sbuff->art_id)))
 			error = true; //not "Art-Net"
-		if (sbuff->art_opcode != ARTNET_OPCODE_OPDMX && sbuff->art_opcode != ARTNET_OPCODE_OPPOLL)
-			error = true; //not a DMX or poll packet
+		if (sbuff->art_opcode != ARTNET_OPCODE_OPDMX && sbuff->art_opcode != ARTNET_OPCODE_OPPOLL && sbuff->art_opcode != ARTNET_OPCODE_OPSYNC)
+			error = true; //not a DMX, poll or sync packet
+	} else if (htonl(sbuff->root_vector) == E131_VECTOR_ROOT_EXTENDED) { //E1.31 synchronization packet
+		if (htonl(sbuff->sync_vector) != E131_VECTOR_EXTENDED_SYNCHRONIZATION || _packet.length() < E131_SYNC_ADDR + 2)
+			error = true;
 	} else { //E1.31 error handling
 		if (htonl(sbuff->root_vector) != ESPAsyncE131::VECTOR_ROOT)
 			error = true;
@@ -57,6 +57,7 @@ typedef struct ip_addr ip4_addr_t;
 #define DDP_TYPE_RGBW32 0x1B // 00 011 011 (RGBW, 8 bits per channel, 4 channels)
 
 #define ARTNET_OPCODE_OPDMX 0x5000
+#define ARTNET_OPCODE_OPSYNC 0x5200
 #define ARTNET_OPCODE_OPPOLL 0x2000
 #define ARTNET_OPCODE_OPPOLLREPLY 0x2100
 
@@ -76,7 +77,7 @@ typedef struct ip_addr ip4_addr_t;
 #define E131_FRAME_VECTOR 40
 #define E131_FRAME_SOURCE 44
 #define E131_FRAME_PRIORITY 108
-#define E131_FRAME_RESERVED 109
+#define E131_FRAME_SYNC_ADDR 109
 #define E131_FRAME_SEQ 111
 #define E131_FRAME_OPT 112
 #define E131_FRAME_UNIVERSE 113
@@ -89,6 +90,12 @@ typedef struct ip_addr ip4_addr_t;
 #define E131_DMP_COUNT 123
 #define E131_DMP_DATA 125
 
+// E1.31 synchronization packet (E1.31-2016: 6.3)
+#define E131_VECTOR_ROOT_EXTENDED 8
+#define E131_VECTOR_EXTENDED_SYNCHRONIZATION 1
+#define E131_SYNC_SEQ 44
+#define E131_SYNC_ADDR 45
+
 // E1.31 Packet Structure
 typedef union {
     struct { //E1.31 packet
@@ -105,7 +112,7 @@ typedef union {
       uint32_t frame_vector;
       uint8_t  source_name[64];
       uint8_t  priority;
-      uint16_t reserved;
+      uint16_t sync_address;      // universe the sender synchronizes on (0 = unsynchronized)
       uint8_t  sequence_number;
       uint8_t  options;
       uint16_t universe;
@@ -132,6 +139,15 @@ typedef union {
     uint8_t  art_data[512];
   } __attribute__((packed));
 
+  struct { //E1.31 synchronization packet (root layer as above)
+    uint8_t  sync_root_layer[38];
+    uint16_t sync_flength;
+    uint32_t sync_vector;
+    uint8_t  sync_sequence_number;
+    uint16_t sync_universe;
+    uint16_t sync_reserved;
+  } __attribute__((packed));
+
   struct { //DDP Header
     uint8_t flags;
     uint8_t sequenceNum;
@@ -211,6 +227,9 @@ class ESPAsyncE131 {
     static const uint8_t VECTOR_DMP = 2;
 
     AsyncUDP        udp;        // AsyncUDP
+    uint16_t        _universe = 0;  // first multicast universe joined by begin()
+    uint8_t         _universes = 0; // number of multicast universes joined by begin() (0 = unicast)
+    uint16_t        _syncUniverse = 0; // additional multicast universe joined for synchronization packets
 
     // Internal Initializers
     bool initUnicast(uint16_t port);
@@ -226,6 +245,9 @@ class ESPAsyncE131 {
 
     // Generic UDP listener, no physical or IP configuration
     bool begin(bool multicast, uint16_t port = E131_DEFAULT_PORT, uint16_t universe = 1, uint8_t n = 1);
+
+    // Join the multicast group of a synchronization universe outside the range joined by begin()
+    void joinSyncUniverse(uint16_t universe);
 };
 
 // Class to track e131 package priority
@@ -474,13 +474,17 @@ void handleNotifications()
     notify(notificationSentCallMode,true);
   }
 
-  if (e131NewData && millis() - strip.getLastShow() > 15)
+  // reassembled DDP frames are shown as soon as they are due (timecode), not throttled
+  if (handleDDPFrames() || (e131NewData && millis() - strip.getLastShow() > 15))
   {
     e131NewData = false;
     if (useMainSegmentOnly) strip.trigger();
     else                    strip.show();
   }
 
+  //E1.31 sync universe announced by the sender may lie outside the joined multicast groups (not safe to join from packet context)
+  if (e131Multicast && e131SyncUniverse) e131.joinSyncUniverse(e131SyncUniverse);
+
   //unlock strip when realtime UDP times out
   if (realtimeMode && millis() > realtimeTimeout) exitRealtime();
 
@@ -506,10 +510,7 @@ void handleNotifications()
       rgbUdp.read(lbuf, packetSize);
       realtimeLock(realtimeTimeoutMs, REALTIME_MODE_HYPERION);
       if (realtimeOverride) return;
-      unsigned totalLen = strip.getLengthTotal();
-      for (size_t i = 0, id = 0; i < packetSize -2 && id < totalLen; i += 3, id++) {
-        setRealtimePixel(id, lbuf[i], lbuf[i+1], lbuf[i+2], 0);
-      }
+      setRealtimePixels(0, lbuf, packetSize / 3, 3, false);
       if (useMainSegmentOnly) strip.trigger();
       else                    strip.show();
       return;
@@ -586,10 +587,9 @@ void handleNotifications()
       byte numPackets = udpIn[5];
 
       unsigned id = (tpmPayloadFrameSize/3)*(packetNum-1); //start LED
-      unsigned totalLen = strip.getLengthTotal();
-      for (size_t i = 6; i < tpmPayloadFrameSize + 4U && id < totalLen; i += 3, id++) {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-      }
+      size_t count = tpmPayloadFrameSize / 3;
+      if (packetSize < 6 + count * 3) count = packetSize > 6 ? (packetSize - 6) / 3 : 0; // do not read beyond packet
+      setRealtimePixels(id, udpIn + 6, count, 3, false);
       if (tpmPacketCount == numPackets) { //reset packet count and show if all packets were received
         tpmPacketCount = 0;
         if (useMainSegmentOnly) strip.trigger();
@@ -612,30 +612,20 @@ void handleNotifications()
       }
       if (realtimeOverride) return;
 
-      unsigned totalLen = strip.getLengthTotal();
-      if (udpIn[0] == 1 && packetSize > 5) { //warls
+      if (udpIn[0] == 1 && packetSize > 5) { //warls (indexed pixels)
         for (size_t i = 2; i < packetSize -3; i += 4) {
           setRealtimePixel(udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3], 0);
         }
       } else if (udpIn[0] == 2 && packetSize > 4) { //drgb
-        for (size_t i = 2, id = 0; i < packetSize -2 && id < totalLen; i += 3, id++)
-          {
-            setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-          }
+        setRealtimePixels(0, udpIn + 2, (packetSize - 2) / 3, 3, false);
       } else if (udpIn[0] == 3 && packetSize > 6) { //drgbw
-          for (size_t i = 2, id = 0; i < packetSize -3 && id < totalLen; i += 4, id++) {
-            setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-          }
+        setRealtimePixels(0, udpIn + 2, (packetSize - 2) / 4, 4, true);
       } else if (udpIn[0] == 4 && packetSize > 7) { //dnrgb
         unsigned id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-        for (size_t i = 4; i < packetSize -2 && id < totalLen; i += 3, id++) {
-          setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-        }
+        setRealtimePixels(id, udpIn + 4, (packetSize - 4) / 3, 3, false);
       } else if (udpIn[0] == 5 && packetSize > 8) { //dnrgbw
         unsigned id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-        for (size_t i = 4; i < packetSize -2 && id < totalLen; i += 4, id++) {
-          setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-        }
+        setRealtimePixels(id, udpIn + 4, (packetSize - 4) / 4, 4, true);
       }
       if (useMainSegmentOnly) strip.trigger();
       else                    strip.show();
@@ -669,6 +659,12 @@ void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w)
   strip.setRealtimePixelColor(pix, RGBW32(r,g,b,w));
 }
 
+// bulk version of setRealtimePixel(): count pixels of R,G,B[,W] channels, stride bytes apart
+void setRealtimePixels(unsigned i, const uint8_t *data, size_t count, unsigned stride, bool white)
+{
+  strip.ingestPixels(int(i) + arlsOffset, data, count, stride, white);
+}
+
 /*********************************************************************************************\
    Refresh aging for remote units, drop if too old...
 \*********************************************************************************************/
@@ -748,170 +744,31 @@ void sendSysInfoUDP()
 
 
 /*********************************************************************************************\
- * Art-Net, DDP, E131 output - work in progress
+ * Art-Net, DDP, E131 output
 \*********************************************************************************************/
 
-#define DDP_HEADER_LEN 10
-#define DDP_SYNCPACKET_LEN 10
-
-#define DDP_FLAGS1_VER 0xc0  // version mask
-#define DDP_FLAGS1_VER1 0x40 // version=1
-#define DDP_FLAGS1_PUSH 0x01
-#define DDP_FLAGS1_QUERY 0x02
-#define DDP_FLAGS1_REPLY 0x04
-#define DDP_FLAGS1_STORAGE 0x08
-#define DDP_FLAGS1_TIME 0x10
-
-#define DDP_ID_DISPLAY 1
-#define DDP_ID_CONFIG 250
-#define DDP_ID_STATUS 251
-
-// 1440 channels per packet
-#define DDP_CHANNELS_PER_PACKET 1440 // 480 leds
-
 //
-// Send real time UDP updates to the specified client
+// Send a pre-built real time UDP packet to the specified client (packets are built by BusNetwork)
+// all network outputs share a single persistent socket (netOutUdp)
 //
-// type   - protocol type (0=DDP, 1=E1.31, 2=ArtNet)
 // client - the IP address to send to
-// length - the number of pixels
-// buffer - a buffer of at least length*4 bytes long
-// isRGBW - true if the buffer contains 4 components per pixel
-
-static       size_t sequenceNumber = 0; // this needs to be shared across all outputs
-static const size_t ART_NET_HEADER_SIZE = 12;
-static const byte   ART_NET_HEADER[] PROGMEM = {0x41,0x72,0x74,0x2d,0x4e,0x65,0x74,0x00,0x00,0x50,0x00,0x0e};
-
-uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t *buffer, uint8_t bri, bool isRGBW)  {
-  if (!(apActive || interfacesInited) || !client[0] || !length) return 1;  // network not initialised or dummy/unset IP address  031522 ajn added check for ap
-
-  WiFiUDP ddpUdp;
-
-  switch (type) {
-    case 0: // DDP
-    {
-      // calculate the number of UDP packets we need to send
-      size_t channelCount = length * (isRGBW? 4:3); // 1 channel for every R,G,B value
-      size_t packetCount = ((channelCount-1) / DDP_CHANNELS_PER_PACKET) +1;
-
-      // there are 3 channels per RGB pixel
-      uint32_t channel = 0; // TODO: allow specifying the start channel
-      // the current position in the buffer
-      size_t bufferOffset = 0;
+// port   - destination port (DDP, E1.31 or Art-Net)
+// packet - complete packet including protocol header
+// len    - packet length in bytes
 
-      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
-        if (sequenceNumber > 15) sequenceNumber = 0;
+bool realtimeSendPacket(IPAddress client, uint16_t port, const uint8_t *packet, size_t len) {
+  if (!(apActive || interfacesInited) || !client[0]) return false;  // network not initialised or dummy/unset IP address  031522 ajn added check for ap
 
-        if (!ddpUdp.beginPacket(client, DDP_DEFAULT_PORT)) {  // port defined in ESPAsyncE131.h
-          //DEBUG_PRINTLN(F("WiFiUDP.beginPacket returned an error"));
-          return 1; // problem
-        }
-
-        // the amount of data is AFTER the header in the current packet
-        size_t packetSize = DDP_CHANNELS_PER_PACKET;
-
-        uint8_t flags = DDP_FLAGS1_VER1;
-        if (currentPacket == (packetCount - 1U)) {
-          // last packet, set the push flag
-          // TODO: determine if we want to send an empty push packet to each destination after sending the pixel data
-          flags = DDP_FLAGS1_VER1 | DDP_FLAGS1_PUSH;
-          if (channelCount % DDP_CHANNELS_PER_PACKET) {
-            packetSize = channelCount % DDP_CHANNELS_PER_PACKET;
-          }
-        }
-
-        // write the header
-        /*0*/ddpUdp.write(flags);
-        /*1*/ddpUdp.write(sequenceNumber++ & 0x0F); // sequence may be unnecessary unless we are sending twice (as requested in Sync settings)
-        /*2*/ddpUdp.write(isRGBW ?  DDP_TYPE_RGBW32 : DDP_TYPE_RGB24);
-        /*3*/ddpUdp.write(DDP_ID_DISPLAY);
-        // data offset in bytes, 32-bit number, MSB first
-        /*4*/ddpUdp.write(0xFF & (channel >> 24));
-        /*5*/ddpUdp.write(0xFF & (channel >> 16));
-        /*6*/ddpUdp.write(0xFF & (channel >>  8));
-        /*7*/ddpUdp.write(0xFF & (channel      ));
-        // data length in bytes, 16-bit number, MSB first
-        /*8*/ddpUdp.write(0xFF & (packetSize >> 8));
-        /*9*/ddpUdp.write(0xFF & (packetSize     ));
-
-        // write the colors, the write write(const uint8_t *buffer, size_t size)
-        // function is just a loop internally too
-        for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // R
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // G
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // B
-          if (isRGBW) ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // W
-        }
-
-        if (!ddpUdp.endPacket()) {
-          //DEBUG_PRINTLN(F("WiFiUDP.endPacket returned an error"));
-          return 1; // problem
-        }
-
-        channel += packetSize;
-      }
-    } break;
-
-    case 1: //E1.31
-    {
-    } break;
-
-    case 2: //ArtNet
-    {
-      // calculate the number of UDP packets we need to send
-      const size_t channelCount = length * (isRGBW?4:3); // 1 channel for every R,G,B,(W?) value
-      const size_t ARTNET_CHANNELS_PER_PACKET = isRGBW?512:510; // 512/4=128 RGBW LEDs, 510/3=170 RGB LEDs
-      const size_t packetCount = ((channelCount-1)/ARTNET_CHANNELS_PER_PACKET)+1;
-
-      uint32_t channel = 0; 
-      size_t bufferOffset = 0;
-
-      sequenceNumber++;
-
-      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
-
-        if (sequenceNumber > 255) sequenceNumber = 0;
-
-        if (!ddpUdp.beginPacket(client, ARTNET_DEFAULT_PORT)) {
-          DEBUG_PRINTLN(F("Art-Net WiFiUDP.beginPacket returned an error"));
-          return 1; // borked
-        }
-
-        size_t packetSize = ARTNET_CHANNELS_PER_PACKET;
-
-        if (currentPacket == (packetCount - 1U)) {
-          // last packet
-          if (channelCount % ARTNET_CHANNELS_PER_PACKET) {
-            packetSize = channelCount % ARTNET_CHANNELS_PER_PACKET;
-          }
-        }
-
-        byte header_buffer[ART_NET_HEADER_SIZE];
-        memcpy_P(header_buffer, ART_NET_HEADER, ART_NET_HEADER_SIZE);
-        ddpUdp.write(header_buffer, ART_NET_HEADER_SIZE); // This doesn't change. Hard coded ID, OpCode, and protocol version.
-        ddpUdp.write(sequenceNumber & 0xFF); // sequence number. 1..255
-        ddpUdp.write(0x00); // physical - more an FYI, not really used for anything. 0..3
-        ddpUdp.write((currentPacket) & 0xFF); // Universe LSB. 1 full packet == 1 full universe, so just use current packet number.
-        ddpUdp.write(0x00); // Universe MSB, unused.
-        ddpUdp.write(0xFF & (packetSize >> 8)); // 16-bit length of channel data, MSB
-        ddpUdp.write(0xFF & (packetSize     )); // 16-bit length of channel data, LSB
-
-        for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // R
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // G
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // B
-          if (isRGBW) ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // W
-        }
-
-        if (!ddpUdp.endPacket()) {
-          DEBUG_PRINTLN(F("Art-Net WiFiUDP.endPacket returned an error"));
-          return 1; // borked
-        }
-        channel += packetSize;
-      }
-    } break;
+  if (!netOutUdp.beginPacket(client, port)) {
+    //DEBUG_PRINTLN(F("WiFiUDP.beginPacket returned an error"));
+    return false; // problem
+  }
+  netOutUdp.write(packet, len);
+  if (!netOutUdp.endPacket()) {
+    //DEBUG_PRINTLN(F("WiFiUDP.endPacket returned an error"));
+    return false; // problem
   }
-  return 0;
+  return true;
 }
 
 #ifndef WLED_DISABLE_ESPNOW
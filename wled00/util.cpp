@@ -3,7 +3,7 @@
 #include "const.h"
 #ifdef ESP8266
 #include "user_interface.h" // for bootloop detection
-#else
+#elif !defined(WLED_HOST_BUILD)
 #include <Update.h>
 #if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(4, 4, 0)
   #include "esp32/rtc.h"    // for bootloop detection
@@ -180,7 +180,7 @@ bool requestJSONBufferLock(uint8_t moduleID)
     unsigned long now = millis();
     while (jsonBufferLock && (millis()-now < 250)) delay(1); // wait for fraction for buffer lock
   }
-#else
+#elif !defined(WLED_HOST_BUILD) // host-native benchmark build is single threaded
   #error Unsupported task framework - fix requestJSONBufferLock
 #endif  
   // If the lock is still held - by us, or by another task
@@ -810,6 +810,159 @@ void *allocate_buffer(size_t size, uint32_t type) {
   return buffer;
 }
 
+// buffer arena: blocks tile the whole arena, each starts with a header, free blocks have no owner
+struct ArenaBlock {
+  uint32_t size;  // including header
+  void   **owner; // nullptr if block is free
+};
+static constexpr size_t ARENA_ALIGN  = BufferArena::ALIGNMENT;
+static constexpr size_t ARENA_HEADER = BufferArena::HEADER_SIZE;
+static_assert(sizeof(ArenaBlock) <= ARENA_HEADER, "arena header does not fit");
+static inline size_t arenaBlockSize(size_t size) { return ARENA_HEADER + ((size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1)); }
+
+// arena may be in 32 bit accessible memory (BFRALLOC_NOBYTEACCESS): no memcpy()/memset(), lengths are multiples of ARENA_ALIGN
+static void arenaCopy(uint8_t *dst, const uint8_t *src, size_t len) {
+  uint32_t *d = reinterpret_cast<uint32_t*>(dst);
+  const uint32_t *s = reinterpret_cast<const uint32_t*>(src);
+  for (size_t i = 0; i < len / sizeof(uint32_t); i++) d[i] = s[i]; // forward copy, dst <= src when blocks overlap
+}
+
+static void arenaClear(uint8_t *dst, size_t len) {
+  uint32_t *d = reinterpret_cast<uint32_t*>(dst);
+  for (size_t i = 0; i < len / sizeof(uint32_t); i++) d[i] = 0;
+}
+
+bool BufferArena::resize(size_t size) {
+  size &= ~(ARENA_ALIGN - 1);
+  if (size && size < 2*ARENA_HEADER) size = 0;
+  if (size == _size) return true;
+  compact();
+  size_t used = 0;
+  for (size_t ofs = 0; ofs < _size; ofs += reinterpret_cast<ArenaBlock*>(_base + ofs)->size)
+    if (reinterpret_cast<ArenaBlock*>(_base + ofs)->owner) used += reinterpret_cast<ArenaBlock*>(_base + ofs)->size;
+  if (used > size) return false; // live buffers would not fit
+  if (used == 0) {
+    d_free(_base); // free old arena first to avoid having both allocated
+    _base = nullptr;
+    _size = 0;
+  }
+  uint8_t *base = size ? static_cast<uint8_t*>(allocate_buffer(size, _type)) : nullptr;
+  if (size && !base) return false;
+  if (used) {
+    arenaCopy(base, _base, used);
+    for (size_t ofs = 0; ofs < used; ofs += reinterpret_cast<ArenaBlock*>(base + ofs)->size)
+      *reinterpret_cast<ArenaBlock*>(base + ofs)->owner = base + ofs + ARENA_HEADER;
+    d_free(_base);
+  }
+  if (used < size) {
+    ArenaBlock *rest = reinterpret_cast<ArenaBlock*>(base + used);
+    rest->size  = size - used;
+    rest->owner = nullptr;
+  }
+  _base = base;
+  _size = size;
+  _fragmented = false;
+  return true;
+}
+
+void *BufferArena::allocate(size_t size, void **owner, bool clear) {
+  if (size == 0) return nullptr;
+  const size_t needed = arenaBlockSize(size);
+  size_t freeBytes = 0;
+  for (size_t ofs = 0; ofs < _size; ) {
+    ArenaBlock *blk = reinterpret_cast<ArenaBlock*>(_base + ofs);
+    if (!blk->owner) {
+      // merge with following free blocks
+      while (ofs + blk->size < _size && !reinterpret_cast<ArenaBlock*>(_base + ofs + blk->size)->owner)
+        blk->size += reinterpret_cast<ArenaBlock*>(_base + ofs + blk->size)->size;
+      if (blk->size >= needed) { // first fit
+        if (blk->size - needed >= arenaBlockSize(1)) {
+          ArenaBlock *rest = reinterpret_cast<ArenaBlock*>(_base + ofs + needed);
+          rest->size  = blk->size - needed;
+          rest->owner = nullptr;
+          blk->size   = needed;
+        }
+        blk->owner = owner;
+        uint8_t *buffer = _base + ofs + ARENA_HEADER;
+        if (clear) arenaClear(buffer, blk->size - ARENA_HEADER);
+        return buffer;
+      }
+      freeBytes += blk->size;
+    }
+    ofs += blk->size;
+  }
+  // arena is full or too fragmented: use heap
+  if (freeBytes >= needed) _fragmented = true; // compaction would have made room
+  void *buffer = allocate_buffer(size, _type | (clear ? BFRALLOC_CLEAR : 0));
+  if (buffer) _heapBuffers++;
+  return buffer;
+}
+
+void BufferArena::release(void *ptr) {
+  if (!ptr) return;
+  if (!owns(ptr)) {
+    d_free(ptr);
+    if (_heapBuffers) _heapBuffers--;
+    return;
+  }
+  ArenaBlock *blk = reinterpret_cast<ArenaBlock*>(static_cast<uint8_t*>(ptr) - ARENA_HEADER);
+  blk->owner = nullptr;
+  // a hole below live buffers can only be reused by smaller buffers until the arena is compacted
+  for (size_t ofs = static_cast<uint8_t*>(ptr) - _base - ARENA_HEADER + blk->size; ofs < _size; ofs += reinterpret_cast<ArenaBlock*>(_base + ofs)->size) {
+    if (reinterpret_cast<ArenaBlock*>(_base + ofs)->owner) {
+      _fragmented = true;
+      break;
+    }
+  }
+}
+
+void BufferArena::rebind(void *ptr, void **owner) {
+  if (ptr && owns(ptr)) reinterpret_cast<ArenaBlock*>(static_cast<uint8_t*>(ptr) - ARENA_HEADER)->owner = owner;
+}
+
+void BufferArena::compact() {
+  size_t dst = 0;
+  bool moved = false;
+  for (size_t ofs = 0; ofs < _size; ) {
+    const ArenaBlock *blk = reinterpret_cast<ArenaBlock*>(_base + ofs);
+    const size_t len = blk->size;
+    if (blk->owner) {
+      if (dst != ofs) {
+        arenaCopy(_base + dst, _base + ofs, len); // header is moved along with the buffer
+        *reinterpret_cast<ArenaBlock*>(_base + dst)->owner = _base + dst + ARENA_HEADER;
+        moved = true;
+      }
+      dst += len;
+    }
+    ofs += len;
+  }
+  if (dst < _size) {
+    ArenaBlock *rest = reinterpret_cast<ArenaBlock*>(_base + dst);
+    rest->size  = _size - dst;
+    rest->owner = nullptr;
+  }
+  if (moved) _compactions++;
+  _fragmented = false;
+}
+
+BufferArena::Stats BufferArena::getStats() const {
+  Stats stats = {uint32_t(_size), 0, 0, 0, _heapBuffers, _compactions};
+  size_t freeRun = 0; // adjacent free blocks are merged on next allocation
+  for (size_t ofs = 0; ofs < _size; ofs += reinterpret_cast<ArenaBlock*>(_base + ofs)->size) {
+    const ArenaBlock *blk = reinterpret_cast<ArenaBlock*>(_base + ofs);
+    if (blk->owner) {
+      stats.used += blk->size;
+      stats.buffers++;
+      freeRun = 0;
+    } else {
+      freeRun += blk->size;
+      if (freeRun - ARENA_HEADER > stats.largestFree) stats.largestFree = freeRun - ARENA_HEADER;
+    }
+  }
+  return stats;
+}
+
+#ifndef WLED_HOST_BUILD // no RTC memory or reset reason on host
 // bootloop detection and handling
 // checks if the ESP reboots multiple times due to a crash or watchdog timeout
 // if a bootloop is detected: restore settings from backup, then reset settings, then switch boot image (and repeat)
@@ -950,6 +1103,7 @@ void handleBootLoop() {
 
   ESP.restart(); // restart cleanly and don't wait for another crash
 }
+#endif // WLED_HOST_BUILD
 
 /*
  * Fixed point integer based Perlin noise functions by @dedehai
@@ -74,6 +74,10 @@
 #include <vector>
 
 // Library inclusions.
+#ifdef WLED_HOST_BUILD
+  // host-native benchmark build ([env:native]): Arduino, ESP-IDF and network libraries are replaced by shims
+  #include "wled_host.h" // tools/bench/host
+#else
 #include <Arduino.h>
 #ifdef ESP8266
   #include <ESP8266WiFi.h>
@@ -154,6 +158,7 @@
 #endif
 
 #include "src/dependencies/e131/ESPAsyncE131.h"
+#endif // WLED_HOST_BUILD
 #ifndef WLED_DISABLE_MQTT
 #include <AsyncMqttClient.h>
 #endif
@@ -499,6 +504,9 @@ WLED_GLOBAL uint16_t DMXSegmentSpacing _INIT(0);                  // Number of v
 WLED_GLOBAL byte e131LastSequenceNumber[E131_MAX_UNIVERSE_COUNT]; // to detect packet loss
 WLED_GLOBAL bool e131Multicast _INIT(false);                      // multicast or unicast
 WLED_GLOBAL bool e131SkipOutOfSequence _INIT(false);              // freeze instead of flickering
+WLED_GLOBAL bool e131FrameSync _INIT(true);                       // assemble multi-universe frames (honours E1.31 universe sync and ArtSync)
+WLED_GLOBAL byte e131JitterMs _INIT(5);                           // how long late universes of a frame are waited for once the next frame started
+WLED_GLOBAL volatile uint16_t e131SyncUniverse _INIT(0);          // E1.31 synchronization universe announced by the sender (multicast join is done in loop)
 WLED_GLOBAL uint16_t pollReplyCount _INIT(0);                     // count number of replies for ArtPoll node report
 
 // mqtt
@@ -915,6 +923,7 @@ WLED_GLOBAL AsyncWebHandler *editHandler _INIT(nullptr);
 // udp interface objects
 WLED_GLOBAL WiFiUDP notifierUdp, rgbUdp, notifier2Udp;
 WLED_GLOBAL WiFiUDP ntpUdp;
+WLED_GLOBAL WiFiUDP netOutUdp; // network output busses (DDP, E1.31, Art-Net)
 WLED_GLOBAL ESPAsyncE131 e131 _INIT_N(((handleE131Packet)));
 WLED_GLOBAL ESPAsyncE131 ddp  _INIT_N(((handleE131Packet)));
 WLED_GLOBAL bool e131NewData _INIT(false);
@@ -1,4 +1,5 @@
 #include "wled.h"
+#include <atomic>
 
 /*
  * WebSockets server for bidirectional communication
@@ -7,86 +8,509 @@
 
 uint16_t wsLiveClientId = 0;
 unsigned long wsLastLiveTime = 0;
-//uint8_t* wsFrameBuffer = nullptr;
+uint16_t wsPerfClientId = 0;     // client receiving frame profiler stream
+uint32_t wsPerfNextFrame = 0;    // first frame not yet sent to perf client
+unsigned long wsLastPerfTime = 0;
 
 #define WS_LIVE_INTERVAL 40
+#define WS_PERF_INTERVAL 1000
+
+#ifdef ESP8266
+#define WS_MAX_MESSAGE_SIZE 4096  // largest message reassembled from multiple packets
+#else
+#define WS_MAX_MESSAGE_SIZE 16384
+#endif
+#define WS_MAX_CLIENTS     8      // clients tracked to exclude binary subscribers from JSON broadcasts
+#define WS_BIN_MAX_CLIENTS 4      // binary state subscribers
+#define WS_STREAM_WINDOW   2      // frames a pixel streaming client may send ahead of frame acknowledgments
+
+/*
+ * Binary control protocol (binary WS messages, all values little endian)
+ * Request:  [seq u8] followed by one or more commands [cmd u8][args]:
+ *   'b' bri u8                               global brightness (0 = off)
+ *   'o' on u8                                0 = off, 1 = on, 2 = toggle
+ *   'v' preset u8                            apply preset
+ *   'c' seg u8, slot u8, r, g, b, w          segment color
+ *   'f' seg u8, fx u8                        segment effect
+ *   'p' seg u8, mask u8, value u8 per bit    segment params: sx, ix, pal, c1, c2, c3, opacity, on
+ *   'r' flags u8, start u16, count u16, data realtime pixels (flags bit 0: RGBW, otherwise RGB)
+ *   's' on u8                                subscribe to binary state pushes (JSON broadcasts stop for this client)
+ *   'd' seg u8, flags u8, frame u8, offset u16, count u16, data
+ *                                            stream pixels into segment footprint (row by row) starting at offset
+ *                                            (flags bit 0: RGBW, bit 1: last chunk of frame); one client at a time
+ *   seg 255 addresses all selected segments (except for 'd')
+ * Reply:    'A', seq u8, status u8 (ERR_NONE, ERR_JSON if malformed, ERR_NOT_IMPL if unknown command,
+ *           ERR_CONCURRENCY if the subscriber limit is reached or another client is streaming);
+ *           commands after a failing one are not applied; not sent for successful messages of 'd' commands only
+ * Frame acknowledgment (streaming client, once a frame has been shown):
+ *   'F', frame u8, dropped u8 (frames completed since the last acknowledgment but never shown), credits u8 (frames
+ *   the client may send ahead of acknowledgments, lowered while frames are dropped or the connection is congested)
+ * State push (subscribers, full state on subscribe, changed fields only afterwards):
+ *   'S', version u8, mask u8, on u8, bri u8, ps u8, mainseg u8 (fields present per mask bit 0-3)
+ *   then per changed segment: id u8, mask u16, fields per mask bit: on, opacity, fx, sx, ix, pal, c1, c2, c3 (u8),
+ *   col0, col1, col2 (r, g, b, w), bounds (start, stop, startY, stopY u16); mask bit 15 = segment removed
+ */
+#define WS_BIN_STATE_VERSION 1
+#define WS_BIN_SEG_COLOR     9   // first color bit in the segment mask
+#define WS_BIN_SEG_BOUNDS    12
+#define WS_BIN_SEG_REMOVED   15
+
+typedef struct WsBinSegment {
+  bool     active;
+  uint8_t  values[WS_BIN_SEG_COLOR]; // on, opacity, fx, sx, ix, pal, c1, c2, c3
+  uint32_t colors[NUM_COLORS];
+  uint16_t bounds[4];
+} ws_bin_segment_t;
+
+typedef struct WsBinState {
+  uint8_t          values[4];        // on, bri, ps, mainseg
+  ws_bin_segment_t seg[MAX_NUM_SEGMENTS];
+} ws_bin_state_t;
+
+static uint32_t        wsClients[WS_MAX_CLIENTS];        // connected client IDs (0 = free)
+static uint32_t        wsBinClients[WS_BIN_MAX_CLIENTS]; // binary state subscribers (0 = free)
+static ws_bin_state_t *wsBinState = nullptr;             // state last pushed to subscribers
+static uint8_t        *wsMessage = nullptr;              // message being reassembled from multiple packets
+static size_t          wsMessageSize = 0;                // allocated size (kept between messages of the streaming client)
+static uint32_t        wsMessageClient = 0;
+static bool            wsMessageBusy = false;            // wsMessage holds a partially received message
+static uint32_t        wsStreamClient = 0;               // client streaming pixels ('d')
+static unsigned long   wsStreamTime = 0;                 // last pixel data received from streaming client
+static std::atomic<uint16_t> wsStreamFrames{0};          // frames completed but not shown yet (high byte), last frame number (low byte)
+
+static void freeWsMessage() {
+  d_free(wsMessage);
+  wsMessage = nullptr;
+  wsMessageSize = 0;
+  wsMessageClient = 0;
+  wsMessageBusy = false;
+}
+
+static unsigned countBinaryWsClients() {
+  unsigned n = 0;
+  for (auto id : wsBinClients) if (id) n++;
+  return n;
+}
+
+static bool isBinaryWsClient(uint32_t id) {
+  for (auto c : wsBinClients) if (c == id) return true;
+  return false;
+}
+
+static void getBinaryState(ws_bin_state_t &state) {
+  state.values[0] = bri > 0;
+  state.values[1] = briLast;
+  state.values[2] = currentPreset;
+  state.values[3] = strip.getMainSegmentId();
+  for (unsigned i = 0; i < MAX_NUM_SEGMENTS; i++) {
+    ws_bin_segment_t &s = state.seg[i];
+    s.active = i < strip.getSegmentsNum() && strip.getSegment(i).isActive();
+    if (!s.active) continue;
+    const Segment &seg = strip.getSegment(i);
+    const uint8_t values[WS_BIN_SEG_COLOR] = {seg.on, seg.opacity, seg.mode, seg.speed, seg.intensity, seg.palette, seg.custom1, seg.custom2, seg.custom3};
+    memcpy(s.values, values, sizeof(values));
+    memcpy(s.colors, seg.colors, sizeof(s.colors));
+    s.bounds[0] = seg.start;
+    s.bounds[1] = seg.stop;
+    s.bounds[2] = seg.startY;
+    s.bounds[3] = seg.stopY;
+  }
+}
+
+// encodes fields of state that differ from base (all fields if full), returns message length (0 if nothing changed)
+// out == nullptr only measures, otherwise base is updated to state
+static size_t encodeBinaryState(uint8_t *out, const ws_bin_state_t &state, ws_bin_state_t &base, bool full) {
+  size_t pos = 3;
+  unsigned mask = 0;
+  for (unsigned i = 0; i < 4; i++) {
+    if (!full && state.values[i] == base.values[i]) continue;
+    mask |= 1 << i;
+    if (out) out[pos] = state.values[i];
+    pos++;
+  }
+  if (out) {
+    out[0] = 'S';
+    out[1] = WS_BIN_STATE_VERSION;
+    out[2] = mask;
+  }
+  bool changed = mask;
+
+  for (unsigned i = 0; i < MAX_NUM_SEGMENTS; i++) {
+    const ws_bin_segment_t &s = state.seg[i];
+    ws_bin_segment_t &b = base.seg[i];
+    if (!s.active) {
+      if (!full && b.active) { // removed since last push
+        if (out) {
+          out[pos] = i;
+          out[pos+1] = 0;
+          out[pos+2] = 1 << (WS_BIN_SEG_REMOVED - 8);
+        }
+        pos += 3;
+        changed = true;
+      }
+      continue;
+    }
+    const size_t start = pos;
+    unsigned segMask = 0;
+    pos += 3;
+    for (unsigned v = 0; v < WS_BIN_SEG_COLOR; v++) {
+      if (!full && b.active && s.values[v] == b.values[v]) continue;
+      segMask |= 1 << v;
+      if (out) out[pos] = s.values[v];
+      pos++;
+    }
+    for (unsigned c = 0; c < NUM_COLORS; c++) {
+      if (!full && b.active && s.colors[c] == b.colors[c]) continue;
+      segMask |= 1 << (WS_BIN_SEG_COLOR + c);
+      if (out) {
+        out[pos]   = R(s.colors[c]);
+        out[pos+1] = G(s.colors[c]);
+        out[pos+2] = B(s.colors[c]);
+        out[pos+3] = W(s.colors[c]);
+      }
+      pos += 4;
+    }
+    if (full || !b.active || memcmp(s.bounds, b.bounds, sizeof(s.bounds))) {
+      segMask |= 1 << WS_BIN_SEG_BOUNDS;
+      if (out) for (unsigned k = 0; k < 4; k++) {
+        out[pos+2*k]   = s.bounds[k] & 0xFF;
+        out[pos+2*k+1] = s.bounds[k] >> 8;
+      }
+      pos += 8;
+    }
+    if (!segMask) {
+      pos = start;
+      continue;
+    }
+    if (out) {
+      out[start]   = i;
+      out[start+1] = segMask & 0xFF;
+      out[start+2] = segMask >> 8;
+    }
+    changed = true;
+  }
+  if (out) base = state;
+  return changed ? pos : 0;
+}
+
+// sends full state to a new subscriber (client) or changes since the last push to all subscribers (nullptr)
+static void sendBinaryStateWs(AsyncWebSocketClient * client) {
+  if (!wsBinState) return;
+  ws_bin_state_t *state = static_cast<ws_bin_state_t*>(d_malloc(sizeof(ws_bin_state_t)));
+  if (!state) return;
+  getBinaryState(*state);
+  ws_bin_state_t &base = client ? *state : *wsBinState; // a new subscriber gets everything, others what changed since last push
+  const size_t len = encodeBinaryState(nullptr, *state, base, client);
+  uint8_t *msg = len ? static_cast<uint8_t*>(d_malloc(len)) : nullptr;
+  if (msg) {
+    encodeBinaryState(msg, *state, base, client);
+    for (auto id : wsBinClients) {
+      AsyncWebSocketClient * wsc = client ? client : (id ? ws.client(id) : nullptr);
+      if (wsc) {
+        AsyncWebSocketBuffer buffer(len);
+        if (buffer) {
+          memcpy(buffer.data(), msg, len);
+          wsc->binary(std::move(buffer));
+        }
+      }
+      if (client) break;
+    }
+    d_free(msg);
+  }
+  d_free(state);
+}
+
+static bool subscribeBinaryWs(AsyncWebSocketClient * client, bool subscribe) {
+  const uint32_t id = client->id();
+  for (auto &c : wsBinClients) if (c == id) c = 0;
+  if (subscribe) {
+    uint32_t *slot = nullptr;
+    for (auto &c : wsBinClients) if (!c) { slot = &c; break; }
+    if (!slot) return false;
+    if (!wsBinState) {
+      wsBinState = static_cast<ws_bin_state_t*>(d_malloc(sizeof(ws_bin_state_t)));
+      if (!wsBinState) return false;
+      getBinaryState(*wsBinState);
+    }
+    *slot = id;
+    sendBinaryStateWs(client);
+  } else if (!countBinaryWsClients()) {
+    d_free(wsBinState);
+    wsBinState = nullptr;
+  }
+  return true;
+}
+
+// applies fn to segment id (255: all selected segments)
+template<typename F> static void forEachWsSegment(uint8_t id, F fn) {
+  for (unsigned s = 0; s < strip.getSegmentsNum(); s++) {
+    Segment &seg = strip.getSegment(s);
+    if (!seg.isActive() || (id == 255 ? !seg.isSelected() : s != id)) continue;
+    fn(seg);
+  }
+}
+
+static void handleWsBinary(AsyncWebSocketClient * client, const uint8_t *data, size_t len) {
+  if (!len) return;
+  const uint8_t seq = data[0];
+  uint8_t status = ERR_NONE;
+  bool suspended = false;
+  bool changed = false;
+  bool acknowledge = false; // pixel streams are acknowledged per frame by handleWsStream()
+  size_t pos = 1;
+
+  auto suspend = [&suspended]() {
+    if (suspended) return;
+    // we may be called during strip.service() so we must not modify segments while effects are executing
+    strip.suspend();
+    strip.waitForIt();
+    suspended = true;
+  };
+
+  while (pos < len && status == ERR_NONE) {
+    const uint8_t cmd = data[pos++];
+    const uint8_t *arg = data + pos;
+    const size_t avail = len - pos;
+    if (cmd != 'd') acknowledge = true;
+    switch (cmd) {
+      case 'b':
+        if (avail < 1) { status = ERR_JSON; break; }
+        if (arg[0]) {
+          if (bri != arg[0]) changed = true;
+          bri = arg[0];
+        } else if (bri) {
+          toggleOnOff();
+          changed = true;
+        }
+        pos += 1;
+        break;
+      case 'o':
+        if (avail < 1) { status = ERR_JSON; break; }
+        if (arg[0] > 1 || !arg[0] != !bri) {
+          toggleOnOff();
+          changed = true;
+        }
+        pos += 1;
+        break;
+      case 'v':
+        if (avail < 1) { status = ERR_JSON; break; }
+        if (arg[0] > 0 && arg[0] < 251) {
+          presetCycCurr = arg[0];
+          applyPreset(arg[0], CALL_MODE_WS_SEND);
+        }
+        pos += 1;
+        break;
+      case 'c':
+        if (avail < 6) { status = ERR_JSON; break; }
+        if (arg[1] < NUM_COLORS) {
+          suspend();
+          const uint32_t c = RGBW32(arg[2], arg[3], arg[4], arg[5]);
+          forEachWsSegment(arg[0], [&](Segment &seg) {
+            if (seg.colors[arg[1]] != c) { seg.setColor(arg[1], c); changed = true; } // use transition
+          });
+        }
+        pos += 6;
+        break;
+      case 'f':
+        if (avail < 2) { status = ERR_JSON; break; }
+        if (arg[1] < strip.getModeCount()) {
+          suspend();
+          forEachWsSegment(arg[0], [&](Segment &seg) {
+            if (seg.mode == arg[1]) return;
+            if (currentPlaylist >= 0) unloadPlaylist();
+            seg.setMode(arg[1]); // use transition
+            changed = true;
+          });
+        }
+        pos += 2;
+        break;
+      case 'p': {
+        if (avail < 2) { status = ERR_JSON; break; }
+        const uint8_t mask = arg[1];
+        const size_t n = 2 + __builtin_popcount(mask);
+        if (avail < n) { status = ERR_JSON; break; }
+        suspend();
+        forEachWsSegment(arg[0], [&](Segment &seg) {
+          const uint8_t *v = arg + 2;
+          if (mask & 0x01) { changed |= seg.speed != *v; seg.speed = *v++; }
+          if (mask & 0x02) { changed |= seg.intensity != *v; seg.intensity = *v++; }
+          if (mask & 0x04) { if (*v < getPaletteCount() && *v != seg.palette && (seg.getLightCapabilities() & 1)) { seg.setPalette(*v); changed = true; } v++; }
+          if (mask & 0x08) { changed |= seg.custom1 != *v; seg.custom1 = *v++; }
+          if (mask & 0x10) { changed |= seg.custom2 != *v; seg.custom2 = *v++; }
+          if (mask & 0x20) { const uint8_t c3 = std::min(*v++, (uint8_t)31); changed |= seg.custom3 != c3; seg.custom3 = c3; }
+          if (mask & 0x40) { if (*v && *v != seg.opacity) { seg.setOpacity(*v); changed = true; } v++; } // use transition
+          if (mask & 0x80) { if (bool(*v) != seg.on) { seg.setOption(SEG_OPTION_ON, *v); changed = true; } v++; } // use transition
+        });
+        pos += n;
+        break;
+      }
+      case 'r': {
+        if (avail < 5) { status = ERR_JSON; break; }
+        const bool white = arg[0] & 0x01;
+        const unsigned stride = white ? 4 : 3;
+        const unsigned start = arg[1] | (arg[2] << 8);
+        const size_t count = arg[3] | (arg[4] << 8);
+        if (avail < 5 + count * stride) { status = ERR_JSON; break; }
+        realtimeLock(realtimeTimeoutMs, REALTIME_MODE_GENERIC);
+        if (!realtimeOverride) {
+          setRealtimePixels(start, arg + 5, count, stride, white);
+          e131NewData = true; // shown by handleNotifications()
+        }
+        pos += 5 + count * stride;
+        break;
+      }
+      case 'd': {
+        if (avail < 7) { status = ERR_JSON; break; }
+        const bool white = arg[1] & 0x01;
+        const unsigned stride = white ? 4 : 3;
+        const unsigned offset = arg[3] | (arg[4] << 8);
+        const size_t count = arg[5] | (arg[6] << 8);
+        if (avail < 7 + count * stride || arg[0] >= strip.getSegmentsNum()) { status = ERR_JSON; break; }
+        if (wsStreamClient != client->id()) {
+          // another client may take over once the current one stopped streaming
+          if (wsStreamClient && ws.client(wsStreamClient) && millis() - wsStreamTime < realtimeTimeoutMs) { status = ERR_CONCURRENCY; break; }
+          wsStreamClient = client->id();
+          wsStreamFrames = 0;
+        }
+        wsStreamTime = millis();
+        realtimeLock(realtimeTimeoutMs, REALTIME_MODE_WS);
+        realtimeIP = client->remoteIP();
+        if (!realtimeOverride) strip.ingestSegmentPixels(strip.getSegment(arg[0]), offset, arg + 7, count, stride, white);
+        if (arg[1] & 0x02) {
+          // frame complete, shown by handleWsStream() (only the latest if several complete before the next loop)
+          uint16_t frames = wsStreamFrames.load();
+          while (!wsStreamFrames.compare_exchange_weak(frames, uint16_t((std::min(frames >> 8, 254) + 1) << 8 | arg[2])));
+        }
+        pos += 7 + count * stride;
+        break;
+      }
+      case 's':
+        if (avail < 1) { status = ERR_JSON; break; }
+        if (!subscribeBinaryWs(client, arg[0])) status = ERR_CONCURRENCY;
+        pos += 1;
+        break;
+      default:
+        status = ERR_NOT_IMPL;
+        break;
+    }
+  }
+  if (suspended) strip.resume();
+  if (changed) stateUpdated(CALL_MODE_WS_SEND);
+  if (!acknowledge && status == ERR_NONE) return;
+
+  const char ack[3] = {'A', char(seq), char(status)};
+  client->binary(ack, sizeof(ack));
+}
+
+static void handleWsText(AsyncWebSocketClient * client, uint8_t *data, size_t len) {
+  if (len > 0 && len < 10 && data[0] == 'p') {
+    // application layer ping/pong heartbeat.
+    // client-side socket layer ping packets are unanswered (investigate)
+    client->text(F("pong"));
+    return;
+  }
+
+  bool verboseResponse = false;
+  if (!requestJSONBufferLock(11)) {
+    client->text(F("{\"error\":3}")); // ERR_NOBUF
+    return;
+  }
+
+  DeserializationError error = deserializeJson(*pDoc, data, len);
+  JsonObject root = pDoc->as<JsonObject>();
+  if (error || root.isNull()) {
+    releaseJSONBufferLock();
+    return;
+  }
+  if (root["v"] && root.size() == 1) {
+    //if the received value is just "{"v":true}", send only to this client
+    verboseResponse = true;
+  } else if (root.containsKey("lv")) {
+    wsLiveClientId = root["lv"] ? client->id() : 0;
+  } else if (root.containsKey(F("perf"))) {
+    wsPerfClientId  = root[F("perf")] ? client->id() : 0; // stream frame profiler data (starting with history)
+    wsPerfNextFrame = 0;
+  } else {
+    verboseResponse = deserializeState(root);
+  }
+  releaseJSONBufferLock();
+
+  if (!interfaceUpdateCallMode) { // individual client response only needed if no WS broadcast soon
+    if (verboseResponse) {
+      #ifndef WLED_DISABLE_MQTT
+      // publish state to MQTT as requested in wled#4643 even if only WS response selected
+      publishMqtt();
+      #endif
+      sendDataWs(client);
+    } else {
+      // we have to send something back otherwise WS connection closes
+      client->text(F("{\"success\":true}"));
+    }
+    // force broadcast in 500ms after updating client
+    //lastInterfaceUpdate = millis() - (INTERFACE_UPDATE_COOLDOWN -500); // ESP8266 does not like this
+  }
+}
 
 void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventType type, void * arg, uint8_t *data, size_t len)
 {
   if(type == WS_EVT_CONNECT){
     //client connected
     DEBUG_PRINTLN(F("WS client connected."));
+    for (auto &id : wsClients) if (!id) { id = client->id(); break; }
     sendDataWs(client);
   } else if(type == WS_EVT_DISCONNECT){
     //client disconnected
     if (client->id() == wsLiveClientId) wsLiveClientId = 0;
+    if (client->id() == wsPerfClientId) wsPerfClientId = 0;
+    for (auto &id : wsClients) if (id == client->id()) id = 0;
+    if (client->id() == wsStreamClient) wsStreamClient = 0;
+    if (isBinaryWsClient(client->id())) subscribeBinaryWs(client, false);
+    if (client->id() == wsMessageClient) freeWsMessage();
     DEBUG_PRINTLN(F("WS client disconnected."));
   } else if(type == WS_EVT_DATA){
     // data packet
     AwsFrameInfo * info = (AwsFrameInfo*)arg;
     if(info->final && info->index == 0 && info->len == len){
       // the whole message is in a single frame and we got all of its data (max. 1450 bytes)
-      if(info->opcode == WS_TEXT)
-      {
-        if (len > 0 && len < 10 && data[0] == 'p') {
-          // application layer ping/pong heartbeat.
-          // client-side socket layer ping packets are unanswered (investigate)
-          client->text(F("pong"));
-          return;
+      if      (info->opcode == WS_TEXT)   handleWsText(client, data, len);
+      else if (info->opcode == WS_BINARY) handleWsBinary(client, data, len);
+    } else if (info->final && info->num == 0) {
+      //the frame is split into multiple packets: reassemble
+      if (info->index == 0) {
+        // buffer kept for the streaming client between its messages is released if idle and not fitting
+        if (wsMessage && !wsMessageBusy && (wsMessageClient != client->id() || wsMessageSize < info->len)) freeWsMessage();
+        if (!wsMessage && info->len <= WS_MAX_MESSAGE_SIZE) {
+          wsMessage = static_cast<uint8_t*>(d_malloc(info->len));
+          wsMessageSize = wsMessage ? info->len : 0;
+          wsMessageClient = wsMessage ? client->id() : 0;
         }
-
-        bool verboseResponse = false;
-        if (!requestJSONBufferLock(11)) {
-          client->text(F("{\"error\":3}")); // ERR_NOBUF
-          return;
+        if (wsMessageClient == client->id()) wsMessageBusy = true;
+        else if (info->message_opcode == WS_BINARY && len) {
+          const char ack[3] = {'A', char(data[0]), ERR_NORAM}; // too large or another message is being reassembled
+          client->binary(ack, sizeof(ack));
         }
-
-        DeserializationError error = deserializeJson(*pDoc, data, len);
-        JsonObject root = pDoc->as<JsonObject>();
-        if (error || root.isNull()) {
-          releaseJSONBufferLock();
-          return;
+      }
+      const bool assembling = wsMessage && wsMessageClient == client->id() && info->index + len <= info->len && info->len <= wsMessageSize;
+      if (assembling) memcpy(wsMessage + info->index, data, len);
+      if((info->index + len) == info->len){
+        if (assembling) {
+          if (info->message_opcode == WS_TEXT) handleWsText(client, wsMessage, info->len);
+          else                                 handleWsBinary(client, wsMessage, info->len);
+        } else if (info->message_opcode == WS_TEXT) {
+          client->text(F("{\"error\":9}")); // ERR_JSON too large or another message is being reassembled
         }
-        if (root["v"] && root.size() == 1) {
-          //if the received value is just "{"v":true}", send only to this client
-          verboseResponse = true;
-        } else if (root.containsKey("lv")) {
-          wsLiveClientId = root["lv"] ? client->id() : 0;
-        } else {
-          verboseResponse = deserializeState(root);
-        }
-        releaseJSONBufferLock();
-
-        if (!interfaceUpdateCallMode) { // individual client response only needed if no WS broadcast soon
-          if (verboseResponse) {
-            #ifndef WLED_DISABLE_MQTT
-            // publish state to MQTT as requested in wled#4643 even if only WS response selected
-            publishMqtt();
-            #endif
-            sendDataWs(client);
-          } else {
-            // we have to send something back otherwise WS connection closes
-            client->text(F("{\"success\":true}"));
-          }
-          // force broadcast in 500ms after updating client
-          //lastInterfaceUpdate = millis() - (INTERFACE_UPDATE_COOLDOWN -500); // ESP8266 does not like this
+        if (wsMessageClient == client->id()) {
+          wsMessageBusy = false;
+          if (client->id() != wsStreamClient) freeWsMessage(); // avoid reallocating for every streamed frame
         }
       }
+      DEBUG_PRINTLN(F("WS multipart message."));
     } else {
-      //message is comprised of multiple frames or the frame is split into multiple packets
-      //if(info->index == 0){
-        //if (!wsFrameBuffer && len < 4096) wsFrameBuffer = new uint8_t[4096];
-      //}
-
-      //if (wsFrameBuffer && len < 4096 && info->index + info->)
-      //{
-
-      //}
-
+      //message is comprised of multiple frames
       if((info->index + len) == info->len){
         if(info->final){
           if(info->message_opcode == WS_TEXT) {
-            client->text(F("{\"error\":9}")); // ERR_JSON we do not handle split packets right now
+            client->text(F("{\"error\":9}")); // ERR_JSON we do not handle fragmented messages
           }
         }
       }
@@ -109,6 +533,16 @@ void sendDataWs(AsyncWebSocketClient * client)
 {
   if (!ws.count()) return;
 
+  // binary subscribers get changed fields only and no JSON broadcasts (unless there are untracked clients)
+  unsigned binaryClients = client ? 0 : countBinaryWsClients();
+  if (binaryClients) {
+    sendBinaryStateWs(nullptr);
+    if (binaryClients >= ws.count()) return;
+    unsigned tracked = 0;
+    for (auto id : wsClients) if (id) tracked++;
+    if (tracked < ws.count()) binaryClients = 0;
+  }
+
   if (!requestJSONBufferLock(12)) {
     const char* error = PSTR("{\"error\":3}");
     if (client) {
@@ -156,6 +590,12 @@ void sendDataWs(AsyncWebSocketClient * client)
   if (client) {
     DEBUG_PRINTLN(F("to a single client."));
     client->text(std::move(buffer));
+  } else if (binaryClients) {
+    DEBUG_PRINTLN(F("to JSON clients."));
+    for (auto id : wsClients) {
+      AsyncWebSocketClient * wsc = id && !isBinaryWsClient(id) ? ws.client(id) : nullptr;
+      if (wsc) wsc->text((const char *)buffer.data(), len);
+    }
   } else {
     DEBUG_PRINTLN(F("to multiple clients."));
     ws.textAll(std::move(buffer));
@@ -223,8 +663,51 @@ bool sendLiveLedsWs(uint32_t wsClient)
   return true;
 }
 
+// sends frames profiled since last call, see serializePerf()
+bool sendPerfWs(uint32_t wsClient)
+{
+  AsyncWebSocketClient * wsc = ws.client(wsClient);
+  if (!wsc || wsc->queueLength() > 0) return false; //only send if queue free
+
+  if (!requestJSONBufferLock(23)) return false;
+  JsonObject perf = pDoc->createNestedObject(F("perf"));
+  uint32_t nextFrame = serializePerf(perf, wsPerfNextFrame);
+
+  size_t len = measureJson(*pDoc);
+  AsyncWebSocketBuffer buffer(len);
+  if (!buffer) {
+    releaseJSONBufferLock();
+    return false; //out of memory
+  }
+  serializeJson(*pDoc, (char *)buffer.data(), len);
+  releaseJSONBufferLock();
+
+  wsc->text(std::move(buffer));
+  wsPerfNextFrame = nextFrame;
+  return true;
+}
+
+// shows the latest frame completed by the streaming client and acknowledges it: 'F', frame, dropped, credits
+static void handleWsStream()
+{
+  const uint16_t frames = wsStreamFrames.exchange(0);
+  if (!frames) return;
+  const bool live = realtimeMode == REALTIME_MODE_WS && !realtimeOverride;
+  if (live) {
+    if (useMainSegmentOnly) strip.trigger();
+    else                    strip.show();
+  }
+  AsyncWebSocketClient * wsc = ws.client(wsStreamClient);
+  if (!wsc) return;
+  const unsigned dropped = (frames >> 8) - live;
+  const unsigned credits = dropped || wsc->queueLength() > 0 ? 1 : WS_STREAM_WINDOW; // slow down if frames are not shown or acks queue up
+  const char ack[4] = {'F', char(frames & 0xFF), char(dropped), char(credits)};
+  wsc->binary(ack, sizeof(ack));
+}
+
 void handleWs()
 {
+  handleWsStream();
   if (millis() - wsLastLiveTime > WS_LIVE_INTERVAL)
   {
     #ifdef ESP8266
@@ -237,6 +720,12 @@ void handleWs()
     wsLastLiveTime = millis();
     if (!success) wsLastLiveTime -= 20; //try again in 20ms if failed due to non-empty WS queue
   }
+  if (wsPerfClientId && millis() - wsLastPerfTime > WS_PERF_INTERVAL)
+  {
+    bool success = sendPerfWs(wsPerfClientId);
+    wsLastPerfTime = millis();
+    if (!success) wsLastPerfTime -= WS_PERF_INTERVAL - 100; //try again in 100ms if WS queue or JSON buffer was busy
+  }
 }
 
 #else